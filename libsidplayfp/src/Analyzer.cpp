@@ -0,0 +1,312 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "Analyzer.h"
+
+#include "sidplayfp/SidTune.h"
+#include "sidplayfp/SidTuneInfo.h"
+
+#include "sidmemory.h"
+
+#include <vector>
+
+namespace libsidplayfp
+{
+
+const char ERR_NA[] = "NA";
+
+/// Maximum number of SIDs
+const unsigned int MAX_SIDS = 3;
+
+/// Seconds of matching SID writes that make an audio loop candidate
+const unsigned int WINDOW_SECONDS = 2;
+
+/// Seconds an audio loop must be verified for
+const unsigned int CONFIRM_SECONDS = 30;
+
+const uint_least64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+const uint_least64_t FNV_PRIME = 0x100000001b3ULL;
+
+inline void hashByte(uint_least64_t &hash, uint8_t data)
+{
+    hash = (hash ^ data) * FNV_PRIME;
+}
+
+Analyzer::Analyzer() :
+    m_builder("RegisterSID"),
+    m_playCall("Analyzer play call", *this, &Analyzer::sample),
+    m_tuneInfo(nullptr),
+    m_startTime(0),
+    m_silenceSeconds(0),
+    m_done(false),
+    m_result(LoopDetector::NONE),
+    m_loopStart(0.),
+    m_loopLength(0.),
+    m_confidence(0.),
+    m_errorString(ERR_NA)
+{
+    m_builder.create(MAX_SIDS);
+    config(m_player.config());
+}
+
+bool Analyzer::config(const SidConfig &cfg)
+{
+    SidConfig newCfg(cfg);
+    newCfg.sidEmulation = &m_builder;
+
+    if (!m_player.config(newCfg))
+    {
+        m_errorString = m_player.error();
+        return false;
+    }
+
+    return true;
+}
+
+uint_least64_t Analyzer::stateHash()
+{
+    c64 &machine = m_player.machine();
+    sidmemory &mem = machine.getMemInterface();
+
+    uint_least64_t hash = FNV_OFFSET;
+
+    const uint_least64_t regs = machine.getCpuRegisters();
+    for (int i = 0; i < 64; i += 8)
+    {
+        hashByte(hash, static_cast<uint8_t>(regs >> i));
+    }
+
+    // Zero page, except the jiffy clock which never repeats
+    for (uint_least16_t addr = 0x02; addr < 0x100; addr++)
+    {
+        if (addr < 0xa0 || addr > 0xa2)
+            hashByte(hash, mem.readMemByte(addr));
+    }
+
+    // Used part of the stack
+    const unsigned int sp = static_cast<uint8_t>(regs >> 32);
+    for (uint_least16_t addr = 0x0100 + sp + 1; addr < 0x200; addr++)
+    {
+        hashByte(hash, mem.readMemByte(addr));
+    }
+
+    // Tune code and data
+    const uint_least32_t start = m_tuneInfo->loadAddr();
+    uint_least32_t end = start + m_tuneInfo->c64dataLen();
+    if (end > 0x10000)
+        end = 0x10000;
+    for (uint_least32_t addr = start; addr < end; addr++)
+    {
+        hashByte(hash, mem.readMemByte(addr));
+    }
+
+    // Writable SID registers
+    for (unsigned int i = 0; ; i++)
+    {
+        const RegisterSid *s = static_cast<const RegisterSid*>(m_player.getSid(i));
+        if (s == nullptr)
+            break;
+
+        const uint8_t *sidRegs = s->registers();
+        for (unsigned int r = 0; r < 0x19; r++)
+        {
+            hashByte(hash, sidRegs[r]);
+        }
+    }
+
+    return hash;
+}
+
+void Analyzer::fullState(std::vector<uint8_t> &state)
+{
+    c64 &machine = m_player.machine();
+    sidmemory &mem = machine.getMemInterface();
+
+    state.clear();
+
+    const uint_least64_t regs = machine.getCpuRegisters();
+    for (int i = 0; i < 64; i += 8)
+    {
+        state.push_back(static_cast<uint8_t>(regs >> i));
+    }
+
+    // The whole RAM, except the jiffy clock which never repeats
+    for (uint_least32_t addr = 0x0000; addr < 0x10000; addr++)
+    {
+        if (addr < 0xa0 || addr > 0xa2)
+            state.push_back(mem.readMemByte(addr));
+    }
+
+    // Timer latches and control registers
+    for (uint_least8_t r = 0; r < 0x10; r++)
+    {
+        state.push_back(machine.getCia1Register(r));
+        state.push_back(machine.getCia2Register(r));
+    }
+
+    for (unsigned int i = 0; ; i++)
+    {
+        const RegisterSid *s = static_cast<const RegisterSid*>(m_player.getSid(i));
+        if (s == nullptr)
+            break;
+
+        const uint8_t *sidRegs = s->registers();
+        state.insert(state.end(), sidRegs, sidRegs + 0x19);
+    }
+}
+
+void Analyzer::sample()
+{
+    if (m_done)
+        return;
+
+    c64 &machine = m_player.machine();
+    const double cpuFreq = m_player.cpuFreq();
+
+    if (!m_detector)
+    {
+        // Estimate the number of samples per second
+        unsigned int period = machine.getCyclesPerFrame();
+        if (m_tuneInfo->songSpeed() == SidTuneInfo::SPEED_CIA_1A)
+        {
+            const uint_least16_t timer = machine.getCia1TimerA();
+            if (timer != 0)
+                period = timer + 1u;
+        }
+        const unsigned int rate = static_cast<unsigned int>(cpuFreq / period + 0.5);
+
+        m_detector.reset(new LoopDetector(WINDOW_SECONDS * rate, CONFIRM_SECONDS * rate, m_silenceSeconds * rate));
+    }
+
+    m_frameTimes.push_back(machine.getEventScheduler()->getTime(EVENT_CLOCK_PHI1) - m_startTime);
+    const unsigned int frame = m_frameTimes.size() - 2;
+
+    uint_least64_t writes = FNV_OFFSET;
+    bool silent = true;
+    for (unsigned int i = 0; ; i++)
+    {
+        RegisterSid *s = static_cast<RegisterSid*>(m_player.getSid(i));
+        if (s == nullptr)
+            break;
+
+        silent = silent && s->isSilent();
+        writes = (writes ^ s->takeWrites()) * FNV_PRIME;
+    }
+
+    if (m_detector->frame(stateHash(), writes, silent))
+    {
+        m_done = true;
+        return;
+    }
+
+    // A hash match alone could be a collision, compare the
+    // full state of the candidate with the one a loop later
+    if (m_detector->candidate())
+    {
+        if (frame == m_detector->candidateFrame())
+        {
+            fullState(m_candidateState);
+        }
+        else if (frame == m_detector->candidateFrame() + m_detector->candidateLength())
+        {
+            std::vector<uint8_t> state;
+            fullState(state);
+            m_done = m_detector->confirm(state == m_candidateState);
+        }
+    }
+}
+
+bool Analyzer::analyze(SidTune *tune, unsigned int maxSeconds, unsigned int silenceSeconds)
+{
+    m_result = LoopDetector::NONE;
+    m_loopStart = 0.;
+    m_loopLength = 0.;
+    m_confidence = 0.;
+
+    if (!m_player.load(tune))
+    {
+        m_errorString = m_player.error();
+        return false;
+    }
+
+    c64 &machine = m_player.machine();
+    m_tuneInfo = tune->getInfo();
+
+    const double cpuFreq = m_player.cpuFreq();
+    const unsigned int frameCycles = machine.getCyclesPerFrame();
+    const bool cia = m_tuneInfo->songSpeed() == SidTuneInfo::SPEED_CIA_1A;
+
+    m_detector.reset();
+    m_silenceSeconds = silenceSeconds;
+    m_done = false;
+    m_startTime = machine.getEventScheduler()->getTime(EVENT_CLOCK_PHI1);
+
+    // Start time of each frame
+    m_frameTimes.clear();
+    m_frameTimes.push_back(0);
+
+    // Sample on each call of the play routine so speed changes
+    // and multispeed tunes line up, tunes which install their
+    // own interrupt handler are sampled at a fixed rate instead
+    const uint_least16_t playAddr = m_tuneInfo->playAddr();
+    const bool followPlay = playAddr != 0;
+    if (followPlay)
+        machine.setCpuWatch(&m_playCall, playAddr);
+
+    const event_clock_t limit = static_cast<event_clock_t>(maxSeconds * cpuFreq);
+    event_clock_t time = 0;
+
+    while (!m_done && time < limit)
+    {
+        unsigned int period = frameCycles;
+        if (cia && !followPlay)
+        {
+            const uint_least16_t timer = machine.getCia1TimerA();
+            if (timer != 0)
+                period = timer + 1u;
+        }
+
+        m_player.renderCycles(nullptr, 0, period);
+        time += period;
+
+        if (!followPlay)
+            sample();
+    }
+
+    machine.setCpuWatch(nullptr, 0);
+
+    if (!m_detector)
+        return true;
+
+    m_result = m_detector->result();
+    m_confidence = m_detector->confidence();
+
+    if (m_result != LoopDetector::NONE)
+    {
+        const unsigned int start = m_detector->loopStart();
+        m_loopStart = m_frameTimes[start] / cpuFreq;
+        m_loopLength = (m_frameTimes[start + m_detector->loopLength()] - m_frameTimes[start]) / cpuFreq;
+    }
+
+    return true;
+}
+
+}
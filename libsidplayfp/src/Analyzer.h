@@ -0,0 +1,127 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef ANALYZER_H
+#define ANALYZER_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "sidplayfp/SidConfig.h"
+
+#include "player.h"
+#include "RegisterSid.h"
+#include "LoopDetector.h"
+#include "EventCallback.h"
+
+#include "sidcxx11.h"
+
+class SidTune;
+
+namespace libsidplayfp
+{
+
+/**
+ * Run a tune without sound emulation to find its loop or its end.
+ */
+class Analyzer
+{
+private:
+    /// Register file SIDs, must outlive the player
+    RegisterSidBuilder m_builder;
+
+    Player m_player;
+
+    /// Samples the machine on each call of the play routine
+    EventCallback<Analyzer> m_playCall;
+
+    /// Set up on the first sample, when the tune speed is known
+    std::unique_ptr<LoopDetector> m_detector;
+
+    const SidTuneInfo *m_tuneInfo;
+
+    /// Time of each sample from the start of the analysis
+    std::vector<event_clock_t> m_frameTimes;
+
+    event_clock_t m_startTime;
+
+    /// Full machine state at the exact loop candidate
+    std::vector<uint8_t> m_candidateState;
+
+    unsigned int m_silenceSeconds;
+
+    bool m_done;
+
+    LoopDetector::result_t m_result;
+
+    double m_loopStart;
+    double m_loopLength;
+    double m_confidence;
+
+    const char *m_errorString;
+
+private:
+    /**
+     * Hash the CPU registers, the relevant RAM and the SID registers.
+     */
+    uint_least64_t stateHash();
+
+    /**
+     * Copy the CPU registers, the whole RAM, the CIA
+     * and the SID registers to confirm a repeated state.
+     */
+    void fullState(std::vector<uint8_t> &state);
+
+    /**
+     * Feed the state of the machine to the detector.
+     */
+    void sample();
+
+public:
+    Analyzer();
+
+    const SidConfig &config() const { return m_player.config(); }
+
+    bool config(const SidConfig &cfg);
+
+    void setRoms(const uint8_t* kernal, const uint8_t* basic, const uint8_t* character)
+    {
+        m_player.setRoms(kernal, basic, character);
+    }
+
+    bool analyze(SidTune *tune, unsigned int maxSeconds, unsigned int silenceSeconds);
+
+    LoopDetector::result_t result() const { return m_result; }
+
+    double loopStart() const { return m_loopStart; }
+
+    double loopLength() const { return m_loopLength; }
+
+    double confidence() const { return m_confidence; }
+
+    const char *error() const { return m_errorString; }
+};
+
+}
+
+#endif // ANALYZER_H
@@ -43,6 +43,9 @@ private:
     /// The next event in sequence.
     Event *next;
 
+    /// Position in the scheduler heap plus one, zero when not pending.
+    unsigned int heapIndex;
+
     /// The clock this event fires.
     event_clock_t triggerTime;
 
@@ -57,6 +60,7 @@ public:
      * @param name Descriptive string of the event.
      */
     Event(const char * const name) :
+        heapIndex(0),
         m_name(name) {}
 
     /**
@@ -22,18 +22,44 @@
 
 #include "EventScheduler.h"
 
+#include <algorithm>
+
+#include "Snapshot.h"
 
 namespace libsidplayfp
 {
 
 void EventScheduler::reset()
 {
+#ifdef EVENTSCHEDULER_TRACE
+    eventTrace(TRACE_RESET, nullptr, 0);
+#endif
+
+#ifdef EVENTSCHEDULER_HEAP
+    for (unsigned int i = 0; i < heapSize; i++)
+    {
+        heap[i].event->heapIndex = 0;
+    }
+    heapSize = 0;
+    nextOrder = 0;
+#else
     firstEvent = nullptr;
+#endif
     currentTime = 0;
 }
 
 void EventScheduler::cancel(Event &event)
 {
+#ifdef EVENTSCHEDULER_TRACE
+    eventTrace(TRACE_CANCEL, &event, 0);
+#endif
+
+#ifdef EVENTSCHEDULER_HEAP
+    if (event.heapIndex != 0)
+    {
+        remove(event.heapIndex - 1);
+    }
+#else
     Event **scan = &firstEvent;
 
     while (*scan != nullptr)
@@ -45,10 +71,14 @@ void EventScheduler::cancel(Event &event)
         }
         scan = &((*scan)->next);
     }
+#endif
 }
 
 bool EventScheduler::isPending(Event &event) const
 {
+#ifdef EVENTSCHEDULER_HEAP
+    return event.heapIndex != 0;
+#else
     Event *scan = firstEvent;
     while (scan != nullptr)
     {
@@ -59,6 +89,80 @@ bool EventScheduler::isPending(Event &event) const
         scan = scan->next;
     }
     return false;
+#endif
+}
+
+void EventScheduler::snapshot(Snapshot &s, const std::vector<Event*> &events)
+{
+    s.value(currentTime);
+
+    if (!s.loading())
+    {
+        // Collect the pending events in firing order
+        std::vector<Event*> pending;
+#ifdef EVENTSCHEDULER_HEAP
+        std::vector<heapNode_t> nodes(heap.begin(), heap.begin() + heapSize);
+        std::sort(nodes.begin(), nodes.end(), earlier);
+        for (std::vector<heapNode_t>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)
+            pending.push_back(it->event);
+#else
+        for (Event *scan = firstEvent; scan != nullptr; scan = scan->next)
+            pending.push_back(scan);
+#endif
+
+        uint32_t count = static_cast<uint32_t>(pending.size());
+        s.value(count);
+
+        for (std::vector<Event*>::const_iterator it = pending.begin(); it != pending.end(); ++it)
+        {
+            const std::vector<Event*>::const_iterator found = std::find(events.begin(), events.end(), *it);
+            if (found == events.end())
+            {
+                // Not owned by a component that can be saved
+                s.fail();
+                return;
+            }
+
+            uint32_t index = static_cast<uint32_t>(found - events.begin());
+            event_clock_t delay = (*it)->triggerTime - currentTime;
+            s.value(index);
+            s.value(delay);
+        }
+    }
+    else
+    {
+#ifdef EVENTSCHEDULER_HEAP
+        for (unsigned int i = 0; i < heapSize; i++)
+        {
+            heap[i].event->heapIndex = 0;
+        }
+        heapSize = 0;
+#else
+        firstEvent = nullptr;
+#endif
+
+        uint32_t count = 0;
+        s.value(count);
+
+        // Rescheduling in firing order keeps the order of equal time events
+        for (uint32_t i = 0; s.ok() && i < count; i++)
+        {
+            uint32_t index = 0;
+            event_clock_t delay = 0;
+            s.value(index);
+            s.value(delay);
+
+            if (!s.ok() || index >= events.size() || delay < 0 || isPending(*events[index]))
+            {
+                s.fail();
+                return;
+            }
+
+            Event &event = *events[index];
+            event.triggerTime = currentTime + delay;
+            schedule(event);
+        }
+    }
 }
 
 }
@@ -23,14 +23,22 @@
 #ifndef EVENTSCHEDULER_H
 #define EVENTSCHEDULER_H
 
+#include <vector>
+
 #include "Event.h"
 
 #include "sidcxx11.h"
 
+#ifdef EVENTSCHEDULER_HEAP
+#  include <cassert>
+#endif
+
 
 namespace libsidplayfp
 {
 
+class Snapshot;
+
 /**
  * C64 system runs actions at system clock high and low
  * states. The PHI1 corresponds to the auxiliary chip activity
@@ -44,6 +52,32 @@ typedef enum
 } event_phase_t;
 
 
+/**
+ * Scheduler operations reported to the trace sink.
+ */
+typedef enum
+{
+    TRACE_SCHEDULE_PHI1 = 0,
+    TRACE_SCHEDULE_PHI2,
+    TRACE_SCHEDULE,
+    TRACE_CANCEL,
+    TRACE_CLOCK,
+    TRACE_RESET
+} event_trace_t;
+
+#ifdef EVENTSCHEDULER_TRACE
+/**
+ * Trace sink, must be provided by the program built with
+ * EVENTSCHEDULER_TRACE defined.
+ *
+ * @param op the operation
+ * @param event the event, nullptr for reset
+ * @param cycles the requested delay for schedule operations
+ */
+void eventTrace(event_trace_t op, const Event *event, unsigned int cycles);
+#endif
+
+
 /**
  * Fast EventScheduler, which maintains a linked list of Events.
  * This scheduler takes neglible time even when it is used to
@@ -57,17 +91,114 @@ typedef enum
  * Scheduling an event for a phi1 clock when system is in phi2 causes the
  * event to be moved to the next phi1 cycle. Correspondingly, requesting
  * a phi1 time when system is in phi2 returns the value of the next phi1.
+ *
+ * When built with EVENTSCHEDULER_HEAP defined (configure --enable-heap-scheduler)
+ * the pending events are kept in a binary heap instead,
+ * giving O(log n) insertion and cancellation and O(1) pending checks.
+ * Events with the same trigger time fire in scheduling order
+ * with both implementations.
  */
 class EventScheduler
 {
+#ifdef EVENTSCHEDULER_HEAP
+private:
+    /// Initial room for pending events, the heap grows if needed.
+    static const unsigned int INITIAL_EVENTS = 64;
+
+    typedef struct
+    {
+        event_clock_t triggerTime;
+        uint_least64_t order;
+        Event *event;
+    } heapNode_t;
+#endif
+
 private:
+#ifdef EVENTSCHEDULER_HEAP
+    /// The pending events, earliest first.
+    std::vector<heapNode_t> heap;
+
+    /// Number of pending events.
+    unsigned int heapSize;
+
+    /// Insertion counter, used to keep equal time events in order.
+    uint_least64_t nextOrder;
+#else
     /// The first event of the chain.
     Event *firstEvent;
+#endif
 
     /// EventScheduler's current clock.
     event_clock_t currentTime;
 
 private:
+#ifdef EVENTSCHEDULER_HEAP
+    static bool earlier(const heapNode_t &a, const heapNode_t &b)
+    {
+        return a.triggerTime < b.triggerTime
+            || (a.triggerTime == b.triggerTime && a.order < b.order);
+    }
+
+    void place(const heapNode_t &node, unsigned int pos)
+    {
+        heap[pos] = node;
+        node.event->heapIndex = pos + 1;
+    }
+
+    /**
+     * Move the node up toward the root until the heap is ordered.
+     */
+    void siftUp(const heapNode_t &node, unsigned int pos)
+    {
+        while (pos > 0)
+        {
+            const unsigned int parent = (pos - 1) >> 1;
+            if (!earlier(node, heap[parent]))
+                break;
+            place(heap[parent], pos);
+            pos = parent;
+        }
+        place(node, pos);
+    }
+
+    /**
+     * Move the node down toward the leaves until the heap is ordered.
+     */
+    void siftDown(const heapNode_t &node, unsigned int pos)
+    {
+        for (;;)
+        {
+            unsigned int child = (pos << 1) + 1;
+            if (child >= heapSize)
+                break;
+            if (child + 1 < heapSize && earlier(heap[child + 1], heap[child]))
+                child++;
+            if (!earlier(heap[child], node))
+                break;
+            place(heap[child], pos);
+            pos = child;
+        }
+        place(node, pos);
+    }
+
+    /**
+     * Remove the node at the given position.
+     */
+    void remove(unsigned int pos)
+    {
+        heap[pos].event->heapIndex = 0;
+
+        if (pos == --heapSize)
+            return;
+
+        const heapNode_t last = heap[heapSize];
+        if (pos > 0 && earlier(last, heap[(pos - 1) >> 1]))
+            siftUp(last, pos);
+        else
+            siftDown(last, pos);
+    }
+#endif
+
     /**
      * Scan the event queue and schedule event for execution.
      *
@@ -75,6 +206,15 @@ private:
      */
     void schedule(Event &event)
     {
+#ifdef EVENTSCHEDULER_HEAP
+        assert(event.heapIndex == 0);
+
+        if (heapSize == heap.size())
+            heap.resize(heapSize * 2);
+
+        const heapNode_t node = { event.triggerTime, nextOrder++, &event };
+        siftUp(node, heapSize++);
+#else
         // find the right spot where to tuck this new event
         Event **scan = &firstEvent;
         for (;;)
@@ -87,11 +227,18 @@ private:
              }
              scan = &((*scan)->next);
          }
+#endif
     }
 
 public:
     EventScheduler() :
+#ifdef EVENTSCHEDULER_HEAP
+        heap(INITIAL_EVENTS),
+        heapSize(0),
+        nextOrder(0),
+#else
         firstEvent(nullptr),
+#endif
         currentTime(0) {}
 
     /**
@@ -106,6 +253,9 @@ public:
     void schedule(Event &event, unsigned int cycles, event_phase_t phase)
     {
         // this strange formulation always selects the next available slot regardless of specified phase.
+#ifdef EVENTSCHEDULER_TRACE
+        eventTrace(phase == EVENT_CLOCK_PHI1 ? TRACE_SCHEDULE_PHI1 : TRACE_SCHEDULE_PHI2, &event, cycles);
+#endif
         event.triggerTime = currentTime + ((currentTime & 1) ^ phase) + (cycles << 1);
         schedule(event);
     }
@@ -118,6 +268,9 @@ public:
      */
     void schedule(Event &event, unsigned int cycles)
     {
+#ifdef EVENTSCHEDULER_TRACE
+        eventTrace(TRACE_SCHEDULE, &event, cycles);
+#endif
         event.triggerTime = currentTime + (cycles << 1);
         schedule(event);
     }
@@ -134,17 +287,58 @@ public:
      */
     void reset();
 
+    /**
+     * Save or restore the clock and the pending events.
+     * The events are identified by their position in the list,
+     * which must be built in the same order when restoring.
+     * The trigger times are stored relative to the current time.
+     *
+     * @param s the snapshot
+     * @param events all the events that may be pending
+     */
+    void snapshot(Snapshot &s, const std::vector<Event*> &events);
+
     /**
      * Fire next event, advance system time to that event.
      */
     void clock()
     {
+#ifdef EVENTSCHEDULER_HEAP
+        Event &event = *heap[0].event;
+        remove(0);
+#else
         Event &event = *firstEvent;
         firstEvent = firstEvent->next;
+#endif
+#ifdef EVENTSCHEDULER_TRACE
+        eventTrace(TRACE_CLOCK, &event, 0);
+#endif
         currentTime = event.triggerTime;
         event.event();
     }
 
+    /**
+     * Move the clock forward in place of an event rescheduling
+     * itself after the given cycles, as long as no other event
+     * is due up to that time.
+     *
+     * @param cycles how many cycles to advance
+     * @return true if the clock has been advanced
+     */
+    bool advance(unsigned int cycles)
+    {
+        const event_clock_t time = currentTime + (cycles << 1);
+#ifdef EVENTSCHEDULER_HEAP
+        if (heapSize != 0 && heap[0].triggerTime <= time)
+#else
+        if (firstEvent != nullptr && firstEvent->triggerTime <= time)
+#endif
+            return false;
+
+        currentTime = time;
+        return true;
+    }
+
     /**
      * Check if an event is in the queue.
      *
@@ -0,0 +1,177 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "LoopDetector.h"
+
+namespace libsidplayfp
+{
+
+/// Base of the rolling hash, any odd number will do
+const uint_least64_t HASH_BASE = 0x100000001b3ULL;
+
+LoopDetector::LoopDetector(unsigned int window, unsigned int confirm, unsigned int silence) :
+    m_window(window),
+    m_confirm(confirm),
+    m_silence(silence)
+{
+    m_windowPower = 1;
+    for (unsigned int i = 0; i < m_window; i++)
+    {
+        m_windowPower *= HASH_BASE;
+    }
+
+    reset();
+}
+
+void LoopDetector::reset()
+{
+    m_states.clear();
+    m_windows.clear();
+    m_writes.clear();
+    m_windowHash = 0;
+    m_silentFrames = 0;
+    m_verified = 0;
+    m_loopStart = 0;
+    m_loopLength = 0;
+    m_candidateFrame = 0;
+    m_candidateStart = 0;
+    m_candidateLength = 0;
+    m_result = NONE;
+}
+
+bool LoopDetector::checkAudio(unsigned int frame)
+{
+    if (m_result == AUDIO)
+    {
+        // Verify the candidate, drop it on the first mismatch
+        if (m_writes[frame] == m_writes[frame - m_loopLength])
+        {
+            m_windows[m_windowHash] = frame;
+            m_verified++;
+            return m_verified >= m_confirm && m_verified >= 2 * m_loopLength;
+        }
+
+        m_result = NONE;
+        m_verified = 0;
+    }
+
+    if (frame + 1 < m_window)
+        return false;
+
+    std::map<uint_least64_t, unsigned int>::const_iterator it = m_windows.find(m_windowHash);
+    if (it == m_windows.end())
+    {
+        m_windows[m_windowHash] = frame;
+        return false;
+    }
+
+    m_loopLength = frame - it->second;
+
+    // Move the start back to the first repeated frame
+    unsigned int start = it->second + 1 - m_window;
+    while (start > 0 && m_writes[start - 1] == m_writes[start - 1 + m_loopLength])
+        start--;
+
+    m_loopStart = start;
+    m_verified = m_window;
+    m_result = AUDIO;
+
+    // Later windows are matched against the most recent occurrence
+    m_windows[m_windowHash] = frame;
+
+    return false;
+}
+
+bool LoopDetector::frame(uint_least64_t state, uint_least64_t writes, bool silent)
+{
+    const unsigned int frame = m_writes.size();
+
+    m_writes.push_back(writes);
+    m_windowHash = m_windowHash * HASH_BASE + writes;
+    if (frame >= m_window)
+        m_windowHash -= m_windowPower * m_writes[frame - m_window];
+
+    // Sustained silence
+    if (silent)
+    {
+        if (++m_silentFrames >= m_silence)
+        {
+            m_loopStart = frame + 1 - m_silentFrames;
+            m_loopLength = 0;
+            m_result = SILENCE;
+            return true;
+        }
+    }
+    else
+        m_silentFrames = 0;
+
+    // The machine looks back to a previous state
+    std::map<uint_least64_t, unsigned int>::const_iterator it = m_states.find(state);
+    if (it == m_states.end())
+    {
+        m_states[state] = frame;
+    }
+    else if (m_candidateLength == 0)
+    {
+        // The loop starts with the frame following the repeated state
+        m_candidateFrame = frame;
+        m_candidateStart = it->second + 1;
+        m_candidateLength = frame - it->second;
+    }
+
+    return checkAudio(frame);
+}
+
+bool LoopDetector::confirm(bool match)
+{
+    if (match)
+    {
+        m_loopStart = m_candidateStart;
+        m_loopLength = m_candidateLength;
+        m_result = EXACT;
+    }
+
+    m_candidateLength = 0;
+    return match;
+}
+
+double LoopDetector::confidence() const
+{
+    switch (m_result)
+    {
+    case EXACT:
+        return 1.;
+    case SILENCE:
+        // The envelopes are only estimated and a tune may come back
+        // after a long pause, so rank it below a verified audio loop
+        return 0.5;
+    case AUDIO:
+        {
+            const unsigned int needed = m_confirm > 2 * m_loopLength ? m_confirm : 2 * m_loopLength;
+            const double verified = m_verified < needed ? m_verified : needed;
+            return 0.5 + 0.4 * verified / needed;
+        }
+    default:
+        return 0.;
+    }
+}
+
+}
@@ -0,0 +1,168 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef LOOPDETECTOR_H
+#define LOOPDETECTOR_H
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+namespace libsidplayfp
+{
+
+/**
+ * Find where a tune loops or falls silent from per frame digests.
+ *
+ * Each frame provides:
+ * - a hash of the machine state, a repeated state is an exact loop
+ *   candidate which the caller confirms on the full state
+ * - a hash of the SID writes during the frame, a repeated sequence
+ *   is taken as a loop of the audio once verified for long enough
+ * - whether the SIDs are silent, sustained silence ends the tune
+ */
+class LoopDetector
+{
+public:
+    typedef enum
+    {
+        NONE,       ///< Nothing found yet
+        EXACT,      ///< The machine state repeats
+        AUDIO,      ///< The SID writes repeat
+        SILENCE     ///< The output went silent
+    } result_t;
+
+private:
+    /// Frames in the window of writes that starts an audio loop candidate
+    const unsigned int m_window;
+
+    /// Frames an audio loop must be verified for
+    const unsigned int m_confirm;
+
+    /// Frames of silence that end the tune
+    const unsigned int m_silence;
+
+    /// First frame of each machine state
+    std::map<uint_least64_t, unsigned int> m_states;
+
+    /// Last frame of each window of writes
+    std::map<uint_least64_t, unsigned int> m_windows;
+
+    /// Hash of the writes of each frame
+    std::vector<uint_least64_t> m_writes;
+
+    /// Rolling hash of the last m_window frames of writes
+    uint_least64_t m_windowHash;
+
+    /// Multiplier to drop the oldest frame from the rolling hash
+    uint_least64_t m_windowPower;
+
+    /// Consecutive silent frames
+    unsigned int m_silentFrames;
+
+    /// Frames verified for the current audio candidate
+    unsigned int m_verified;
+
+    unsigned int m_loopStart;
+    unsigned int m_loopLength;
+
+    /// Exact loop candidate, zero length if none
+    //@{
+    unsigned int m_candidateFrame;
+    unsigned int m_candidateStart;
+    unsigned int m_candidateLength;
+    //@}
+
+    result_t m_result;
+
+private:
+    bool checkAudio(unsigned int frame);
+
+public:
+    /**
+     * @param window frames of writes to match before considering an audio loop
+     * @param confirm frames an audio loop has to be verified for
+     * @param silence frames of silence that end the tune
+     */
+    LoopDetector(unsigned int window, unsigned int confirm, unsigned int silence);
+
+    /**
+     * Start a new analysis.
+     */
+    void reset();
+
+    /**
+     * Feed the next frame.
+     *
+     * @param state hash of the machine state
+     * @param writes hash of the SID writes during the frame
+     * @param silent true if the SIDs are silent
+     * @return true when the analysis is complete
+     */
+    bool frame(uint_least64_t state, uint_least64_t writes, bool silent);
+
+    /**
+     * Check if a repeated machine state waits for confirmation.
+     *
+     * The hashes may collide, so the caller has to save the full
+     * machine state at #candidateFrame(), compare it with the one
+     * #candidateLength() frames later and report with #confirm().
+     */
+    bool candidate() const { return m_candidateLength != 0; }
+
+    unsigned int candidateFrame() const { return m_candidateFrame; }
+
+    unsigned int candidateLength() const { return m_candidateLength; }
+
+    /**
+     * Report whether the full state of the candidate repeated.
+     *
+     * @param match true if the full states are equal
+     * @return true when the analysis is complete
+     */
+    bool confirm(bool match);
+
+    /**
+     * Get the kind of result, an AUDIO result may still be unverified.
+     */
+    result_t result() const { return m_result; }
+
+    /**
+     * Get the frame where the loop or silence starts.
+     * For exact loops this is the frame after the repeated state.
+     */
+    unsigned int loopStart() const { return m_loopStart; }
+
+    /**
+     * Get the length of the loop in frames, zero for silence.
+     */
+    unsigned int loopLength() const { return m_loopLength; }
+
+    /**
+     * Get the confidence of the result, from 0 to 1.
+     */
+    double confidence() const;
+};
+
+}
+
+#endif // LOOPDETECTOR_H
@@ -0,0 +1,173 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "RegisterSid.h"
+
+#include <cstring>
+
+namespace libsidplayfp
+{
+
+/// Attack times in milliseconds from the datasheet
+const unsigned int attackTimes[16] =
+{
+    2, 8, 16, 24, 38, 56, 68, 80, 100, 250, 500, 800, 1000, 3000, 5000, 8000
+};
+
+/// Decay and release are three times slower than attack
+const unsigned int DECAY_FACTOR = 3;
+
+const uint_least64_t FNV_OFFSET = 0xcbf29ce484222325ULL;
+const uint_least64_t FNV_PRIME = 0x100000001b3ULL;
+
+RegisterSid::RegisterSid(sidbuilder *builder) :
+    sidemu(builder),
+    m_cyclesPerMs(985.248),
+    m_writeHash(FNV_OFFSET),
+    m_volumeChanged(false)
+{
+    reset(0);
+}
+
+void RegisterSid::reset(uint8_t volume)
+{
+    m_accessClk = 0;
+    memset(m_regs, 0, sizeof(m_regs));
+    m_regs[0x18] = volume;
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        m_gateTime[i] = 0;
+        m_releaseLeft[i] = 0;
+    }
+}
+
+void RegisterSid::sampling(float systemfreq, float, SidConfig::sampling_method_t, bool)
+{
+    m_cyclesPerMs = systemfreq / 1000.;
+}
+
+void RegisterSid::clock()
+{
+    const event_clock_t cycles = eventScheduler->getTime(m_accessClk, EVENT_CLOCK_PHI1);
+    m_accessClk += cycles;
+
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        if (m_regs[i * 7 + 4] & 0x01)
+            m_gateTime[i] += cycles;
+        else if (m_releaseLeft[i] > cycles)
+            m_releaseLeft[i] -= cycles;
+        else
+            m_releaseLeft[i] = 0;
+    }
+}
+
+uint8_t RegisterSid::read(uint_least8_t)
+{
+    return 0;
+}
+
+void RegisterSid::write(uint_least8_t addr, uint8_t data)
+{
+    clock();
+
+    m_writeHash = (m_writeHash ^ addr) * FNV_PRIME;
+    m_writeHash = (m_writeHash ^ data) * FNV_PRIME;
+
+    if (addr == 0x18)
+    {
+        if ((data ^ m_regs[0x18]) & 0x0f)
+            m_volumeChanged = true;
+    }
+    else if (addr < 0x15 && addr % 7 == 4)
+    {
+        const unsigned int voice = addr / 7;
+        const uint8_t gate = data & 0x01;
+        if (gate && !(m_regs[addr] & 0x01))
+        {
+            m_gateTime[voice] = 0;
+        }
+        else if (!gate && (m_regs[addr] & 0x01))
+        {
+            const unsigned int release = m_regs[addr + 2] & 0x0f;
+            m_releaseLeft[voice] = static_cast<event_clock_t>(
+                attackTimes[release] * DECAY_FACTOR * m_cyclesPerMs);
+        }
+    }
+
+    m_regs[addr] = data;
+}
+
+bool RegisterSid::isAudible(unsigned int voice) const
+{
+    const uint8_t *regs = m_regs + voice * 7;
+
+    // No waveform or a stopped oscillator only give a constant level
+    if ((regs[4] & 0xf0) == 0 || (regs[0] | regs[1]) == 0)
+        return false;
+
+    if (regs[4] & 0x01)
+    {
+        // With zero sustain the envelope is silent once attack and decay are over
+        if ((regs[6] & 0xf0) != 0)
+            return true;
+
+        const unsigned int adTime = attackTimes[regs[5] >> 4]
+            + attackTimes[regs[5] & 0x0f] * DECAY_FACTOR;
+        return m_gateTime[voice] < static_cast<event_clock_t>(adTime * m_cyclesPerMs);
+    }
+
+    return m_releaseLeft[voice] > 0;
+}
+
+bool RegisterSid::isSilent() const
+{
+    if (m_volumeChanged)
+        return false;
+
+    if ((m_regs[0x18] & 0x0f) == 0)
+        return true;
+
+    return !isAudible(0) && !isAudible(1) && !isAudible(2);
+}
+
+uint_least64_t RegisterSid::takeWrites()
+{
+    const uint_least64_t hash = m_writeHash;
+    m_writeHash = FNV_OFFSET;
+    m_volumeChanged = false;
+    return hash;
+}
+
+}
+
+unsigned int RegisterSidBuilder::create(unsigned int sids)
+{
+    m_status = true;
+
+    for (unsigned int i = 0; i < sids; i++)
+    {
+        sidobjs.insert(new libsidplayfp::RegisterSid(this));
+    }
+
+    return sids;
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef REGISTERSID_H
+#define REGISTERSID_H
+
+#include <stdint.h>
+
+#include "sidplayfp/sidbuilder.h"
+#include "sidemu.h"
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * A SID which only keeps the register file and a rough model
+ * of the envelopes to tell when the output is silent,
+ * for analysing tunes without the cost of the sound emulation.
+ * Reads return zero.
+ */
+class RegisterSid final : public sidemu
+{
+private:
+    /// Register file
+    uint8_t m_regs[0x20];
+
+    /// Cycles since the gate was set, per voice
+    event_clock_t m_gateTime[3];
+
+    /// Upper bound of the remaining release cycles, per voice
+    event_clock_t m_releaseLeft[3];
+
+    /// CPU cycles per millisecond
+    double m_cyclesPerMs;
+
+    /// Hash of the writes since the last call to #takeWrites
+    uint_least64_t m_writeHash;
+
+    /// The volume has changed since the last call to #takeWrites
+    bool m_volumeChanged;
+
+private:
+    bool isAudible(unsigned int voice) const;
+
+protected:
+    uint8_t read(uint_least8_t addr) override;
+    void write(uint_least8_t addr, uint8_t data) override;
+
+public:
+    RegisterSid(sidbuilder *builder);
+
+    void reset(uint8_t volume) override;
+
+    void clock() override;
+
+    void voice(unsigned int, bool) override {}
+
+    void model(SidConfig::sid_model_t) override {}
+
+    void sampling(float systemfreq, float outputfreq,
+        SidConfig::sampling_method_t method, bool fast) override;
+
+    /**
+     * Get the register file.
+     */
+    const uint8_t *registers() const { return m_regs; }
+
+    /**
+     * Check if the chip is silent, a change of volume since
+     * the last call to #takeWrites counts as sound.
+     */
+    bool isSilent() const;
+
+    /**
+     * Get the hash of the writes since the last call and restart it.
+     */
+    uint_least64_t takeWrites();
+};
+
+}
+
+/**
+ * Builder for the register file SIDs.
+ */
+class RegisterSidBuilder : public sidbuilder
+{
+public:
+    RegisterSidBuilder(const char * const name) :
+        sidbuilder(name) {}
+    ~RegisterSidBuilder() { remove(); }
+
+    unsigned int availDevices() const override { return 0; }
+
+    unsigned int create(unsigned int sids) override;
+
+    const char *credits() const override { return "Register file SID for tune analysis"; }
+
+    void filter(bool) override {}
+};
+
+#endif // REGISTERSID_H
@@ -0,0 +1,319 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "Replayer.h"
+
+#include "sidplayfp/sidbuilder.h"
+
+#include "SidCapture.h"
+#include "sidemu.h"
+
+#include <cstring>
+
+namespace libsidplayfp
+{
+
+// Error Strings
+const char ERR_NA[]                   = "NA";
+const char ERR_UNSUPPORTED_FREQ[]     = "SIDREPLAY ERROR: Unsupported sampling frequency.";
+const char ERR_NO_EMULATION[]         = "SIDREPLAY ERROR: No SID emulation.";
+const char ERR_BAD_STREAM[]           = "SIDREPLAY ERROR: Not a SID write stream.";
+const char ERR_UNSUPPORTED_VERSION[]  = "SIDREPLAY ERROR: Unsupported stream version.";
+const char ERR_TRUNCATED[]            = "SIDREPLAY ERROR: Truncated stream.";
+
+Replayer::Replayer() :
+    m_cpuFreq(1.),
+    m_stream(nullptr),
+    m_streamEnd(nullptr),
+    m_pos(nullptr),
+    m_nextTime(0),
+    m_errorString(ERR_NA),
+    m_isPlaying(false) {}
+
+Replayer::~Replayer()
+{
+    sidRelease();
+}
+
+bool Replayer::config(const SidConfig &cfg)
+{
+    // Check for base sampling frequency
+    if (cfg.frequency < 8000)
+    {
+        m_errorString = ERR_UNSUPPORTED_FREQ;
+        return false;
+    }
+
+    m_cfg = cfg;
+
+    // Recreate the chips for the loaded stream
+    if (m_stream != nullptr)
+        return load(m_stream, static_cast<uint_least32_t>(m_streamEnd - m_stream));
+
+    return true;
+}
+
+void Replayer::sidRelease()
+{
+    for (unsigned int i = 0; ; i++)
+    {
+        sidemu *s = m_mixer.getSid(i);
+        if (s == nullptr)
+            break;
+
+        if (sidbuilder *b = s->builder())
+        {
+            b->unlock(s);
+        }
+    }
+
+    m_mixer.clearSids();
+}
+
+bool Replayer::sidCreate()
+{
+    sidbuilder *builder = m_cfg.sidEmulation;
+    if (builder == nullptr)
+    {
+        m_errorString = ERR_NO_EMULATION;
+        return false;
+    }
+
+    for (std::vector<SidConfig::sid_model_t>::const_iterator it = m_models.begin(); it != m_models.end(); ++it)
+    {
+        const SidConfig::sid_model_t model = m_cfg.forceSidModel ? m_cfg.defaultSidModel : *it;
+        sidemu *s = builder->lock(&m_scheduler, model);
+        if (!builder->getStatus())
+        {
+            m_errorString = builder->error();
+            sidRelease();
+            return false;
+        }
+
+        s->sampling(static_cast<float>(m_cpuFreq), m_cfg.frequency, m_cfg.samplingMethod, m_cfg.fastSampling);
+        m_mixer.addSid(s);
+    }
+
+    m_mixer.setStereo(m_cfg.playback == SidConfig::STEREO);
+    m_mixer.setVolume(m_cfg.leftVolume, m_cfg.rightVolume);
+
+    return true;
+}
+
+bool Replayer::load(const uint_least8_t *stream, uint_least32_t size)
+{
+    sidRelease();
+
+    m_stream = nullptr;
+    m_isPlaying = false;
+
+    if ((size < SidCapture::HEADER_SIZE)
+        || (memcmp(stream, SidCapture::MAGIC, sizeof(SidCapture::MAGIC)) != 0))
+    {
+        m_errorString = ERR_BAD_STREAM;
+        return false;
+    }
+
+    if (stream[4] != SidCapture::STREAM_VERSION)
+    {
+        m_errorString = ERR_UNSUPPORTED_VERSION;
+        return false;
+    }
+
+    const unsigned int chips = stream[5];
+    if ((chips == 0) || (chips > 4) || (size < SidCapture::HEADER_SIZE + chips))
+    {
+        m_errorString = ERR_BAD_STREAM;
+        return false;
+    }
+
+    m_models.clear();
+    for (unsigned int i = 0; i < chips; i++)
+    {
+        m_models.push_back(stream[6 + i] ? SidConfig::MOS8580 : SidConfig::MOS6581);
+    }
+
+    const uint_least8_t *p = stream + 6 + chips;
+    uint64_t freq = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        freq |= static_cast<uint64_t>(p[i]) << (i * 8);
+    }
+    memcpy(&m_cpuFreq, &freq, sizeof(m_cpuFreq));
+
+    if (!(m_cpuFreq > 0.))
+    {
+        m_errorString = ERR_BAD_STREAM;
+        return false;
+    }
+
+    if (!sidCreate())
+        return false;
+
+    m_stream = stream;
+    m_streamEnd = stream + size;
+    m_pos = p + 8;
+
+    m_scheduler.reset();
+    for (unsigned int i = 0; ; i++)
+    {
+        sidemu *s = m_mixer.getSid(i);
+        if (s == nullptr)
+            break;
+
+        s->reset(0xf);
+    }
+    m_mixer.resetBufs();
+
+    m_nextTime = 0;
+    m_isPlaying = readTime();
+
+    return true;
+}
+
+bool Replayer::readTime()
+{
+    uint_least64_t delta = 0;
+    unsigned int shift = 0;
+    for (;;)
+    {
+        if ((m_pos == m_streamEnd) || (shift > 56))
+        {
+            m_errorString = ERR_TRUNCATED;
+            return false;
+        }
+
+        const uint_least8_t b = *m_pos++;
+        delta |= static_cast<uint_least64_t>(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+            break;
+        shift += 7;
+    }
+
+    m_nextTime += static_cast<event_clock_t>(delta);
+    return true;
+}
+
+void Replayer::runUntil(event_clock_t time)
+{
+    // Nothing is scheduled unless the chips need it,
+    // so the clock can usually jump straight to the target
+    event_clock_t now;
+    while ((now = m_scheduler.getTime(EVENT_CLOCK_PHI1)) < time)
+    {
+        if (!m_scheduler.advance(static_cast<unsigned int>(time - now)))
+            m_scheduler.clock();
+    }
+}
+
+void Replayer::run(unsigned int cycles)
+{
+    const event_clock_t end = m_scheduler.getTime(EVENT_CLOCK_PHI1) + cycles;
+
+    while (m_isPlaying && m_nextTime <= end)
+    {
+        runUntil(m_nextTime);
+
+        if (m_streamEnd - m_pos < 1)
+        {
+            m_errorString = ERR_TRUNCATED;
+            m_isPlaying = false;
+            return;
+        }
+
+        const uint_least8_t cmd = *m_pos++;
+
+        if (cmd == SidCapture::CMD_END)
+        {
+            m_isPlaying = false;
+            return;
+        }
+
+        if (m_pos == m_streamEnd)
+        {
+            m_errorString = ERR_TRUNCATED;
+            m_isPlaying = false;
+            return;
+        }
+
+        const uint8_t data = *m_pos++;
+
+        if (cmd == SidCapture::CMD_RESET)
+        {
+            m_scheduler.reset();
+            for (unsigned int i = 0; ; i++)
+            {
+                sidemu *s = m_mixer.getSid(i);
+                if (s == nullptr)
+                    break;
+
+                s->reset(data);
+            }
+
+            // The clock restarts from zero, end the chunk here
+            m_nextTime = 0;
+            m_isPlaying = readTime();
+            return;
+        }
+        else if (sidemu *s = m_mixer.getSid(cmd >> 5))
+        {
+            s->poke(cmd & 0x1f, data);
+        }
+
+        m_isPlaying = readTime();
+    }
+
+    if (m_isPlaying)
+        runUntil(end);
+}
+
+template <typename T>
+uint_least32_t Replayer::playSamples(T *buffer, uint_least32_t count)
+{
+    if (!m_isPlaying || buffer == nullptr)
+        return 0;
+
+    m_mixer.begin(buffer, count);
+
+    // The chips get at most OUTPUTBUFFERSIZE cycles at a time
+    // so that they can't overflow their buffers
+    while (m_isPlaying && m_mixer.notFinished())
+    {
+        run(sidemu::OUTPUTBUFFERSIZE);
+
+        m_mixer.clockChips();
+        m_mixer.doMix();
+    }
+
+    return m_mixer.samplesGenerated();
+}
+
+uint_least32_t Replayer::play(short *buffer, uint_least32_t count)
+{
+    return playSamples(buffer, count);
+}
+
+uint_least32_t Replayer::playFloat(float *buffer, uint_least32_t count)
+{
+    return playSamples(buffer, count);
+}
+
+}
@@ -0,0 +1,129 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef REPLAYER_H
+#define REPLAYER_H
+
+#include <stdint.h>
+
+#include "sidplayfp/SidConfig.h"
+
+#include "EventScheduler.h"
+#include "mixer.h"
+
+#include <vector>
+
+namespace libsidplayfp
+{
+
+/**
+ * Plays back a stream of SID writes recorded by SidCapture,
+ * clocking only the SID emulation.
+ */
+class Replayer
+{
+private:
+    /// Scheduler providing the time base to the chips
+    EventScheduler m_scheduler;
+
+    /// Mixer
+    Mixer m_mixer;
+
+    /// User configuration
+    SidConfig m_cfg;
+
+    /// Models of the captured chips
+    std::vector<SidConfig::sid_model_t> m_models;
+
+    /// CPU clock frequency of the capture
+    double m_cpuFreq;
+
+    /// The stream, owned by the caller
+    const uint_least8_t *m_stream;
+    const uint_least8_t *m_streamEnd;
+
+    /// Current position in the stream
+    const uint_least8_t *m_pos;
+
+    /// Time of the next record in PHI1 cycles
+    event_clock_t m_nextTime;
+
+    const char *m_errorString;
+
+    bool m_isPlaying;
+
+private:
+    /**
+     * Create the SID emulation(s) for the loaded stream.
+     */
+    bool sidCreate();
+
+    /**
+     * Release the SID emulation(s).
+     */
+    void sidRelease();
+
+    /**
+     * Read the time of the next record.
+     *
+     * @return false if the stream is truncated
+     */
+    bool readTime();
+
+    /**
+     * Clock the scheduler up to the specified time.
+     */
+    void runUntil(event_clock_t time);
+
+    /**
+     * Apply the records for the next cycles.
+     *
+     * @param cycles how many cycles to run
+     */
+    void run(unsigned int cycles);
+
+    template <typename T>
+    uint_least32_t playSamples(T *buffer, uint_least32_t count);
+
+public:
+    Replayer();
+    ~Replayer();
+
+    const SidConfig &config() const { return m_cfg; }
+
+    bool config(const SidConfig &cfg);
+
+    bool load(const uint_least8_t *stream, uint_least32_t size);
+
+    uint_least32_t play(short *buffer, uint_least32_t count);
+
+    uint_least32_t playFloat(float *buffer, uint_least32_t count);
+
+    bool isPlaying() const { return m_isPlaying; }
+
+    uint_least32_t time() const { return static_cast<uint_least32_t>(m_scheduler.getTime(EVENT_CLOCK_PHI1) / m_cpuFreq); }
+
+    const char *error() const { return m_errorString; }
+};
+
+}
+
+#endif // REPLAYER_H
@@ -0,0 +1,88 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SidCapture.h"
+
+#include <cstring>
+
+namespace libsidplayfp
+{
+
+const char SidCapture::MAGIC[4] = { 'S', 'I', 'D', 'W' };
+
+SidCapture::SidCapture(std::vector<uint_least8_t> &stream, const EventScheduler &scheduler,
+                        double cpuFreq, const std::vector<SidConfig::sid_model_t> &models) :
+    m_stream(stream),
+    m_scheduler(scheduler),
+    m_lastTime(scheduler.getTime(EVENT_CLOCK_PHI1))
+{
+    m_stream.insert(m_stream.end(), MAGIC, MAGIC + 4);
+    m_stream.push_back(STREAM_VERSION);
+
+    m_stream.push_back(static_cast<uint_least8_t>(models.size()));
+    for (std::vector<SidConfig::sid_model_t>::const_iterator it = models.begin(); it != models.end(); ++it)
+    {
+        m_stream.push_back(*it == SidConfig::MOS8580 ? 1 : 0);
+    }
+
+    uint64_t freq;
+    memcpy(&freq, &cpuFreq, sizeof(freq));
+    for (int i = 0; i < 8; i++)
+    {
+        m_stream.push_back(static_cast<uint_least8_t>(freq >> (i * 8)));
+    }
+}
+
+void SidCapture::putTime()
+{
+    const event_clock_t now = m_scheduler.getTime(EVENT_CLOCK_PHI1);
+    uint_least64_t delta = static_cast<uint_least64_t>(now - m_lastTime);
+    m_lastTime = now;
+
+    while (delta >= 0x80)
+    {
+        m_stream.push_back(static_cast<uint_least8_t>(delta | 0x80));
+        delta >>= 7;
+    }
+    m_stream.push_back(static_cast<uint_least8_t>(delta));
+}
+
+void SidCapture::write(unsigned int chip, uint8_t addr, uint8_t data)
+{
+    putTime();
+    m_stream.push_back(static_cast<uint_least8_t>((chip << 5) | (addr & 0x1f)));
+    m_stream.push_back(data);
+}
+
+void SidCapture::reset(uint8_t volume)
+{
+    putTime();
+    m_stream.push_back(CMD_RESET);
+    m_stream.push_back(volume);
+    m_lastTime = 0;
+}
+
+void SidCapture::end()
+{
+    putTime();
+    m_stream.push_back(CMD_END);
+}
+
+}
@@ -0,0 +1,119 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SIDCAPTURE_H
+#define SIDCAPTURE_H
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "sidplayfp/SidConfig.h"
+#include "EventScheduler.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * Records the SID writes into a compact binary stream
+ * that can be replayed without emulating the C64.
+ *
+ * The stream starts with a header:
+ * - the "SIDW" magic and a version byte
+ * - the number of chips followed by their models, 0 for 6581 and 1 for 8580
+ * - the CPU clock frequency as a little endian IEEE double
+ *
+ * Then come the records, each one starting with the number of
+ * PHI1 cycles since the previous record as an unsigned LEB128
+ * followed by a command byte:
+ * - 0x00-0x7f: write, the chip number in bits 5-6 and the register
+ *   in bits 0-4, followed by the value
+ * - 0x80: machine reset, the clock restarts from zero, followed by
+ *   the volume written to the chips
+ * - 0xff: end of the stream
+ */
+class SidCapture
+{
+public:
+    enum
+    {
+        /// Stream format version
+        STREAM_VERSION = 1,
+
+        /// Size of the header without the chip models
+        HEADER_SIZE = 14
+    };
+
+    enum
+    {
+        CMD_RESET = 0x80,
+        CMD_END = 0xff
+    };
+
+    static const char MAGIC[4];
+
+private:
+    std::vector<uint_least8_t> &m_stream;
+
+    const EventScheduler &m_scheduler;
+
+    /// Time of the last record
+    event_clock_t m_lastTime;
+
+private:
+    void putTime();
+
+public:
+    /**
+     * Start capturing, the header is appended to the stream.
+     *
+     * @param stream the stream to append the records to
+     * @param scheduler the scheduler giving the write times
+     * @param cpuFreq the CPU clock frequency
+     * @param models the models of the chips
+     */
+    SidCapture(std::vector<uint_least8_t> &stream, const EventScheduler &scheduler,
+                double cpuFreq, const std::vector<SidConfig::sid_model_t> &models);
+
+    /**
+     * Record a register write.
+     *
+     * @param chip the chip number
+     * @param addr the register
+     * @param data the value
+     */
+    void write(unsigned int chip, uint8_t addr, uint8_t data);
+
+    /**
+     * Record a machine reset, to be called before resetting the scheduler.
+     *
+     * @param volume the volume written to the chips on reset
+     */
+    void reset(uint8_t volume);
+
+    /**
+     * Mark the end of the stream at the current time.
+     */
+    void end();
+};
+
+}
+
+#endif // SIDCAPTURE_H
@@ -0,0 +1,137 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <cstring>
+
+#include <vector>
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * Saves or restores the emulation state.
+ *
+ * Each component implements a single state method that passes
+ * its fields to #value() or #bytes(), so the same code
+ * both writes them out and reads them back, depending on
+ * the direction the snapshot has been created for.
+ * Fields derived from the configuration are not stored,
+ * the component recomputes them after loading instead.
+ *
+ * Values are stored in the native layout, the snapshots are
+ * meant to be restored by the same build of the library.
+ */
+class Snapshot
+{
+private:
+    /// The output buffer when saving
+    std::vector<uint8_t> *m_out;
+
+    /// The input data when restoring
+    const uint8_t *m_in;
+    size_t m_size;
+    size_t m_pos;
+
+    /// Set when the input is truncated or inconsistent
+    bool m_failed;
+
+public:
+    /**
+     * Create a snapshot for saving.
+     *
+     * @param out the buffer to append the state to
+     */
+    explicit Snapshot(std::vector<uint8_t> &out) :
+        m_out(&out),
+        m_in(nullptr),
+        m_size(0),
+        m_pos(0),
+        m_failed(false) {}
+
+    /**
+     * Create a snapshot for restoring.
+     *
+     * @param data the saved state
+     * @param size the size of the saved state
+     */
+    Snapshot(const uint8_t *data, size_t size) :
+        m_out(nullptr),
+        m_in(data),
+        m_size(size),
+        m_pos(0),
+        m_failed(false) {}
+
+    /**
+     * Check if the state is being restored.
+     */
+    bool loading() const { return m_out == nullptr; }
+
+    /**
+     * Check that no error occurred so far.
+     */
+    bool ok() const { return !m_failed; }
+
+    /**
+     * Get the number of bytes left to restore.
+     */
+    size_t remaining() const { return m_size - m_pos; }
+
+    /**
+     * Mark the snapshot as inconsistent.
+     */
+    void fail() { m_failed = true; }
+
+    /**
+     * Save or restore a block of memory.
+     */
+    void bytes(void *data, size_t size)
+    {
+        if (m_out != nullptr)
+        {
+            const uint8_t *p = static_cast<const uint8_t*>(data);
+            m_out->insert(m_out->end(), p, p + size);
+        }
+        else if (!m_failed && size <= m_size - m_pos)
+        {
+            memcpy(data, m_in + m_pos, size);
+            m_pos += size;
+        }
+        else
+        {
+            m_failed = true;
+        }
+    }
+
+    /**
+     * Save or restore a single value.
+     */
+    template<typename T>
+    void value(T &v) { bytes(&v, sizeof(T)); }
+};
+
+}
+
+#endif // SNAPSHOT_H
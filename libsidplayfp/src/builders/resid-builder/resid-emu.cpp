@@ -22,6 +22,7 @@
 
 #include "resid-emu.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <sstream>
@@ -29,6 +30,7 @@
 
 #include "resid/siddefs.h"
 #include "resid/spline.h"
+#include "Snapshot.h"
 
 namespace libsidplayfp
 {
@@ -54,9 +56,11 @@ const char* ReSID::getCredits()
 ReSID::ReSID(sidbuilder *builder) :
     sidemu(builder),
     m_sid(*(new reSID::SID)),
-    m_voiceMask(0x07)
+    m_sampleBuffer(new short[OUTPUTBUFFERSIZE]),
+    m_voiceMask(0x07),
+    m_silent(false)
 {
-    m_buffer = new short[OUTPUTBUFFERSIZE];
+    m_buffer = new float[OUTPUTBUFFERSIZE];
     reset(0);
 }
 
@@ -64,6 +68,7 @@ ReSID::~ReSID()
 {
     delete &m_sid;
     delete[] m_buffer;
+    delete[] m_sampleBuffer;
 }
 
 void ReSID::bias(double dac_bias)
@@ -95,7 +100,35 @@ void ReSID::clock()
 {
     reSID::cycle_count cycles = eventScheduler->getTime(m_accessClk, EVENT_CLOCK_PHI1);
     m_accessClk += cycles;
-    m_bufferpos += m_sid.clock(cycles, (short *) m_buffer + m_bufferpos, OUTPUTBUFFERSIZE - m_bufferpos, 1);
+
+    if (m_silent)
+    {
+        // Delta clocking without sampling, the resampler state is left behind
+        m_sid.clock(cycles);
+        return;
+    }
+
+    const int samples = m_sid.clock(cycles, m_sampleBuffer, OUTPUTBUFFERSIZE - m_bufferpos, 1);
+    std::copy(m_sampleBuffer, m_sampleBuffer + samples, m_buffer + m_bufferpos);
+    m_bufferpos += samples;
+}
+
+bool ReSID::chipSnapshot(Snapshot &s)
+{
+    reSID::SID::State state;
+
+    if (!s.loading())
+        state = m_sid.read_state();
+
+    s.value(state);
+
+    if (s.loading() && s.ok())
+    {
+        m_sid.write_state(state);
+        m_sid.set_voice_mask(m_voiceMask);
+    }
+
+    return true;
 }
 
 void ReSID::filter(bool enable)
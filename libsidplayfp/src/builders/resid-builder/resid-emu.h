@@ -44,8 +44,17 @@ class ReSID final : public sidemu
 {
 private:
     reSID::SID   &m_sid;
+
+    /// reSID produces 16 bit samples, converted into the float buffer
+    short        *m_sampleBuffer;
+
     uint8_t       m_voiceMask;
 
+    bool          m_silent;
+
+protected:
+    bool chipSnapshot(Snapshot &s) override;
+
 public:
     static const char* getCredits();
 
@@ -67,6 +76,8 @@ public:
     void sampling(float systemclock, float freq,
         SidConfig::sampling_method_t method, bool fast) override;
 
+    void silent(bool enable) override { m_silent = enable; }
+
     void voice(unsigned int num, bool mute) override;
 
     void model(SidConfig::sid_model_t model) override;
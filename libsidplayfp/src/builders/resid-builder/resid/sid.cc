@@ -24,9 +24,20 @@
 #define _ARM_WINAPI_PARTITION_DESKTOP_SDK_AVAILABLE 1
 #endif
 
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
 #include "sid.h"
 #include <math.h>
 
+#include <map>
+#include <mutex>
+
+#include <vector>
+
+#include "../../residfp-builder/residfp/resample/convolve.h"
+
 #ifndef round
 #define round(x) (x>=0.0?floor(x+0.5):ceil(x-0.5))
 #endif
@@ -34,6 +45,58 @@
 namespace reSID
 {
 
+// ----------------------------------------------------------------------------
+// Process wide cache of FIR tables.
+//
+// The tables only depend on the sampling parameters, so every SID instance
+// using the same parameters (e.g. the chips of a 2SID or 3SID tune) shares
+// a single read-only copy. Entries are reference counted and freed when the
+// last SID using them is destroyed or reconfigured. The table is calculated
+// outside of the lock, so chips set up with other parameters don't wait;
+// a reference is only taken once the table is in the cache.
+// ----------------------------------------------------------------------------
+namespace
+{
+
+struct fir_key
+{
+  int N;
+  int RES;
+  double beta;
+  double f_cycles_per_sample;
+  double filter_scale;
+
+  bool operator<(const fir_key& other) const
+  {
+    if (N != other.N) return N < other.N;
+    if (RES != other.RES) return RES < other.RES;
+    if (beta != other.beta) return beta < other.beta;
+    if (f_cycles_per_sample != other.f_cycles_per_sample)
+      return f_cycles_per_sample < other.f_cycles_per_sample;
+    return filter_scale < other.filter_scale;
+  }
+};
+
+struct fir_entry
+{
+  std::vector<short> fir;
+  int refs;
+
+  fir_entry() : refs(0) {}
+};
+
+typedef std::map<fir_key, fir_entry> fir_cache_t;
+
+fir_cache_t fir_cache;
+std::mutex fir_cache_lock;
+
+// Plain sum of the products of the fastest kernel supported by the CPU,
+// shared with reSIDfp. The caller takes care of interpolation and scaling.
+const reSIDfp::convolve_t convolve = reSIDfp::convolveKernels().front().dotProduct;
+
+} // anonymous namespace
+
+
 // ----------------------------------------------------------------------------
 // Constructor.
 // ----------------------------------------------------------------------------
@@ -67,7 +130,38 @@ SID::SID()
 SID::~SID()
 {
   delete[] sample;
-  delete[] fir;
+  release_fir();
+}
+
+
+// ----------------------------------------------------------------------------
+// Release the shared FIR table, freeing it if no other SID is using it.
+// ----------------------------------------------------------------------------
+void SID::release_fir()
+{
+  if (!fir) {
+    return;
+  }
+
+  const fir_key key = { fir_N, fir_RES, fir_beta, fir_f_cycles_per_sample,
+			fir_filter_scale };
+
+  std::lock_guard<std::mutex> lock(fir_cache_lock);
+  fir_cache_t::iterator it = fir_cache.find(key);
+  if (it != fir_cache.end() && --it->second.refs == 0) {
+    fir_cache.erase(it);
+  }
+  fir = 0;
+}
+
+
+// ----------------------------------------------------------------------------
+// Number of FIR tables in the cache.
+// ----------------------------------------------------------------------------
+int SID::shared_firs()
+{
+  std::lock_guard<std::mutex> lock(fir_cache_lock);
+  return fir_cache.size();
 }
 
 
@@ -303,6 +397,27 @@ SID::State::State()
     envelope_state[i] = EnvelopeGenerator::RELEASE;
     hold_zero[i] = true;
     envelope_pipeline[i] = 0;
+
+    msb_rising[i] = false;
+    noise_output[i] = 0;
+    waveform_output[i] = 0;
+  }
+
+  filter_Vhp = 0;
+  filter_Vbp = filter_Vbp_x = filter_Vbp_vc = 0;
+  filter_Vlp = filter_Vlp_x = filter_Vlp_vc = 0;
+  filter_ve = filter_v1 = filter_v2 = filter_v3 = 0;
+
+  extfilt_Vlp = 0;
+  extfilt_Vhp = 0;
+
+  sample_offset = 0;
+  sample_index = 0;
+  sample_prev = 0;
+  sample_now = 0;
+
+  for (i = 0; i < RINGSIZE; i++) {
+    sample[i] = 0;
   }
 }
 
@@ -367,6 +482,36 @@ SID::State SID::read_state()
     state.envelope_state[i] = voice[i].envelope.state;
     state.hold_zero[i] = voice[i].envelope.hold_zero;
     state.envelope_pipeline[i] = voice[i].envelope.envelope_pipeline;
+
+    state.msb_rising[i] = voice[i].wave.msb_rising;
+    state.noise_output[i] = voice[i].wave.noise_output;
+    state.waveform_output[i] = voice[i].wave.waveform_output;
+  }
+
+  state.filter_Vhp = filter.Vhp;
+  state.filter_Vbp = filter.Vbp;
+  state.filter_Vbp_x = filter.Vbp_x;
+  state.filter_Vbp_vc = filter.Vbp_vc;
+  state.filter_Vlp = filter.Vlp;
+  state.filter_Vlp_x = filter.Vlp_x;
+  state.filter_Vlp_vc = filter.Vlp_vc;
+  state.filter_ve = filter.ve;
+  state.filter_v1 = filter.v1;
+  state.filter_v2 = filter.v2;
+  state.filter_v3 = filter.v3;
+
+  state.extfilt_Vlp = extfilt.Vlp;
+  state.extfilt_Vhp = extfilt.Vhp;
+
+  state.sample_offset = sample_offset;
+  state.sample_index = sample_index;
+  state.sample_prev = sample_prev;
+  state.sample_now = sample_now;
+
+  if (sample) {
+    for (i = 0; i < RINGSIZE; i++) {
+      state.sample[i] = sample[i];
+    }
   }
 
   return state;
@@ -382,6 +527,11 @@ void SID::write_state(const State& state)
 
   for (i = 0; i <= 0x18; i++) {
     write(i, state.sid_register[i]);
+    // On the MOS8580 each write would otherwise replace the previous one
+    // in the pipeline, commit it now. The pipeline state is restored below.
+    if (write_pipeline) {
+      write();
+    }
   }
 
   bus_value = state.bus_value;
@@ -406,6 +556,38 @@ void SID::write_state(const State& state)
     voice[i].envelope.state = state.envelope_state[i];
     voice[i].envelope.hold_zero = state.hold_zero[i];
     voice[i].envelope.envelope_pipeline = state.envelope_pipeline[i];
+
+    voice[i].wave.msb_rising = state.msb_rising[i];
+    voice[i].wave.noise_output = state.noise_output[i];
+    voice[i].wave.no_noise_or_noise_output =
+      voice[i].wave.no_noise | voice[i].wave.noise_output;
+    voice[i].wave.waveform_output = state.waveform_output[i];
+  }
+
+  filter.Vhp = state.filter_Vhp;
+  filter.Vbp = state.filter_Vbp;
+  filter.Vbp_x = state.filter_Vbp_x;
+  filter.Vbp_vc = state.filter_Vbp_vc;
+  filter.Vlp = state.filter_Vlp;
+  filter.Vlp_x = state.filter_Vlp_x;
+  filter.Vlp_vc = state.filter_Vlp_vc;
+  filter.ve = state.filter_ve;
+  filter.v1 = state.filter_v1;
+  filter.v2 = state.filter_v2;
+  filter.v3 = state.filter_v3;
+
+  extfilt.Vlp = state.extfilt_Vlp;
+  extfilt.Vhp = state.extfilt_Vhp;
+
+  sample_offset = state.sample_offset;
+  sample_index = state.sample_index & RINGMASK;
+  sample_prev = state.sample_prev;
+  sample_now = state.sample_now;
+
+  if (sample) {
+    for (i = 0; i < RINGSIZE; i++) {
+      sample[i] = sample[i + RINGSIZE] = state.sample[i];
+    }
   }
 }
 
@@ -543,9 +725,8 @@ bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
   if (method != SAMPLE_RESAMPLE && method != SAMPLE_RESAMPLE_FASTMEM)
   {
     delete[] sample;
-    delete[] fir;
+    release_fir();
     sample = 0;
-    fir = 0;
     return true;
   }
 
@@ -602,17 +783,30 @@ bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
   if (fir && fir_RES_new == fir_RES && fir_N_new == fir_N && beta == fir_beta && f_cycles_per_sample == fir_f_cycles_per_sample && fir_filter_scale == filter_scale) {
       return true;
   }
+  release_fir();
+
   fir_RES = fir_RES_new;
   fir_N = fir_N_new;
   fir_beta = beta;
   fir_f_cycles_per_sample = f_cycles_per_sample;
   fir_filter_scale = filter_scale;
 
-  // Allocate memory for FIR tables.
-  delete[] fir;
-  fir = new short[fir_N*fir_RES];
+  // Reuse the FIR tables if another SID has already calculated them.
+  const fir_key key = { fir_N, fir_RES, fir_beta, fir_f_cycles_per_sample,
+			fir_filter_scale };
+  {
+    std::lock_guard<std::mutex> lock(fir_cache_lock);
+    fir_cache_t::iterator it = fir_cache.find(key);
+    if (it != fir_cache.end()) {
+      it->second.refs++;
+      fir = &it->second.fir[0];
+      return true;
+    }
+  }
 
   // Calculate fir_RES FIR tables for linear interpolation.
+  std::vector<short> table(fir_N*fir_RES);
+
   for (int i = 0; i < fir_RES; i++) {
     int fir_offset = i*fir_N + fir_N/2;
     double j_offset = double(i)/fir_RES;
@@ -628,10 +822,22 @@ bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
 	fabs(wt) >= 1e-6 ? sin(wt)/wt : 1;
       double val =
 	(1 << FIR_SHIFT)*filter_scale*f_samples_per_cycle*wc/pi*sincwt*Kaiser;
-      fir[fir_offset + j] = (short)round(val);
+      table[fir_offset + j] = (short)round(val);
     }
   }
 
+  // Publish the tables, unless a SID set up at the same time got there
+  // first. Nothing is referenced until the tables are complete.
+  {
+    std::lock_guard<std::mutex> lock(fir_cache_lock);
+    fir_entry& entry = fir_cache[key];
+    if (entry.fir.empty()) {
+      entry.fir.swap(table);
+    }
+    entry.refs++;
+    fir = &entry.fir[0];
+  }
+
   return true;
 }
 
@@ -919,14 +1125,11 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n,
 
     int fir_offset = sample_offset*fir_RES >> FIXP_SHIFT;
     int fir_offset_rmd = sample_offset*fir_RES & FIXP_MASK;
-    short* fir_start = fir + fir_offset*fir_N;
-    short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
+    const short* fir_start = fir + fir_offset*fir_N;
+    const short* sample_start = sample + sample_index - fir_N - 1 + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v1 = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v1 += sample_start[j]*fir_start[j];
-    }
+    int v1 = convolve(sample_start, fir_start, fir_N);
 
     // Use next FIR table, wrap around to first FIR table using
     // next sample.
@@ -937,10 +1140,7 @@ int SID::clock_resample(cycle_count& delta_t, short* buf, int n,
     fir_start = fir + fir_offset*fir_N;
 
     // Convolution with filter impulse response.
-    int v2 = 0;
-    for (int k = 0; k < fir_N; k++) {
-      v2 += sample_start[k]*fir_start[k];
-    }
+    int v2 = convolve(sample_start, fir_start, fir_N);
 
     // Linear interpolation.
     // fir_offset_rmd is equal for all samples, it can thus be factorized out:
@@ -995,14 +1195,11 @@ int SID::clock_resample_fastmem(cycle_count& delta_t, short* buf, int n,
     sample_offset = next_sample_offset & FIXP_MASK;
 
     int fir_offset = sample_offset*fir_RES >> FIXP_SHIFT;
-    short* fir_start = fir + fir_offset*fir_N;
-    short* sample_start = sample + sample_index - fir_N + RINGSIZE;
+    const short* fir_start = fir + fir_offset*fir_N;
+    const short* sample_start = sample + sample_index - fir_N + RINGSIZE;
 
     // Convolution with filter impulse response.
-    int v = 0;
-    for (int j = 0; j < fir_N; j++) {
-      v += sample_start[j]*fir_start[j];
-    }
+    int v = convolve(sample_start, fir_start, fir_N);
 
     v >>= FIR_SHIFT;
 
@@ -56,6 +56,12 @@ public:
   reg8 read(reg8 offset);
   void write(reg8 offset, reg8 value);
 
+  enum {
+    // Resampling ring buffer size.
+    RINGSIZE = 1 << 14,
+    RINGMASK = RINGSIZE - 1
+  };
+
   // Read/write state.
   class State
   {
@@ -85,6 +91,24 @@ public:
     EnvelopeGenerator::State envelope_state[3];
     bool hold_zero[3];
     cycle_count envelope_pipeline[3];
+
+    bool msb_rising[3];
+    unsigned short noise_output[3];
+    reg12 waveform_output[3];
+
+    int filter_Vhp;
+    int filter_Vbp, filter_Vbp_x, filter_Vbp_vc;
+    int filter_Vlp, filter_Vlp_x, filter_Vlp_vc;
+    int filter_ve, filter_v1, filter_v2, filter_v3;
+
+    int extfilt_Vlp;
+    int extfilt_Vhp;
+
+    cycle_count sample_offset;
+    int sample_index;
+    short sample_prev, sample_now;
+    // Resampling ring buffer.
+    short sample[RINGSIZE];
   };
 
   State read_state();
@@ -105,6 +129,9 @@ public:
   int clock_resample_fastmem(cycle_count& delta_t, short* buf, int n,
 			     int interleave);
   void write();
+  void release_fir();
+  // Number of FIR tables currently shared between the SID instances.
+  static int shared_firs();
 
   chip_model sid_model;
   Voice voice[3];
@@ -135,9 +162,6 @@ public:
     FIR_RES_FASTMEM = 51473,
     FIR_SHIFT = 15,
 
-    RINGSIZE = 1 << 14,
-    RINGMASK = RINGSIZE - 1,
-
     // Fixed point constants (16.16 bits).
     FIXP_SHIFT = 16,
     FIXP_MASK = 0xffff
@@ -159,7 +183,9 @@ public:
   short* sample;
 
   // FIR_RES filter tables (FIR_N*FIR_RES).
-  short* fir;
+  // The tables are shared by all SID instances using the same sampling
+  // parameters, and must not be modified.
+  const short* fir;
 };
 
 
@@ -26,6 +26,7 @@
 #include <new>
 
 #include "residfp-emu.h"
+#include "residfp/TableCache.h"
 
 ReSIDfpBuilder::~ReSIDfpBuilder()
 {   // Remove all SID emulations
@@ -80,3 +81,23 @@ void ReSIDfpBuilder::filter8580Curve(double filterCurve)
 {
     std::for_each(sidobjs.begin(), sidobjs.end(), applyParameter<libsidplayfp::ReSIDfp, double>(&libsidplayfp::ReSIDfp::filter8580Curve, filterCurve));
 }
+
+void ReSIDfpBuilder::idleSkip(bool enable)
+{
+    std::for_each(sidobjs.begin(), sidobjs.end(), applyParameter<libsidplayfp::ReSIDfp, bool>(&libsidplayfp::ReSIDfp::idleSkip, enable));
+}
+
+uint_least64_t ReSIDfpBuilder::idleCycles() const
+{
+    uint_least64_t cycles = 0;
+    for (emuset_t::const_iterator it = sidobjs.begin(); it != sidobjs.end(); ++it)
+    {
+        cycles += static_cast<libsidplayfp::ReSIDfp*>(*it)->idleCycles();
+    }
+    return cycles;
+}
+
+void ReSIDfpBuilder::tableCache(const char *path)
+{
+    reSIDfp::TableCache::setDirectory(path);
+}
@@ -28,6 +28,7 @@
 
 #include "residfp/siddefs-fp.h"
 #include "sidplayfp/siddefs.h"
+#include "Snapshot.h"
 
 #ifdef HAVE_CONFIG_H
 #  include "config.h"
@@ -58,9 +59,10 @@ const char* ReSIDfp::getCredits()
 
 ReSIDfp::ReSIDfp(sidbuilder *builder) :
     sidemu(builder),
-    m_sid(*(new reSIDfp::SID))
+    m_sid(*(new reSIDfp::SID)),
+    m_silent(false)
 {
-    m_buffer = new short[OUTPUTBUFFERSIZE];
+    m_buffer = new float[OUTPUTBUFFERSIZE];
     reset(0);
 }
 
@@ -104,7 +106,18 @@ void ReSIDfp::clock()
 {
     const event_clock_t cycles = eventScheduler->getTime(m_accessClk, EVENT_CLOCK_PHI1);
     m_accessClk += cycles;
-    m_bufferpos += m_sid.clock(cycles, m_buffer+m_bufferpos);
+
+    if (m_silent)
+        m_sid.clockSilent(cycles);
+    else
+        m_bufferpos += m_sid.clock(cycles, m_buffer+m_bufferpos);
+}
+
+bool ReSIDfp::chipSnapshot(Snapshot &s)
+{
+    m_sid.snapshot(s);
+
+    return true;
 }
 
 void ReSIDfp::filter(bool enable)
@@ -113,7 +126,7 @@ void ReSIDfp::filter(bool enable)
 }
 
 void ReSIDfp::sampling(float systemclock, float freq,
-        SidConfig::sampling_method_t method, bool)
+        SidConfig::sampling_method_t method, bool fast)
 {
     reSIDfp::SamplingMethod sampleMethod;
     switch (method)
@@ -134,7 +147,7 @@ void ReSIDfp::sampling(float systemclock, float freq,
     {
         // Round half frequency to the nearest multiple of 5000
         const int halfFreq = 5000*((static_cast<int>(freq)+5000)/10000);
-        m_sid.setSamplingParameters(systemclock, sampleMethod, freq, std::min(halfFreq, 20000));
+        m_sid.setSamplingParameters(systemclock, sampleMethod, freq, std::min(halfFreq, 20000), fast);
     }
     catch (reSIDfp::SIDError const &)
     {
@@ -43,6 +43,11 @@ class ReSIDfp final : public sidemu
 private:
     reSIDfp::SID &m_sid;
 
+    bool m_silent;
+
+protected:
+    bool chipSnapshot(Snapshot &s) override;
+
 public:
     static const char* getCredits();
 
@@ -62,7 +67,9 @@ public:
     void clock() override;
 
     void sampling(float systemclock, float freq,
-        SidConfig::sampling_method_t method, bool) override;
+        SidConfig::sampling_method_t method, bool fast) override;
+
+    void silent(bool enable) override { m_silent = enable; }
 
     void voice(unsigned int num, bool mute) override { m_sid.mute(num, mute); }
 
@@ -72,6 +79,12 @@ public:
     void filter(bool enable);
     void filter6581Curve(double filterCurve);
     void filter8580Curve(double filterCurve);
+    void idleSkip(bool enable) { m_sid.enableIdleSkip(enable); }
+
+    /**
+     * Get the number of cycles spent in the idle fast path.
+     */
+    uint64_t idleCycles() const { return m_sid.getIdleCycles(); }
 };
 
 }
@@ -73,7 +73,39 @@ public:
      * @param filterCurve curve center frequency (default 12500)
      */
     void filter8580Curve(double filterCurve);
+
+    /**
+     * Set the directory for the on-disk cache of the filter
+     * and resampler tables, which are otherwise computed
+     * the first time they are needed in each process.
+     * Tables found there are loaded, missing or stale ones
+     * are computed and stored.
+     * Call before creating the emulation to cut the startup time.
+     *
+     * @param path the cache directory, NULL to disable the cache (default)
+     */
+    static void tableCache(const char *path);
     //@}
+
+    /**
+     * Skip the filters while the output is idle, off by default.
+     * When all the envelopes are frozen at zero and the output has
+     * stayed within 1 unit for 100000 cycles, the filters are not
+     * clocked until the next register write.
+     * This is lossy, the output may be off by 1 unit and a slow
+     * decay of the filters output is cut short.
+     *
+     * @param enable true to enable the idle fast path
+     */
+    void idleSkip(bool enable);
+
+    /**
+     * Get the number of cycles the SIDs have spent in the idle fast path,
+     * summed over all the SIDs.
+     *
+     * @return the number of idle cycles since the SIDs were created
+     */
+    uint_least64_t idleCycles() const;
 };
 
 #endif // RESIDFP_H
@@ -0,0 +1,117 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef DECIMATOR_H
+#define DECIMATOR_H
+
+#include "Snapshot.h"
+
+namespace reSIDfp
+{
+
+/**
+ * Second order CIC decimator for the voice outputs.
+ *
+ * Used by the fast sampling mode, where the filter runs once
+ * every 2^shift cycles. The voice output is averaged with
+ * triangular weights over two decimation periods, which puts
+ * a double zero on every multiple of the reduced rate and keeps
+ * the components aliasing into the audio band below ~ -40 dB.
+ *
+ * The state uses wrap-around arithmetic, as usual for CIC filters.
+ */
+class Decimator
+{
+private:
+    unsigned int integrator1;
+    unsigned int integrator2;
+    unsigned int comb1;
+    unsigned int comb2;
+
+    /// log2 of the decimation factor
+    unsigned int shift;
+
+public:
+    Decimator() :
+        integrator1(0),
+        integrator2(0),
+        comb1(0),
+        comb2(0),
+        shift(0) {}
+
+    /**
+     * Set the decimation factor.
+     *
+     * @param factor log2 of the decimation factor
+     */
+    void setShift(unsigned int factor)
+    {
+        shift = factor;
+        reset();
+    }
+
+    /**
+     * Feed one cycle worth of voice output.
+     *
+     * @param value the voice output
+     */
+    void input(int value)
+    {
+        integrator1 += static_cast<unsigned int>(value);
+        integrator2 += integrator1;
+    }
+
+    /**
+     * Get the decimated output, to be called every 2^shift cycles.
+     *
+     * @return the averaged voice output
+     */
+    int output()
+    {
+        const unsigned int c1 = integrator2 - comb1;
+        comb1 = integrator2;
+        const unsigned int c2 = c1 - comb2;
+        comb2 = c1;
+        return static_cast<int>(c2) >> (shift * 2);
+    }
+
+    /**
+     * Reset the filter state.
+     */
+    void reset()
+    {
+        integrator1 = 0;
+        integrator2 = 0;
+        comb1 = 0;
+        comb2 = 0;
+    }
+
+    void snapshot(libsidplayfp::Snapshot &s)
+    {
+        s.value(integrator1);
+        s.value(integrator2);
+        s.value(comb1);
+        s.value(comb2);
+    }
+};
+
+} // namespace reSIDfp
+
+#endif
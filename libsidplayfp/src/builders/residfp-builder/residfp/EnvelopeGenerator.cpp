@@ -24,13 +24,46 @@
 
 #include "EnvelopeGenerator.h"
 
+#include <mutex>
+
 #include "Dac.h"
+#include "Snapshot.h"
 
 namespace reSIDfp
 {
 
 const unsigned int DAC_BITS = 8;
 
+/**
+ * The rate LFSR sequence starting from the reset value 0x7fff,
+ * and the position of each value in the sequence.
+ * The LFSR has maximal length so every nonzero value is there.
+ */
+class LfsrTables
+{
+public:
+    unsigned short sequence[0x7fff];
+    unsigned short position[0x8000];
+
+public:
+    LfsrTables()
+    {
+        unsigned int lfsr = 0x7fff;
+        position[0] = 0;
+
+        for (unsigned int i = 0; i < 0x7fff; i++)
+        {
+            sequence[i] = lfsr;
+            position[lfsr] = i;
+
+            const unsigned int feedback = ((lfsr << 14) ^ (lfsr << 13)) & 0x4000;
+            lfsr = (lfsr >> 1) | feedback;
+        }
+    }
+};
+
+static const LfsrTables lfsrTables;
+
 const unsigned int EnvelopeGenerator::adsrtable[16] =
 {
     0x007f,
@@ -96,15 +129,60 @@ void EnvelopeGenerator::set_exponential_counter()
     }
 }
 
+void EnvelopeGenerator::clock(unsigned int cycles)
+{
+    while (cycles != 0)
+    {
+        // A pending decrement is handled at the start of the cycle
+        if (unlikely(envelope_pipeline))
+        {
+            --envelope_counter;
+            envelope_pipeline = false;
+            set_exponential_counter();
+        }
+
+        // Cycles spent stepping the LFSR before it matches the rate
+        const unsigned int pos = lfsrTables.position[lfsr];
+        const unsigned int target = lfsrTables.position[rate];
+        const unsigned int distance = target >= pos ? target - pos : target + LFSR_PERIOD - pos;
+
+        if (distance >= cycles)
+        {
+            lfsr = lfsrTables.sequence[(pos + cycles) % LFSR_PERIOD];
+            return;
+        }
+
+        // Run the matching cycle as usual
+        lfsr = rate;
+        cycles -= distance + 1;
+        clock();
+    }
+}
+
+static std::mutex g_EnvelopeDac_mutex;
+static float g_EnvelopeDac[2][1 << DAC_BITS];
+static bool g_EnvelopeDacReady[2] = { false, false };
+
 void EnvelopeGenerator::setChipModel(ChipModel chipModel)
 {
-    Dac dacBuilder(DAC_BITS);
-    dacBuilder.kinkedDac(chipModel);
+    const int index = chipModel == MOS6581 ? 0 : 1;
+
+    std::lock_guard<std::mutex> guard(g_EnvelopeDac_mutex);
 
-    for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
+    if (!g_EnvelopeDacReady[index])
     {
-        dac[i] = static_cast<float>(dacBuilder.getOutput(i));
+        Dac dacBuilder(DAC_BITS);
+        dacBuilder.kinkedDac(chipModel);
+
+        for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
+        {
+            g_EnvelopeDac[index][i] = static_cast<float>(dacBuilder.getOutput(i));
+        }
+
+        g_EnvelopeDacReady[index] = true;
     }
+
+    dac = g_EnvelopeDac[index];
 }
 
 void EnvelopeGenerator::reset()
@@ -128,6 +206,23 @@ void EnvelopeGenerator::reset()
     hold_zero = true;
 }
 
+void EnvelopeGenerator::snapshot(libsidplayfp::Snapshot &s)
+{
+    s.value(lfsr);
+    s.value(rate);
+    s.value(exponential_counter);
+    s.value(exponential_counter_period);
+    s.value(state);
+    s.value(hold_zero);
+    s.value(envelope_pipeline);
+    s.value(gate);
+    s.value(envelope_counter);
+    s.value(attack);
+    s.value(decay);
+    s.value(sustain);
+    s.value(release);
+}
+
 void EnvelopeGenerator::writeCONTROL_REG(unsigned char control)
 {
     const bool gate_next = (control & 0x01) != 0;
@@ -25,6 +25,11 @@
 
 #include "siddefs-fp.h"
 
+namespace libsidplayfp
+{
+class Snapshot;
+}
+
 namespace reSIDfp
 {
 
@@ -97,11 +102,12 @@ private:
     unsigned char release;
 
     /**
-     * Emulated nonlinearity of the envelope DAC.
+     * Emulated nonlinearity of the envelope DAC,
+     * shared by all the generators of the same chip model.
      *
      * @See SID.kinked_dac
      */
-    float dac[256];
+    const float* dac;
 
 private:
     /**
@@ -117,6 +123,9 @@ private:
      */
     static const unsigned int adsrtable[16];
 
+    /// Period of the rate LFSR
+    static const unsigned int LFSR_PERIOD = 0x7fff;
+
 private:
     void set_exponential_counter();
 
@@ -135,6 +144,16 @@ public:
      */
     void clock();
 
+    /**
+     * Clock the envelope for the given number of cycles.
+     * The rate LFSR jumps straight to the next match instead of
+     * being stepped every cycle, so it is much faster than calling
+     * clock() repeatedly while giving exactly the same results.
+     *
+     * @param cycles the number of cycles
+     */
+    void clock(unsigned int cycles);
+
     /**
      * Get the Envelope Generator output.
      * DAC imperfections are emulated by using envelope_counter as an index
@@ -158,13 +177,19 @@ public:
         attack(0),
         decay(0),
         sustain(0),
-        release(0) {}
+        release(0),
+        dac(nullptr) {}
 
     /**
      * SID reset.
      */
     void reset();
 
+    /**
+     * Save or restore the envelope state.
+     */
+    void snapshot(libsidplayfp::Snapshot &s);
+
     /**
      * Write control register.
      *
@@ -195,6 +220,12 @@ public:
      * @return envelope counter
      */
     unsigned char readENV() const { return envelope_counter; }
+
+    /**
+     * Check whether the envelope counter is frozen at zero.
+     * Only a register write can release it.
+     */
+    bool isFrozen() const { return hold_zero; }
 };
 
 } // namespace reSIDfp
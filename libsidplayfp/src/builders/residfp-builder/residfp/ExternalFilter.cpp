@@ -24,6 +24,8 @@
 
 #include "ExternalFilter.h"
 
+#include "Snapshot.h"
+
 namespace reSIDfp
 {
 
@@ -63,4 +65,10 @@ void ExternalFilter::reset()
     Vhp = 0;
 }
 
+void ExternalFilter::snapshot(libsidplayfp::Snapshot &s)
+{
+    s.value(Vlp);
+    s.value(Vhp);
+}
+
 } // namespace reSIDfp
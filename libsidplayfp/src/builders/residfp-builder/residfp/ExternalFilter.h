@@ -25,6 +25,11 @@
 
 #include "siddefs-fp.h"
 
+namespace libsidplayfp
+{
+class Snapshot;
+}
+
 namespace reSIDfp
 {
 
@@ -82,6 +87,11 @@ public:
      * SID reset.
      */
     void reset();
+
+    /**
+     * Save or restore the filter state.
+     */
+    void snapshot(libsidplayfp::Snapshot &s);
 };
 
 } // namespace reSIDfp
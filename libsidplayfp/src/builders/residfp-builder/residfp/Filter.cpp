@@ -22,6 +22,8 @@
 
 #include "Filter.h"
 
+#include "Snapshot.h"
+
 namespace reSIDfp
 {
 
@@ -47,6 +49,27 @@ void Filter::reset()
     writeRES_FILT(0);
 }
 
+void Filter::snapshot(libsidplayfp::Snapshot &s)
+{
+    unsigned char modeVol = vol
+        | (lp ? 0x10 : 0)
+        | (bp ? 0x20 : 0)
+        | (hp ? 0x40 : 0)
+        | (voice3off ? 0x80 : 0);
+
+    s.value(fc);
+    s.value(filt);
+    s.value(modeVol);
+
+    if (s.loading())
+    {
+        fc &= 0x7ff;
+        updatedCenterFrequency();
+        writeRES_FILT(filt);
+        writeMODE_VOL(modeVol);
+    }
+}
+
 void Filter::writeFC_LO(unsigned char fc_lo)
 {
     fc = (fc & 0x7f8) | (fc_lo & 0x007);
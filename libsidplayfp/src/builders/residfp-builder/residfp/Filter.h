@@ -23,6 +23,11 @@
 #ifndef FILTER_H
 #define FILTER_H
 
+namespace libsidplayfp
+{
+class Snapshot;
+}
+
 namespace reSIDfp
 {
 
@@ -97,6 +102,13 @@ public:
      */
     virtual int clock(int v1, int v2, int v3) = 0;
 
+    /**
+     * Set the time step of each clock() call.
+     *
+     * @param shift log2 of the number of cycles advanced by each clock
+     */
+    virtual void setClockShift(unsigned int shift) = 0;
+
     /**
      * Enable filter.
      *
@@ -109,6 +121,12 @@ public:
      */
     void reset();
 
+    /**
+     * Save or restore the filter state.
+     * The base class restores the registers.
+     */
+    virtual void snapshot(libsidplayfp::Snapshot &s);
+
     /**
      * Write Frequency Cutoff Low register.
      *
@@ -25,14 +25,12 @@
 #include "Filter6581.h"
 
 #include "Integrator.h"
+#include "Snapshot.h"
 
 namespace reSIDfp
 {
 
-Filter6581::~Filter6581()
-{
-    delete [] f0_dac;
-}
+Filter6581::~Filter6581() {}
 
 void Filter6581::updatedCenterFrequency()
 {
@@ -41,6 +39,12 @@ void Filter6581::updatedCenterFrequency()
     bpIntegrator->setVw(Vw);
 }
 
+void Filter6581::setClockShift(unsigned int shift)
+{
+    hpIntegrator->setTimeStep(1 << shift);
+    bpIntegrator->setTimeStep(1 << shift);
+}
+
 void Filter6581::updatedMixing()
 {
     currentGain = gain[vol];
@@ -65,9 +69,19 @@ void Filter6581::updatedMixing()
     currentMixer = mixer[no];
 }
 
+void Filter6581::snapshot(libsidplayfp::Snapshot &s)
+{
+    Filter::snapshot(s);
+    s.value(Vhp);
+    s.value(Vbp);
+    s.value(Vlp);
+    s.value(ve);
+    hpIntegrator->snapshot(s);
+    bpIntegrator->snapshot(s);
+}
+
 void Filter6581::setFilterCurve(double curvePosition)
 {
-    delete [] f0_dac;
     f0_dac = FilterModelConfig::getInstance()->getDAC(curvePosition);
     updatedCenterFrequency();
 }
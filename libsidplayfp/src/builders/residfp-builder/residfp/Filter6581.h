@@ -334,6 +334,7 @@ private:
     /// Filter resonance value.
     unsigned short* currentResonance;
 
+    /// Cutoff frequency DAC table, owned by FilterModelConfig.
     const unsigned short* f0_dac;
 
     unsigned short** mixer;
@@ -387,6 +388,8 @@ public:
 
     int clock(int voice1, int voice2, int voice3) override;
 
+    void setClockShift(unsigned int shift) override;
+
     void input(int sample) override { ve = (sample * voiceScaleS14 * 3 >> 10) + mixer[0][0]; }
 
     /**
@@ -410,6 +413,8 @@ public:
      * @param curvePosition 0 .. 1, where 0 sets center frequency high ("light") and 1 sets it low ("dark"), default is 0.5
      */
     void setFilterCurve(double curvePosition);
+
+    void snapshot(libsidplayfp::Snapshot &s) override;
 };
 
 } // namespace reSIDfp
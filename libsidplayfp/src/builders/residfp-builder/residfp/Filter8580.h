@@ -31,6 +31,7 @@
 #include "siddefs-fp.h"
 
 #include "Filter.h"
+#include "Snapshot.h"
 
 #include "sidcxx11.h"
 
@@ -78,6 +79,8 @@ public:
 
         return reduce(rand_state);
     }
+
+    void snapshot(libsidplayfp::Snapshot &s) { s.value(rand_state); }
 };
 
 /**
@@ -101,6 +104,17 @@ private:
 
     float w0;
 
+    /// Number of cycles advanced by each clock
+    float timeStep;
+
+    /**
+     * Damping correction for time steps longer than one cycle.
+     *
+     * The damping of this filter topology decreases by about w0,
+     * so with longer steps the resonance would be too strong.
+     */
+    float dampingComp;
+
     /// Resonance parameter
     float _1_div_Q;
 
@@ -116,15 +130,27 @@ public:
         Vbp(0.f),
         Vhp(0.f),
         w0(0.f),
+        timeStep(1.f),
+        dampingComp(0.f),
         _1_div_Q(0.f),
         ve(0) {}
 
     int clock(int voice1, int voice2, int voice3) override;
 
+    void setClockShift(unsigned int shift) override
+    {
+        timeStep = static_cast<float>(1 << shift);
+        updatedCenterFrequency();
+    }
+
     /**
      * Set filter cutoff frequency.
      */
-    void updatedCenterFrequency() override { w0 = static_cast<float>(2. * M_PI * highFreq * fc / 2047. / 1e6); }
+    void updatedCenterFrequency() override
+    {
+        w0 = static_cast<float>(2. * M_PI * highFreq * fc / 2047. / 1e6) * timeStep;
+        dampingComp = w0 - w0 / timeStep;
+    }
 
     /**
      * Set filter resonance.
@@ -147,6 +173,16 @@ public:
      * @param curvePosition filter's center frequency expressed in Hertz, default is 12500
      */
     void setFilterCurve(double curvePosition) { highFreq = curvePosition; }
+
+    void snapshot(libsidplayfp::Snapshot &s) override
+    {
+        Filter::snapshot(s);
+        s.value(Vlp);
+        s.value(Vbp);
+        s.value(Vhp);
+        s.value(ve);
+        noise.snapshot(s);
+    }
 };
 
 } // namespace reSIDfp
@@ -176,7 +212,7 @@ int Filter8580::clock(int voice1, int voice2, int voice3)
 
     Vlp -= w0 * Vbp;
     Vbp -= w0 * Vhp;
-    Vhp = (Vbp * _1_div_Q) - Vlp - static_cast<float>(Vi >> 7) + noise.get();
+    Vhp = (Vbp * (_1_div_Q + dampingComp)) - Vlp - static_cast<float>(Vi >> 7) + noise.get();
 
     assert(std::fpclassify(Vlp) != FP_SUBNORMAL);
     assert(std::fpclassify(Vbp) != FP_SUBNORMAL);
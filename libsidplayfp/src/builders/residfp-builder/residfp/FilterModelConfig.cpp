@@ -28,6 +28,7 @@
 
 #include "Integrator.h"
 #include "OpAmp.h"
+#include "TableCache.h"
 
 namespace reSIDfp
 {
@@ -47,6 +48,9 @@ inline double log1p(double x)
 
 const unsigned int OPAMP_SIZE = 33;
 
+/// Bump when the table computation changes, to invalidate cached tables.
+const unsigned int TABLES_VERSION = 1;
+
 /**
  * This is the SID 6581 op-amp voltage transfer function, measured on
  * CAP1B/CAP1A on a chip marked MOS 6581R4AR 0687 14.
@@ -127,6 +131,64 @@ FilterModelConfig::FilterModelConfig() :
 {
     dac.kinkedDac(MOS6581);
 
+    for (int i = 0; i < 5; i++)
+    {
+        summer[i] = new unsigned short[(2 + i) << 16];
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        mixer[i] = new unsigned short[(i == 0) ? 1 : i << 16];
+    }
+
+    for (int i = 0; i < 16; i++)
+    {
+        gain[i] = new unsigned short[1 << 16];
+    }
+
+    // The tables depend only on the model parameters,
+    // try the on-disk cache before computing them.
+    TableCache::chunks_t chunks;
+    for (int i = 0; i < 5; i++)
+    {
+        const TableCache::chunk_t chunk = { summer[i], ((2 + i) << 16) * sizeof(unsigned short) };
+        chunks.push_back(chunk);
+    }
+    for (int i = 0; i < 8; i++)
+    {
+        const TableCache::chunk_t chunk = { mixer[i], ((i == 0) ? 1 : i << 16) * sizeof(unsigned short) };
+        chunks.push_back(chunk);
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        const TableCache::chunk_t chunk = { gain[i], (1 << 16) * sizeof(unsigned short) };
+        chunks.push_back(chunk);
+    }
+    const TableCache::chunk_t vcr_kVg_chunk = { vcr_kVg, sizeof(vcr_kVg) };
+    chunks.push_back(vcr_kVg_chunk);
+    const TableCache::chunk_t vcr_n_Ids_term_chunk = { vcr_n_Ids_term, sizeof(vcr_n_Ids_term) };
+    chunks.push_back(vcr_n_Ids_term_chunk);
+    const TableCache::chunk_t opamp_rev_chunk = { opamp_rev, sizeof(opamp_rev) };
+    chunks.push_back(opamp_rev_chunk);
+
+    const double parameters[] =
+    {
+        voice_voltage_range, voice_DC_voltage, C, Vdd, Vth, Ut, k,
+        uCox, WL_vcr, WL_snake, kVddt, dac_zero, dac_scale, vmin, vmax, N16
+    };
+    uint64_t key = TableCache::hash(&TABLES_VERSION, sizeof(TABLES_VERSION));
+    key = TableCache::hash(parameters, sizeof(parameters), key);
+    key = TableCache::hash(opamp_voltage, sizeof(opamp_voltage), key);
+
+    if (!TableCache::load("filter6581", key, chunks))
+    {
+        buildTables();
+        TableCache::save("filter6581", key, chunks);
+    }
+}
+
+void FilterModelConfig::buildTables()
+{
     // Convert op-amp voltage transfer to 16 bit values.
 
     Spline::Point scaled_voltage[OPAMP_SIZE];
@@ -167,7 +229,6 @@ FilterModelConfig::FilterModelConfig() :
         const int size = idiv << 16;
         const double n = idiv;
         opampModel.reset();
-        summer[i] = new unsigned short[size];
 
         for (int vi = 0; vi < size; vi++)
         {
@@ -189,7 +250,6 @@ FilterModelConfig::FilterModelConfig() :
         const int size = (i == 0) ? 1 : i << 16;
         const double n = i * 8.0 / 6.0;
         opampModel.reset();
-        mixer[i] = new unsigned short[size];
 
         for (int vi = 0; vi < size; vi++)
         {
@@ -210,7 +270,6 @@ FilterModelConfig::FilterModelConfig() :
         const int size = 1 << 16;
         const double n = n8 / 8.0;
         opampModel.reset();
-        gain[n8] = new unsigned short[size];
 
         for (int vi = 0; vi < size; vi++)
         {
@@ -285,11 +344,22 @@ FilterModelConfig::~FilterModelConfig()
     }
 }
 
-unsigned short* FilterModelConfig::getDAC(double adjustment) const
+const unsigned short* FilterModelConfig::getDAC(double adjustment)
 {
-    const double dac_zero = getDacZero(adjustment);
+    const int key = static_cast<int>(adjustment * DAC_CURVE_STEPS + 0.5);
+
+    std::lock_guard<std::mutex> guard(dacCacheLock);
+
+    dac_cache_t::iterator lb = dacCache.lower_bound(key);
+
+    if (lb != dacCache.end() && !(dacCache.key_comp()(key, lb->first)))
+    {
+        return &(lb->second[0]);
+    }
+
+    const double dac_zero = getDacZero(static_cast<double>(key) / DAC_CURVE_STEPS);
 
-    unsigned short* f0_dac = new unsigned short[1 << DAC_BITS];
+    std::vector<unsigned short> f0_dac(1 << DAC_BITS);
 
     for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
     {
@@ -299,7 +369,9 @@ unsigned short* FilterModelConfig::getDAC(double adjustment) const
         f0_dac[i] = static_cast<unsigned short>(tmp + 0.5);
     }
 
-    return f0_dac;
+    lb = dacCache.insert(lb, dac_cache_t::value_type(key, std::vector<unsigned short>()));
+    lb->second.swap(f0_dac);
+    return &(lb->second[0]);
 }
 
 std::unique_ptr<Integrator> FilterModelConfig::buildIntegrator()
@@ -23,7 +23,10 @@
 #ifndef FILTERMODELCONFIG_H
 #define FILTERMODELCONFIG_H
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "Dac.h"
 #include "Spline.h"
@@ -43,6 +46,11 @@ class FilterModelConfig
 private:
     static const unsigned int DAC_BITS = 11;
 
+    /// Resolution of the curve position used as key for the DAC tables cache.
+    static const int DAC_CURVE_STEPS = 1 << 12;
+
+    typedef std::map<int, std::vector<unsigned short> > dac_cache_t;
+
 private:
     static std::unique_ptr<FilterModelConfig> instance;
     // This allows access to the private constructor
@@ -102,12 +110,23 @@ private:
     /// Reverse op-amp transfer function.
     unsigned short opamp_rev[1 << 16];
 
+    /// Cutoff frequency DAC tables, keyed by quantized curve position.
+    //@{
+    std::mutex dacCacheLock;
+    dac_cache_t dacCache;
+    //@}
+
 private:
     double getDacZero(double adjustment) const { return dac_zero - (adjustment - 0.5) * 2.; }
 
     FilterModelConfig();
     ~FilterModelConfig();
 
+    /**
+     * Compute the op-amp and VCR lookup tables.
+     */
+    void buildTables();
+
 public:
     static FilterModelConfig* getInstance();
 
@@ -129,14 +148,16 @@ public:
     unsigned short** getMixer() { return mixer; }
 
     /**
-     * Construct an 11 bit cutoff frequency DAC output voltage table.
-     * Ownership is transferred to the requester which becomes responsible
-     * of freeing the object when done.
+     * Get an 11 bit cutoff frequency DAC output voltage table.
+     * Tables are built on first request and shared between all the filters
+     * using the same curve position, which is quantized to
+     * 1/DAC_CURVE_STEPS. They are owned by this class and stay valid
+     * for the whole program lifetime.
      *
-     * @param adjustment
+     * @param adjustment the curve position, from 0 to 1
      * @return the DAC table
      */
-    unsigned short* getDAC(double adjustment) const;
+    const unsigned short* getDAC(double adjustment);
 
     /**
      * Construct an integrator solver.
@@ -27,6 +27,7 @@
 #include <cassert>
 
 #include "siddefs-fp.h"
+#include "Snapshot.h"
 
 namespace reSIDfp
 {
@@ -161,6 +162,9 @@ private:
     int vx;
     int vc;
 
+    /// Number of cycles advanced by each solve
+    int timeStep;
+
     const unsigned short kVddt;
     const unsigned short n_snake;
 
@@ -173,11 +177,30 @@ public:
         Vddt_Vw_2(0),
         vx(0),
         vc(0),
+        timeStep(1),
         kVddt(kVddt),
         n_snake(n_snake) {}
 
     void setVw(unsigned short Vw) { Vddt_Vw_2 = (kVddt - Vw) * (kVddt - Vw) >> 1; }
 
+    /**
+     * Set the number of cycles advanced by each solve.
+     * Larger steps trade accuracy for speed.
+     *
+     * @param cycles the time step in cycles
+     */
+    void setTimeStep(int cycles) { timeStep = cycles; }
+
+    /**
+     * Save or restore the integrator state,
+     * the gate voltage is set from the cutoff.
+     */
+    void snapshot(libsidplayfp::Snapshot &s)
+    {
+        s.value(vx);
+        s.value(vc);
+    }
+
     int solve(int vi);
 };
 
@@ -216,8 +239,11 @@ int Integrator::solve(int vi)
     // VCR current, scaled by m*2^15*2^15 = m*2^30
     const int n_I_vcr = static_cast<int>(vcr_n_Ids_term[Vgs] - vcr_n_Ids_term[Vgd]) << 15;
 
-    // Change in capacitor charge.
-    vc += n_I_snake + n_I_vcr;
+    // Change in capacitor charge, in 64 bits as the longer
+    // time step of the fast sampling mode could overflow.
+    // Keep vc within the range of the op-amp table.
+    const int_least64_t nvc = vc + static_cast<int_least64_t>(n_I_snake + n_I_vcr) * timeStep;
+    vc = nvc < -(1 << 30) ? -(1 << 30) : nvc > (1 << 30) - 1 ? (1 << 30) - 1 : static_cast<int>(nvc);
 
     // vx = g(vc)
     const int tmp = (vc >> 15) + (1 << 15);
@@ -34,6 +34,8 @@
 #include "resample/TwoPassSincResampler.h"
 #include "resample/ZeroOrderResampler.h"
 
+#include "Snapshot.h"
+
 namespace reSIDfp
 {
 
@@ -59,18 +61,26 @@ int constexpr BUS_TTL_6581 = 0x01d00;
 int constexpr BUS_TTL_8580 = 0xa2000;
 //@}
 
+/**
+ * Maximum log2 of the decimation factor used by the fast sampling mode.
+ * Larger steps make the filter integrators inaccurate.
+ */
+unsigned int constexpr MAX_CLOCK_SHIFT = 3;
+
 SID::SID() :
     filter6581(new Filter6581()),
     filter8580(new Filter8580()),
     externalFilter(new ExternalFilter()),
     resampler(nullptr),
     potX(new Potentiometer()),
-    potY(new Potentiometer())
+    potY(new Potentiometer()),
+    clockShift(0),
+    idleOutput(0),
+    idleCount(0),
+    idleCycles(0),
+    idle(false),
+    idleSkip(false)
 {
-    voice[0].reset(new Voice());
-    voice[1].reset(new Voice());
-    voice[2].reset(new Voice());
-
     muted[0] = muted[1] = muted[2] = false;
 
     reset();
@@ -85,105 +95,110 @@ SID::~SID()
 void SID::setFilter6581Curve(double filterCurve)
 {
     filter6581->setFilterCurve(filterCurve);
+    wakeUp();
 }
 
 void SID::setFilter8580Curve(double filterCurve)
 {
     filter8580->setFilterCurve(filterCurve);
+    wakeUp();
 }
 
 void SID::enableFilter(bool enable)
 {
     filter6581->enable(enable);
     filter8580->enable(enable);
+    wakeUp();
 }
 
 void SID::writeImmediate(int offset, unsigned char value)
 {
+    wakeUp();
+
     switch (offset)
     {
     case 0x00: // Voice #1 frequency (Low-byte)
-        voice[0]->wave()->writeFREQ_LO(value);
+        voice[0].wave()->writeFREQ_LO(value);
         break;
 
     case 0x01: // Voice #1 frequency (High-byte)
-        voice[0]->wave()->writeFREQ_HI(value);
+        voice[0].wave()->writeFREQ_HI(value);
         break;
 
     case 0x02: // Voice #1 pulse width (Low-byte)
-        voice[0]->wave()->writePW_LO(value);
+        voice[0].wave()->writePW_LO(value);
         break;
 
     case 0x03: // Voice #1 pulse width (bits #8-#15)
-        voice[0]->wave()->writePW_HI(value);
+        voice[0].wave()->writePW_HI(value);
         break;
 
     case 0x04: // Voice #1 control register
-        voice[0]->writeCONTROL_REG(muted[0] ? 0 : value);
+        voice[0].writeCONTROL_REG(muted[0] ? 0 : value);
         break;
 
     case 0x05: // Voice #1 Attack and Decay length
-        voice[0]->envelope()->writeATTACK_DECAY(value);
+        voice[0].envelope()->writeATTACK_DECAY(value);
         break;
 
     case 0x06: // Voice #1 Sustain volume and Release length
-        voice[0]->envelope()->writeSUSTAIN_RELEASE(value);
+        voice[0].envelope()->writeSUSTAIN_RELEASE(value);
         break;
 
     case 0x07: // Voice #2 frequency (Low-byte)
-        voice[1]->wave()->writeFREQ_LO(value);
+        voice[1].wave()->writeFREQ_LO(value);
         break;
 
     case 0x08: // Voice #2 frequency (High-byte)
-        voice[1]->wave()->writeFREQ_HI(value);
+        voice[1].wave()->writeFREQ_HI(value);
         break;
 
     case 0x09: // Voice #2 pulse width (Low-byte)
-        voice[1]->wave()->writePW_LO(value);
+        voice[1].wave()->writePW_LO(value);
         break;
 
     case 0x0a: // Voice #2 pulse width (bits #8-#15)
-        voice[1]->wave()->writePW_HI(value);
+        voice[1].wave()->writePW_HI(value);
         break;
 
     case 0x0b: // Voice #2 control register
-        voice[1]->writeCONTROL_REG(muted[1] ? 0 : value);
+        voice[1].writeCONTROL_REG(muted[1] ? 0 : value);
         break;
 
     case 0x0c: // Voice #2 Attack and Decay length
-        voice[1]->envelope()->writeATTACK_DECAY(value);
+        voice[1].envelope()->writeATTACK_DECAY(value);
         break;
 
     case 0x0d: // Voice #2 Sustain volume and Release length
-        voice[1]->envelope()->writeSUSTAIN_RELEASE(value);
+        voice[1].envelope()->writeSUSTAIN_RELEASE(value);
         break;
 
     case 0x0e: // Voice #3 frequency (Low-byte)
-        voice[2]->wave()->writeFREQ_LO(value);
+        voice[2].wave()->writeFREQ_LO(value);
         break;
 
     case 0x0f: // Voice #3 frequency (High-byte)
-        voice[2]->wave()->writeFREQ_HI(value);
+        voice[2].wave()->writeFREQ_HI(value);
         break;
 
     case 0x10: // Voice #3 pulse width (Low-byte)
-        voice[2]->wave()->writePW_LO(value);
+        voice[2].wave()->writePW_LO(value);
         break;
 
     case 0x11: // Voice #3 pulse width (bits #8-#15)
-        voice[2]->wave()->writePW_HI(value);
+        voice[2].wave()->writePW_HI(value);
         break;
 
     case 0x12: // Voice #3 control register
-        voice[2]->writeCONTROL_REG(muted[2] ? 0 : value);
+        voice[2].writeCONTROL_REG(muted[2] ? 0 : value);
         break;
 
     case 0x13: // Voice #3 Attack and Decay length
-        voice[2]->envelope()->writeATTACK_DECAY(value);
+        voice[2].envelope()->writeATTACK_DECAY(value);
         break;
 
     case 0x14: // Voice #3 Sustain volume and Release length
-        voice[2]->envelope()->writeSUSTAIN_RELEASE(value);
+        voice[2].envelope()->writeSUSTAIN_RELEASE(value);
         break;
 
     case 0x15: // Filter cut off frequency (bits #0-#2)
@@ -221,7 +236,7 @@ void SID::voiceSync(bool sync)
         // Synchronize the 3 waveform generators.
         for (int i = 0; i < 3; i++)
         {
-            voice[i]->wave()->synchronize(voice[(i + 1) % 3]->wave(), voice[(i + 2) % 3]->wave());
+            voice[i].wave()->synchronize(voice[(i + 1) % 3].wave(), voice[(i + 2) % 3].wave());
         }
     }
 
@@ -230,14 +245,14 @@ void SID::voiceSync(bool sync)
 
     for (int i = 0; i < 3; i++)
     {
-        const unsigned int freq = voice[i]->wave()->readFreq();
+        const unsigned int freq = voice[i].wave()->readFreq();
 
-        if (voice[i]->wave()->readTest() || freq == 0 || !voice[(i + 1) % 3]->wave()->readSync())
+        if (voice[i].wave()->readTest() || freq == 0 || !voice[(i + 1) % 3].wave()->readSync())
         {
             continue;
         }
 
-        const unsigned int accumulator = voice[i]->wave()->readAccumulator();
+        const unsigned int accumulator = voice[i].wave()->readAccumulator();
         const unsigned int thisVoiceSync = ((0x7fffff - accumulator) & 0xffffff) / freq + 1;
 
         if (thisVoiceSync < nextVoiceSync)
@@ -249,6 +264,8 @@ void SID::voiceSync(bool sync)
 
 void SID::setChipModel(ChipModel model)
 {
+    wakeUp();
+
     switch (model)
     {
     case MOS6581:
@@ -273,23 +290,71 @@ void SID::setChipModel(ChipModel model)
     // update voice offsets
     for (int i = 0; i < 3; i++)
     {
-        voice[i]->envelope()->setChipModel(model);
-        voice[i]->wave()->setChipModel(model);
-        voice[i]->wave()->setWaveformModels(tables);
+        voice[i].envelope()->setChipModel(model);
+        voice[i].wave()->setChipModel(model);
+        voice[i].wave()->setWaveformModels(tables);
+    }
+}
+
+void SID::snapshot(libsidplayfp::Snapshot &s)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        voice[i].snapshot(s);
+    }
+
+    filter6581->snapshot(s);
+    filter8580->snapshot(s);
+    externalFilter->snapshot(s);
+
+    for (int i = 0; i < 3; i++)
+    {
+        decimator[i].snapshot(s);
+    }
+
+    s.value(decimationCount);
+
+    if (resampler.get())
+    {
+        resampler->snapshot(s);
+    }
+
+    s.value(busValue);
+    s.value(busValueTtl);
+    s.value(nextVoiceSync);
+    s.value(delayedOffset);
+    s.value(delayedValue);
+    s.value(idleOutput);
+    s.value(idleCount);
+    s.value(idleCycles);
+    s.value(idle);
+
+    if (s.loading() && decimationCount > (1u << clockShift))
+    {
+        s.fail();
     }
 }
 
 void SID::reset()
 {
+    wakeUp();
+
     for (int i = 0; i < 3; i++)
     {
-        voice[i]->reset();
+        voice[i].reset();
     }
 
     filter6581->reset();
     filter8580->reset();
     externalFilter->reset();
 
+    for (int i = 0; i < 3; i++)
+    {
+        decimator[i].reset();
+    }
+
+    decimationCount = 1 << clockShift;
+
     if (resampler.get())
     {
         resampler->reset();
@@ -305,6 +370,7 @@ void SID::input(int value)
 {
     filter6581->input(value);
     filter8580->input(value);
+    wakeUp();
 }
 
 unsigned char SID::read(int offset)
@@ -324,11 +390,11 @@ unsigned char SID::read(int offset)
         break;
 
     case 0x1b: // Voice #3 waveform output
-        busValue = voice[2]->wave()->readOSC();
+        busValue = voice[2].wave()->readOSC();
         break;
 
     case 0x1c: // Voice #3 ADSR output
-        busValue = voice[2]->envelope()->readENV();
+        busValue = voice[2].envelope()->readENV();
         busValueTtl = modelTTL;
         break;
 
@@ -356,8 +422,35 @@ void SID::write(int offset, unsigned char value)
     }
 }
 
-void SID::setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency)
+void SID::setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency, bool fast)
 {
+    wakeUp();
+
+    clockShift = 0;
+
+    if (fast)
+    {
+        // Run the filters at about four times the sampling frequency
+        const double ratio = clockFrequency / (samplingFrequency * 4.);
+        while (clockShift < MAX_CLOCK_SHIFT && (2 << clockShift) <= ratio)
+        {
+            clockShift++;
+        }
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        decimator[i].setShift(clockShift);
+    }
+
+    decimationCount = 1 << clockShift;
+
+    filter6581->setClockShift(clockShift);
+    filter8580->setClockShift(clockShift);
+
+    // The filters and the resampler run at the reduced rate
+    clockFrequency /= 1 << clockShift;
+
     externalFilter->setClockFrequency(clockFrequency);
 
     switch (method)
@@ -390,17 +483,48 @@ void SID::clockSilent(unsigned int cycles)
                 delta_t = 1;
             }
 
-            for (int i = 0; i < delta_t; i++)
+            // The waveform outputs are only observable through
+            // OSC3 reads and the floating DAC after a write, which both
+            // happen after this call returns. The last output depends on
+            // the pulse level of the previous cycle, so only the last
+            // two cycles need to compute it, unless a combined noise
+            // waveform writes the output back into the shift register.
+            const bool writeback =
+                voice[0].wave()->readNoiseWriteback()
+                || voice[1].wave()->readNoiseWriteback()
+                || voice[2].wave()->readNoiseWriteback();
+            const int skipped = writeback ? 0 : std::max(delta_t - 2, 0);
+
+            if (skipped > 0)
             {
-                // clock waveform generators (can affect OSC3)
-                voice[0]->wave()->clock();
-                voice[1]->wave()->clock();
-                voice[2]->wave()->clock();
+                voice[0].wave()->clock(skipped);
+                voice[1].wave()->clock(skipped);
+                voice[2].wave()->clock(skipped);
+
+                voice[0].wave()->skipOutput(skipped);
+                voice[1].wave()->skipOutput(skipped);
+                voice[2].wave()->skipOutput(skipped);
+            }
 
-                // clock ENV3 only
-                voice[2]->envelope()->clock();
+            for (int i = skipped; i < delta_t; i++)
+            {
+                // clock waveform generators
+                voice[0].wave()->clock();
+                voice[1].wave()->clock();
+                voice[2].wave()->clock();
+
+                // update the waveform outputs, which also
+                // advance the pulse pipeline and the floating DAC
+                voice[0].wave()->output(voice[2].wave());
+                voice[1].wave()->output(voice[0].wave());
+                voice[2].wave()->output(voice[1].wave());
             }
 
+            // clock envelope generators
+            voice[0].envelope()->clock(delta_t);
+            voice[1].envelope()->clock(delta_t);
+            voice[2].envelope()->clock(delta_t);
+
             if (delayedOffset != -1)
             {
                 writeImmediate(delayedOffset, delayedValue);
@@ -25,10 +25,19 @@
 
 #include <memory>
 
+#include <stdint.h>
+
 #include "siddefs-fp.h"
+#include "Decimator.h"
+#include "Voice.h"
 
 #include "sidcxx11.h"
 
+namespace libsidplayfp
+{
+class Snapshot;
+}
+
 namespace reSIDfp
 {
 
@@ -37,7 +46,6 @@ class Filter6581;
 class Filter8580;
 class ExternalFilter;
 class Potentiometer;
-class Voice;
 class Resampler;
 
 /**
@@ -59,6 +67,13 @@ public:
  */
 class SID
 {
+private:
+    /// Maximum output deviation still considered constant by the idle detection
+    static const int IDLE_THRESHOLD = 1;
+
+    /// Cycles the output must stay constant before the filters are skipped
+    static const unsigned int IDLE_CYCLES = 100000;
+
 private:
     /// Currently active filter
     Filter* filter;
@@ -84,8 +99,8 @@ private:
     /// Paddle Y register support
     std::unique_ptr<Potentiometer> const potY;
 
-    /// SID voices
-    std::unique_ptr<Voice> voice[3];
+    /// SID voices, held by value to keep their state close together
+    Voice voice[3];
 
     /// Time to live for the last written value
     int busValueTtl;
@@ -96,9 +111,27 @@ private:
     /// Time until #voiceSync must be run.
     unsigned int nextVoiceSync;
 
+    /// Voice output decimators for the fast sampling mode
+    Decimator decimator[3];
+
+    /// log2 of the cycles between filter updates, zero unless in fast sampling mode
+    unsigned int clockShift;
+
+    /// Cycles until the next filter update in fast sampling mode
+    unsigned int decimationCount;
+
     /// Delayed MOS8580 write register
     int delayedOffset;
 
+    /// Output level held while idle
+    int idleOutput;
+
+    /// Cycles the output has stayed close to #idleOutput
+    unsigned int idleCount;
+
+    /// Total cycles spent in the idle fast path
+    uint64_t idleCycles;
+
     /// Currently active chip model.
     ChipModel model;
 
@@ -111,6 +144,12 @@ private:
     /// Flags for muted channels
     bool muted[3];
 
+    /// Whether the filters are skipped, feeding #idleOutput to the resampler
+    bool idle;
+
+    /// Whether the idle fast path may be entered at all
+    bool idleSkip;
+
 private:
     /**
      * Write value to register during this clock cycle.
@@ -132,7 +171,47 @@ private:
      *
      * @return the output sample
      */
-    int output() const;
+    int output();
+
+    /**
+     * Run the filters or, if idle, return the held output level.
+     *
+     * @param v1 voice 1 output
+     * @param v2 voice 2 output
+     * @param v3 voice 3 output
+     * @param cycles the number of cycles the output accounts for
+     * @return the output sample
+     */
+    int filterOutput(int v1, int v2, int v3, unsigned int cycles);
+
+    /**
+     * Check whether the output has become stationary.
+     * This happens when all the envelopes are frozen at zero,
+     * so that the voice outputs are zero, and the filters
+     * have settled to a constant output.
+     *
+     * @param out the last output sample
+     * @param cycles the number of cycles the output accounts for
+     */
+    void checkIdle(int out, unsigned int cycles);
+
+    /**
+     * Leave the idle fast path, called on any state change.
+     */
+    void wakeUp()
+    {
+        idle = false;
+        idleCount = 0;
+    }
+
+    /**
+     * Feed the voice outputs to the decimators and,
+     * every 2^clockShift cycles, clock the filters.
+     *
+     * @param out the output sample, when available
+     * @return true if an output sample is available
+     */
+    bool decimatedOutput(int &out);
 
     /**
      * Calculate the numebr of cycles according to current parameters
@@ -142,6 +221,19 @@ private:
      */
     void voiceSync(bool sync);
 
+    /**
+     * Clock the chip and store the resampled output into the buffer.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    template<typename T>
+    int clockSamples(unsigned int cycles, T* buf);
+
+    static void storeSample(short& dest, const Resampler& r);
+    static void storeSample(float& dest, const Resampler& r);
+
 public:
     SID();
     ~SID();
@@ -164,6 +256,15 @@ public:
      */
     void reset();
 
+    /**
+     * Save or restore the chip state.
+     * The chip model and sampling parameters are not part of the state
+     * and must match the ones used when saving.
+     *
+     * @param s the snapshot
+     */
+    void snapshot(libsidplayfp::Snapshot &s);
+
     /**
      * 16-bit input (EXT IN). Write 16-bit sample to audio input. NB! The caller
      * is responsible for keeping the value within 16 bits. Note that to mix in
@@ -231,13 +332,21 @@ public:
      * is limited to slightly below 20kHz.
      * This constraint ensures that the FIR table is not overfilled.
      *
+     * In fast sampling mode the voices are still clocked every cycle
+     * but their output is decimated to about four times the sampling
+     * frequency, and the filters run at that reduced rate.
+     * This roughly halves the emulation time at the price of some
+     * aliasing (below ~ -40 dB) and a less accurate filter response
+     * near the cutoff at high frequencies.
+     *
      * @param clockFrequency System clock frequency at Hz
      * @param method sampling method to use
      * @param samplingFrequency Desired output sampling rate
      * @param highestAccurateFrequency
+     * @param fast use the fast, lower quality, sampling mode
      * @throw SIDError
      */
-    void setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency);
+    void setSamplingParameters(double clockFrequency, SamplingMethod method, double samplingFrequency, double highestAccurateFrequency, bool fast);
 
     /**
      * Clock SID forward using chosen output sampling algorithm.
@@ -248,13 +357,24 @@ public:
      */
     int clock(unsigned int cycles, short* buf);
 
+    /**
+     * Clock SID forward using chosen output sampling algorithm.
+     * Samples are not clipped nor quantized, full scale is
+     * still the 16 bit range.
+     *
+     * @param cycles c64 clocks to clock
+     * @param buf audio output buffer
+     * @return number of samples produced
+     */
+    int clock(unsigned int cycles, float* buf);
+
     /**
      * Clock SID forward with no audio production.
      *
-     * _Warning_:
-     * You can't mix this method of clocking with the audio-producing
-     * clock() because components that don't affect OSC3/ENV3 are not
-     * emulated.
+     * The voices are fully emulated, so that audio-producing clock()
+     * can be resumed afterwards, but the filters and the resampler
+     * are left untouched: their state goes stale and needs some
+     * audible clocking to settle again.
      *
      * @param cycles c64 clocks to clock.
      */
@@ -280,6 +400,28 @@ public:
      * @param enable false to turn off filter emulation
      */
     void enableFilter(bool enable);
+
+    /**
+     * Enable the idle fast path, off by default.
+     *
+     * When all the envelopes are frozen at zero and the filters output
+     * has stayed within 1 unit for 100000 cycles, the filters are not
+     * clocked and the last level is fed to the resampler until the next
+     * register write. This is lossy: the output may differ by 1 unit
+     * and a slow decay of the filters output is cut short.
+     *
+     * @param enable true to skip the filters while idle
+     */
+    void enableIdleSkip(bool enable)
+    {
+        idleSkip = enable;
+        wakeUp();
+    }
+
+    /**
+     * Get the number of cycles spent in the idle fast path.
+     */
+    uint64_t getIdleCycles() const { return idleCycles; }
 };
 
 } // namespace reSIDfp
@@ -290,7 +432,6 @@ public:
 
 #include "Filter.h"
 #include "ExternalFilter.h"
-#include "Voice.h"
 #include "resample/Resampler.h"
 
 namespace reSIDfp
@@ -312,18 +453,93 @@ void SID::ageBusValue(unsigned int n)
 }
 
 RESID_INLINE
-int SID::output() const
+void SID::checkIdle(int out, unsigned int cycles)
 {
-    const int v1 = voice[0]->output(voice[2]->wave());
-    const int v2 = voice[1]->output(voice[0]->wave());
-    const int v3 = voice[2]->output(voice[1]->wave());
+    if (likely(!idleSkip
+        || !voice[0].envelope()->isFrozen()
+        || !voice[1].envelope()->isFrozen()
+        || !voice[2].envelope()->isFrozen()))
+    {
+        return;
+    }
 
-    return externalFilter->clock(filter->clock(v1, v2, v3));
+    if (out > idleOutput + IDLE_THRESHOLD || out < idleOutput - IDLE_THRESHOLD)
+    {
+        idleOutput = out;
+        idleCount = 0;
+        return;
+    }
+
+    idleCount += cycles;
+
+    if (unlikely(idleCount >= IDLE_CYCLES))
+    {
+        idle = true;
+    }
+}
+
+RESID_INLINE
+int SID::filterOutput(int v1, int v2, int v3, unsigned int cycles)
+{
+    if (unlikely(idle))
+    {
+        idleCycles += cycles;
+        return idleOutput;
+    }
+
+    const int out = externalFilter->clock(filter->clock(v1, v2, v3));
+    checkIdle(out, cycles);
+    return out;
 }
 
+RESID_INLINE
+int SID::output()
+{
+    const int v1 = voice[0].output(voice[2].wave());
+    const int v2 = voice[1].output(voice[0].wave());
+    const int v3 = voice[2].output(voice[1].wave());
+
+    return filterOutput(v1, v2, v3, 1);
+}
 
 RESID_INLINE
-int SID::clock(unsigned int cycles, short* buf)
+bool SID::decimatedOutput(int &out)
+{
+    decimator[0].input(voice[0].output(voice[2].wave()));
+    decimator[1].input(voice[1].output(voice[0].wave()));
+    decimator[2].input(voice[2].output(voice[1].wave()));
+
+    if (likely(--decimationCount != 0))
+    {
+        return false;
+    }
+
+    decimationCount = 1 << clockShift;
+
+    const int v1 = decimator[0].output();
+    const int v2 = decimator[1].output();
+    const int v3 = decimator[2].output();
+
+    out = filterOutput(v1, v2, v3, 1 << clockShift);
+    return true;
+}
+
+
+RESID_INLINE
+void SID::storeSample(short& dest, const Resampler& r)
+{
+    dest = r.getOutput();
+}
+
+RESID_INLINE
+void SID::storeSample(float& dest, const Resampler& r)
+{
+    dest = r.getOutputFloat();
+}
+
+template<typename T>
+RESID_INLINE
+int SID::clockSamples(unsigned int cycles, T* buf)
 {
     ageBusValue(cycles);
     int s = 0;
@@ -342,18 +558,29 @@ int SID::clock(unsigned int cycles, short* buf)
             for (unsigned int i = 0; i < delta_t; i++)
             {
                 // clock waveform generators
-                voice[0]->wave()->clock();
-                voice[1]->wave()->clock();
-                voice[2]->wave()->clock();
+                voice[0].wave()->clock();
+                voice[1].wave()->clock();
+                voice[2].wave()->clock();
 
                 // clock envelope generators
-                voice[0]->envelope()->clock();
-                voice[1]->envelope()->clock();
-                voice[2]->envelope()->clock();
+                voice[0].envelope()->clock();
+                voice[1].envelope()->clock();
+                voice[2].envelope()->clock();
 
-                if (unlikely(resampler->input(output())))
+                if (likely(clockShift == 0))
                 {
-                    buf[s++] = resampler->getOutput();
+                    if (unlikely(resampler->input(output())))
+                    {
+                        storeSample(buf[s++], *resampler);
+                    }
+                }
+                else
+                {
+                    int out;
+                    if (unlikely(decimatedOutput(out)) && resampler->input(out))
+                    {
+                        storeSample(buf[s++], *resampler);
+                    }
                 }
             }
 
@@ -376,6 +603,18 @@ int SID::clock(unsigned int cycles, short* buf)
     return s;
 }
 
+RESID_INLINE
+int SID::clock(unsigned int cycles, short* buf)
+{
+    return clockSamples(cycles, buf);
+}
+
+RESID_INLINE
+int SID::clock(unsigned int cycles, float* buf)
+{
+    return clockSamples(cycles, buf);
+}
+
 } // namespace reSIDfp
 
 #endif
@@ -0,0 +1,259 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "TableCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_UNISTD_H
+#  include <unistd.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#endif
+
+namespace reSIDfp
+{
+
+/// Bump when the file layout changes.
+const uint32_t CACHE_VERSION = 1;
+
+const char CACHE_MAGIC[8] = { 'R', 'E', 'S', 'I', 'D', 'F', 'P', 'T' };
+
+struct header_t
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t key;
+    uint64_t size;
+    uint64_t checksum;
+};
+
+static std::string g_cacheDirectory;
+static std::mutex g_cacheDirectory_mutex;
+
+void TableCache::setDirectory(const char* path)
+{
+    std::lock_guard<std::mutex> guard(g_cacheDirectory_mutex);
+    g_cacheDirectory.assign(path != nullptr ? path : "");
+}
+
+/**
+ * Get the file name for a table set, empty if the cache is disabled.
+ */
+static std::string getPath(const char* name)
+{
+    std::lock_guard<std::mutex> guard(g_cacheDirectory_mutex);
+
+    if (g_cacheDirectory.empty())
+        return std::string();
+
+    return g_cacheDirectory + "/" + name + ".tab";
+}
+
+static size_t totalSize(const TableCache::chunks_t &chunks)
+{
+    size_t size = 0;
+    for (TableCache::chunks_t::const_iterator it = chunks.begin(); it != chunks.end(); ++it)
+        size += it->size;
+    return size;
+}
+
+/**
+ * Fletcher style checksum over 32 bit words, fast enough to
+ * keep the load time dominated by the memory copy.
+ */
+class Checksum
+{
+private:
+    uint64_t sum1;
+    uint64_t sum2;
+
+public:
+    Checksum() : sum1(0), sum2(0) {}
+
+    void update(const unsigned char* data, size_t size)
+    {
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            uint32_t word;
+            memcpy(&word, data + i, 4);
+            sum1 += word;
+            sum2 += sum1;
+        }
+        for (; i < size; i++)
+        {
+            sum1 += data[i];
+            sum2 += sum1;
+        }
+    }
+
+    uint64_t get() const { return sum1 ^ (sum2 * 0x9e3779b97f4a7c15ULL); }
+};
+
+/**
+ * Validate a cache file image and copy the tables out of it.
+ */
+static bool extract(const unsigned char* file, size_t fileSize, uint64_t key, const TableCache::chunks_t &chunks)
+{
+    const size_t size = totalSize(chunks);
+
+    if (fileSize != sizeof(header_t) + size)
+        return false;
+
+    header_t header;
+    memcpy(&header, file, sizeof(header_t));
+
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+        || header.version != CACHE_VERSION
+        || header.key != key
+        || header.size != size)
+        return false;
+
+    const unsigned char* data = file + sizeof(header_t);
+
+    // Each chunk is checksummed separately, as on saving
+    Checksum checksum;
+    size_t offset = 0;
+    for (TableCache::chunks_t::const_iterator it = chunks.begin(); it != chunks.end(); ++it)
+    {
+        checksum.update(data + offset, it->size);
+        offset += it->size;
+    }
+
+    if (checksum.get() != header.checksum)
+        return false;
+
+    offset = 0;
+    for (TableCache::chunks_t::const_iterator it = chunks.begin(); it != chunks.end(); ++it)
+    {
+        memcpy(it->data, data + offset, it->size);
+        offset += it->size;
+    }
+
+    return true;
+}
+
+bool TableCache::load(const char* name, uint64_t key, const chunks_t &chunks)
+{
+    const std::string path = getPath(name);
+    if (path.empty())
+        return false;
+
+    bool loaded = false;
+
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        const size_t fileSize = static_cast<size_t>(st.st_size);
+        void* map = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            loaded = extract(static_cast<const unsigned char*>(map), fileSize, key, chunks);
+            munmap(map, fileSize);
+        }
+    }
+
+    close(fd);
+#else
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == nullptr)
+        return false;
+
+    std::vector<unsigned char> file(sizeof(header_t) + totalSize(chunks) + 1);
+    const size_t fileSize = fread(&file[0], 1, file.size(), f);
+    fclose(f);
+
+    loaded = extract(&file[0], fileSize, key, chunks);
+#endif
+
+    return loaded;
+}
+
+void TableCache::save(const char* name, uint64_t key, const chunks_t &chunks)
+{
+    const std::string path = getPath(name);
+    if (path.empty())
+        return;
+
+    header_t header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.reserved = 0;
+    header.key = key;
+    header.size = totalSize(chunks);
+
+    Checksum checksum;
+    for (chunks_t::const_iterator it = chunks.begin(); it != chunks.end(); ++it)
+        checksum.update(static_cast<const unsigned char*>(it->data), it->size);
+    header.checksum = checksum.get();
+
+    // Write to a private file and rename it in place so that
+    // concurrent processes never see a partial file.
+    std::string tmpPath(path);
+#ifdef HAVE_UNISTD_H
+    tmpPath.append(".").append(std::to_string(static_cast<long>(getpid())));
+#endif
+    tmpPath.append(".tmp");
+
+    FILE* f = fopen(tmpPath.c_str(), "wb");
+    if (f == nullptr)
+        return;
+
+    bool ok = fwrite(&header, sizeof(header_t), 1, f) == 1;
+    for (chunks_t::const_iterator it = chunks.begin(); ok && it != chunks.end(); ++it)
+        ok = fwrite(it->data, 1, it->size, f) == it->size;
+
+    if (fclose(f) != 0)
+        ok = false;
+
+    if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0)
+        remove(tmpPath.c_str());
+}
+
+uint64_t TableCache::hash(const void* data, size_t size, uint64_t hash)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} // namespace reSIDfp
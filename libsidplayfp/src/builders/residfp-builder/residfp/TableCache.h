@@ -0,0 +1,98 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef TABLECACHE_H
+#define TABLECACHE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace reSIDfp
+{
+
+/**
+ * Optional on-disk cache for the tables computed at startup.
+ *
+ * Each table set is stored in its own file: a header followed by
+ * the raw table data. The header carries a format version, a key
+ * identifying the parameters the tables were computed from and
+ * a checksum of the data. Files that don't match are ignored
+ * and overwritten with freshly computed tables.
+ *
+ * The cache is disabled until a directory is set.
+ */
+class TableCache
+{
+public:
+    /**
+     * A block of table data, loaded or saved in place.
+     */
+    struct chunk_t
+    {
+        void* data;
+        size_t size;
+    };
+
+    typedef std::vector<chunk_t> chunks_t;
+
+public:
+    /**
+     * Set the cache directory.
+     *
+     * @param path the directory, or nullptr to disable the cache
+     */
+    static void setDirectory(const char* path);
+
+    /**
+     * Load a table set from the cache.
+     * The chunks are left untouched if the file is missing or invalid.
+     *
+     * @param name the table set name, used as file name
+     * @param key the hash of the generating parameters
+     * @param chunks the destination buffers
+     * @return true if the tables were loaded
+     */
+    static bool load(const char* name, uint64_t key, const chunks_t &chunks);
+
+    /**
+     * Store a table set in the cache.
+     * Errors are ignored, the cache is best effort.
+     *
+     * @param name the table set name, used as file name
+     * @param key the hash of the generating parameters
+     * @param chunks the table data
+     */
+    static void save(const char* name, uint64_t key, const chunks_t &chunks);
+
+    /**
+     * FNV-1a hash, used to build the keys.
+     *
+     * @param data the bytes to hash
+     * @param size the number of bytes
+     * @param hash the hash of the previous data, if any
+     * @return the updated hash
+     */
+    static uint64_t hash(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ULL);
+};
+
+} // namespace reSIDfp
+
+#endif
@@ -23,8 +23,6 @@
 #ifndef VOICE_H
 #define VOICE_H
 
-#include <memory>
-
 #include "siddefs-fp.h"
 #include "WaveformGenerator.h"
 #include "EnvelopeGenerator.h"
@@ -36,13 +34,18 @@ namespace reSIDfp
 
 /**
  * Representation of SID voice block.
+ *
+ * The generators are held by value so that the state of
+ * the voices is packed together in the SID object.
+ * The voices are still clocked one by one, this is not
+ * a vectorized struct-of-arrays layout.
  */
 class Voice
 {
 private:
-    std::unique_ptr<WaveformGenerator> const waveformGenerator;
+    WaveformGenerator waveformGenerator;
 
-    std::unique_ptr<EnvelopeGenerator> const envelopeGenerator;
+    EnvelopeGenerator envelopeGenerator;
 
 public:
     /**
@@ -60,21 +63,18 @@ public:
      * @return waveformgenerator output
      */
     RESID_INLINE
-    int output(const WaveformGenerator* ringModulator) const
+    int output(const WaveformGenerator* ringModulator)
     {
-        return static_cast<int>(waveformGenerator->output(ringModulator) * envelopeGenerator->output());
+        return static_cast<int>(waveformGenerator.output(ringModulator) * envelopeGenerator.output());
     }
 
-    /**
-     * Constructor.
-     */
-    Voice() :
-        waveformGenerator(new WaveformGenerator()),
-        envelopeGenerator(new EnvelopeGenerator()) {}
+    WaveformGenerator* wave() { return &waveformGenerator; }
+
+    const WaveformGenerator* wave() const { return &waveformGenerator; }
 
-    WaveformGenerator* wave() const { return waveformGenerator.get(); }
+    EnvelopeGenerator* envelope() { return &envelopeGenerator; }
 
-    EnvelopeGenerator* envelope() const { return envelopeGenerator.get(); }
+    const EnvelopeGenerator* envelope() const { return &envelopeGenerator; }
 
     /**
      * Write control register.
@@ -83,8 +83,8 @@ public:
      */
     void writeCONTROL_REG(unsigned char control)
     {
-        waveformGenerator->writeCONTROL_REG(control);
-        envelopeGenerator->writeCONTROL_REG(control);
+        waveformGenerator.writeCONTROL_REG(control);
+        envelopeGenerator.writeCONTROL_REG(control);
     }
 
     /**
@@ -92,8 +92,17 @@ public:
      */
     void reset()
     {
-        waveformGenerator->reset();
-        envelopeGenerator->reset();
+        waveformGenerator.reset();
+        envelopeGenerator.reset();
+    }
+
+    /**
+     * Save or restore the voice state.
+     */
+    void snapshot(libsidplayfp::Snapshot &s)
+    {
+        waveformGenerator.snapshot(s);
+        envelopeGenerator.snapshot(s);
     }
 };
 
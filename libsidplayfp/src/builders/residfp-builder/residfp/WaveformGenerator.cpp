@@ -24,7 +24,10 @@
 
 #include "WaveformGenerator.h"
 
+#include <mutex>
+
 #include "Dac.h"
+#include "Snapshot.h"
 
 namespace reSIDfp
 {
@@ -125,18 +128,33 @@ void WaveformGenerator::setWaveformModels(matrix_t* models)
     model_wave = models;
 }
 
+static std::mutex g_WaveformDac_mutex;
+static float g_WaveformDac[2][1 << DAC_BITS];
+static bool g_WaveformDacReady[2] = { false, false };
+
 void WaveformGenerator::setChipModel(ChipModel chipModel)
 {
-    Dac dacBuilder(DAC_BITS);
-    dacBuilder.kinkedDac(chipModel);
+    const int index = chipModel == MOS6581 ? 0 : 1;
 
-    const float offset = dacBuilder.getOutput(chipModel == MOS6581 ? 0x380 : 0x800);
+    std::lock_guard<std::mutex> guard(g_WaveformDac_mutex);
 
-    for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
+    if (!g_WaveformDacReady[index])
     {
-        const double dacValue = dacBuilder.getOutput(i);
-        dac[i] = static_cast<float>(dacValue - offset);
+        Dac dacBuilder(DAC_BITS);
+        dacBuilder.kinkedDac(chipModel);
+
+        const float offset = dacBuilder.getOutput(chipModel == MOS6581 ? 0x380 : 0x800);
+
+        for (unsigned int i = 0; i < (1 << DAC_BITS); i++)
+        {
+            const double dacValue = dacBuilder.getOutput(i);
+            g_WaveformDac[index][i] = static_cast<float>(dacValue - offset);
+        }
+
+        g_WaveformDacReady[index] = true;
     }
+
+    dac = g_WaveformDac[index];
 }
 
 void WaveformGenerator::synchronize(WaveformGenerator* syncDest, const WaveformGenerator* syncSource) const
@@ -212,6 +230,72 @@ void WaveformGenerator::writeCONTROL_REG(unsigned char control)
     }
 }
 
+void WaveformGenerator::clock(unsigned int cycles)
+{
+    if (test)
+    {
+        if (shift_register_reset != 0)
+        {
+            if (static_cast<unsigned int>(shift_register_reset) > cycles)
+            {
+                shift_register_reset -= cycles;
+            }
+            else
+            {
+                shift_register_reset = 0;
+
+                reset_shift_register();
+
+                write_shift_register();
+
+                // New noise waveform output.
+                set_noise_output();
+            }
+        }
+
+        // The test bit sets pulse high.
+        pulse_output = 0xfff;
+        return;
+    }
+
+    while (cycles != 0)
+    {
+        // A pending shift is handled cycle by cycle
+        if (shift_pipeline != 0)
+        {
+            clock();
+            cycles--;
+            continue;
+        }
+
+        if (freq == 0)
+        {
+            msb_rising = false;
+            return;
+        }
+
+        // The frequency is at most 16 bits, so the accumulator
+        // steps over every point where bit 19 goes high.
+        const unsigned int low = accumulator & 0xfffff;
+        const unsigned int edge = low < 0x80000 ? 0x80000 : 0x180000;
+        const unsigned int distance = (edge - low + freq - 1) / freq;
+
+        if (distance > cycles)
+        {
+            // Unsigned wraparound keeps the low 24 bits exact
+            const unsigned int accumulator_old = (accumulator + (cycles - 1) * freq) & 0xffffff;
+            accumulator = (accumulator_old + freq) & 0xffffff;
+            msb_rising = ((~accumulator_old & accumulator) & 0x800000) != 0;
+            return;
+        }
+
+        // Run the cycle setting bit 19 as usual
+        accumulator = (accumulator + (distance - 1) * freq) & 0xffffff;
+        cycles -= distance;
+        clock();
+    }
+}
+
 void WaveformGenerator::reset()
 {
     accumulator = 0;
@@ -239,4 +323,31 @@ void WaveformGenerator::reset()
     floating_output_ttl = 0;
 }
 
+void WaveformGenerator::snapshot(libsidplayfp::Snapshot &s)
+{
+    s.value(pw);
+    s.value(shift_register);
+    s.value(shift_register_reset);
+    s.value(shift_pipeline);
+    s.value(ring_msb_mask);
+    s.value(no_noise);
+    s.value(noise_output);
+    s.value(no_noise_or_noise_output);
+    s.value(no_pulse);
+    s.value(pulse_output);
+    s.value(waveform);
+    s.value(floating_output_ttl);
+    s.value(waveform_output);
+    s.value(accumulator);
+    s.value(freq);
+    s.value(test);
+    s.value(sync);
+    s.value(msb_rising);
+
+    if (s.loading())
+    {
+        wave = model_wave ? (*model_wave)[waveform & 0x7] : nullptr;
+    }
+}
+
 } // namespace reSIDfp
@@ -28,6 +28,11 @@
 
 #include "sidcxx11.h"
 
+namespace libsidplayfp
+{
+class Snapshot;
+}
+
 namespace reSIDfp
 {
 
@@ -130,7 +135,8 @@ private:
     /// Tell whether the accumulator MSB was set high on this cycle.
     bool msb_rising;
 
-    float dac[4096];
+    /// DAC lookup table, shared by all the generators of the same chip model
+    const float* dac;
 
 private:
     void clock_shift_register(unsigned int bit0);
@@ -158,6 +164,19 @@ public:
      */
     void clock();
 
+    /**
+     * Clock the oscillator for the given number of cycles.
+     * The accumulator jumps straight to the next cycle where bit 19
+     * goes high instead of being stepped every cycle, so it is much
+     * faster than calling clock() repeatedly while giving exactly
+     * the same results. The output is not updated, see skipOutput().
+     * Not usable while the output is written back into the
+     * noise shift register, see readNoiseWriteback().
+     *
+     * @param cycles the number of cycles
+     */
+    void clock(unsigned int cycles);
+
     /**
      * Synchronize oscillators.
      * This must be done after all the oscillators have been clock()'ed,
@@ -191,7 +210,8 @@ public:
         freq(0),
         test(false),
         sync(false),
-        msb_rising(false) {}
+        msb_rising(false),
+        dac(nullptr) {}
 
     /**
      * Write FREQ LO register.
@@ -233,6 +253,11 @@ public:
      */
     void reset();
 
+    /**
+     * Save or restore the oscillator state.
+     */
+    void snapshot(libsidplayfp::Snapshot &s);
+
     /**
      * 12-bit waveform output as an analogue float value.
      * The output from SID 8580 is delayed one cycle compared to SID 6581;
@@ -242,6 +267,16 @@ public:
      */
     float output(const WaveformGenerator* ringModulator);
 
+    /**
+     * Age the floating DAC input as the given number of output() calls
+     * would do, without computing the output.
+     * The caller must run output() on the last two cycles
+     * before the output or the pulse level is needed again.
+     *
+     * @param cycles number of skipped output() calls
+     */
+    void skipOutput(unsigned int cycles);
+
     /**
      * Read OSC3 value (6581, not latched/delayed version)
      */
@@ -266,6 +301,12 @@ public:
      * Read sync value.
      */
     bool readSync() const { return sync; }
+
+    /**
+     * Tell whether the output is written back into the noise
+     * shift register, as happens with combined waveforms including noise.
+     */
+    bool readNoiseWriteback() const { return waveform > 0x8; }
 };
 
 } // namespace reSIDfp
@@ -359,6 +400,25 @@ float WaveformGenerator::output(const WaveformGenerator* ringModulator)
     return dac[waveform_output];
 }
 
+RESID_INLINE
+void WaveformGenerator::skipOutput(unsigned int cycles)
+{
+    // Only the floating DAC input carries state across output() calls,
+    // the waveform and pulse levels are computed from scratch.
+    if (waveform == 0 && floating_output_ttl != 0)
+    {
+        if (static_cast<unsigned int>(floating_output_ttl) <= cycles)
+        {
+            floating_output_ttl = 0;
+            waveform_output = 0;
+        }
+        else
+        {
+            floating_output_ttl -= cycles;
+        }
+    }
+}
+
 } // namespace reSIDfp
 
 #endif
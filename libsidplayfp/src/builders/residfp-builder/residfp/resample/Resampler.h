@@ -22,6 +22,8 @@
 #ifndef RESAMPLER_H
 #define RESAMPLER_H
 
+#include "Snapshot.h"
+
 namespace reSIDfp
 {
 
@@ -63,7 +65,20 @@ public:
         return value;
     }
 
+    /**
+     * Output a sample from resampler without clipping it
+     * to the 16 bit range.
+     *
+     * @return resampled sample
+     */
+    float getOutputFloat() const { return static_cast<float>(output()); }
+
     virtual void reset() = 0;
+
+    /**
+     * Save or restore the resampler state.
+     */
+    virtual void snapshot(libsidplayfp::Snapshot &s) = 0;
 };
 
 } // namespace reSIDfp
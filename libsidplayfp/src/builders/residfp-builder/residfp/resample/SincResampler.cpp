@@ -23,35 +23,69 @@
 #include "SincResampler.h"
 
 #include <cassert>
+#include <cstdio>
 #include <cstring>
 #include <cmath>
-#include <iostream>
-#include <sstream>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <utility>
 
 #include "siddefs-fp.h"
 
-#ifdef HAVE_CONFIG_H
-#  include "config.h"
-#endif
-
-#ifdef HAVE_MMINTRIN_H
-#  include <mmintrin.h>
-#endif
+#include "../TableCache.h"
 
 namespace reSIDfp
 {
 
-typedef std::map<std::string, matrix_t> fir_cache_t;
+/**
+ * Parameters identifying a FIR table.
+ */
+struct fir_key_t
+{
+    int firN;
+    int firRES;
+    double cyclesPerSample;
+
+    bool operator<(const fir_key_t &other) const
+    {
+        if (firN != other.firN)
+            return firN < other.firN;
+        if (firRES != other.firRES)
+            return firRES < other.firRES;
+        return cyclesPerSample < other.cyclesPerSample;
+    }
+};
+
+/**
+ * A cached FIR table, computed once by the first resampler needing it.
+ */
+struct fir_cache_entry_t
+{
+    std::once_flag computed;
+    matrix_t table;
+
+    fir_cache_entry_t(int firRES, int firN) :
+        table(firRES, firN) {}
+};
+
+typedef std::map<fir_key_t, fir_cache_entry_t> fir_cache_t;
 
 /// Cache for the expensive FIR table computation results.
-fir_cache_t FIR_CACHE;
+static fir_cache_t FIR_CACHE;
+
+/// Protects the map structure, the tables are filled outside the lock.
+static std::mutex FIR_CACHE_LOCK;
 
 /// Maximum error acceptable in I0 is 1e-6, or ~96 dB.
 const double I0E = 1e-6;
 
 const int BITS = 16;
 
+/// Bump when the table computation changes, to invalidate cached tables.
+const int TABLES_VERSION = 1;
+
 /**
  * Compute the 0th order modified Bessel function of the first kind.
  * This function is originally from resample-1.5/filterkit.c by J. O. Smith.
@@ -79,45 +113,6 @@ double I0(double x)
     return sum;
 }
 
-/**
- * Calculate convolution with sample and sinc.
- *
- * @param a sample buffer input
- * @param b sinc buffer
- * @param bLength length of the sinc buffer
- * @return convolved result
- */
-int convolve(const short* a, const short* b, int bLength)
-{
-#ifdef HAVE_MMINTRIN_H
-    __m64 acc = _mm_setzero_si64();
-
-    const int n = bLength / 4;
-
-    for (int i = 0; i < n; i++)
-    {
-        const __m64 tmp = _mm_madd_pi16(*(__m64*)a, *(__m64*)b);
-        acc = _mm_add_pi16(acc, tmp);
-        a += 4;
-        b += 4;
-    }
-
-    int out = _mm_cvtsi64_si32(acc) + _mm_cvtsi64_si32(_mm_srli_si64(acc, 32));
-    _mm_empty();
-
-    bLength &= 3;
-#else
-    int out = 0;
-#endif
-
-    for (int i = 0; i < bLength; i++)
-    {
-        out += *a++ * *b++;
-    }
-
-    return (out + (1 << 14)) >> 15;
-}
-
 int SincResampler::fir(int subcycle)
 {
     // Find the first of the nearest fir tables close to the phase
@@ -145,6 +140,7 @@ int SincResampler::fir(int subcycle)
 }
 
 SincResampler::SincResampler(double clockFrequency, double samplingFrequency, double highestAccurateFrequency) :
+    convolve(convolveKernels().front().convolve),
     sampleIndex(0),
     cyclesPerSample(static_cast<int>(clockFrequency / samplingFrequency * 1024.)),
     sampleOffset(0),
@@ -188,23 +184,46 @@ SincResampler::SincResampler(double clockFrequency, double samplingFrequency, do
         // The filter test program indicates that the filter performs well, though.
     }
 
-    // Create the map key
-    std::ostringstream o;
-    o << firN << "," << firRES << "," << cyclesPerSampleD;
-    const std::string firKey = o.str();
-    fir_cache_t::iterator lb = FIR_CACHE.lower_bound(firKey);
-
     // The FIR computation is expensive and we set sampling parameters often, but
     // from a very small set of choices. Thus, caching is used to speed initialization.
-    if (lb != FIR_CACHE.end() && !(FIR_CACHE.key_comp()(firKey, lb->first)))
+    // Entries are never removed so the table stays valid once published.
+    const fir_key_t firKey = { firN, firRES, cyclesPerSampleD };
+
+    fir_cache_entry_t* entry;
     {
-        firTable = &(lb->second);
+        std::lock_guard<std::mutex> guard(FIR_CACHE_LOCK);
+
+        fir_cache_t::iterator lb = FIR_CACHE.lower_bound(firKey);
+
+        if (lb == FIR_CACHE.end() || FIR_CACHE.key_comp()(firKey, lb->first))
+        {
+            lb = FIR_CACHE.emplace_hint(lb, std::piecewise_construct,
+                std::forward_as_tuple(firKey),
+                std::forward_as_tuple(firRES, firN));
+        }
+
+        entry = &(lb->second);
     }
-    else
+
+    // Other threads asking for the same table wait here until it is filled.
+    std::call_once(entry->computed, [&]()
     {
-        // Allocate memory for FIR tables.
-        matrix_t tempTable(firRES, firN);
-        firTable = &(FIR_CACHE.insert(lb, fir_cache_t::value_type(firKey, tempTable))->second);
+        matrix_t &table = entry->table;
+
+        // Try the on-disk cache first
+        const int values[] = { TABLES_VERSION, BITS, firN, firRES };
+        uint64_t key = TableCache::hash(values, sizeof(values));
+        key = TableCache::hash(&cyclesPerSampleD, sizeof(cyclesPerSampleD), key);
+
+        char name[32];
+        snprintf(name, sizeof(name), "fir%016llx", static_cast<unsigned long long>(key));
+
+        TableCache::chunks_t chunks;
+        const TableCache::chunk_t chunk = { table[0], table.length() * sizeof(short) };
+        chunks.push_back(chunk);
+
+        if (TableCache::load(name, key, chunks))
+            return;
 
         // The cutoff frequency is midway through the transition band, in effect the same as nyquist.
         const double wc = M_PI;
@@ -226,10 +245,16 @@ SincResampler::SincResampler(double clockFrequency, double samplingFrequency, do
                 const double wt = wc * x / cyclesPerSampleD;
                 const double sincWt = fabs(wt) >= 1e-8 ? sin(wt) / wt : 1.;
 
-                (*firTable)[i][j] = static_cast<short>(scale * sincWt * kaiserXt);
+                table[i][j] = static_cast<short>(scale * sincWt * kaiserXt);
             }
         }
-    }
+
+        TableCache::save(name, key, chunks);
+    });
+
+    firTable = &(entry->table);
+
+    memset(sample, 0, sizeof(sample));
 }
 
 template<typename I, typename O>
@@ -272,4 +297,22 @@ void SincResampler::reset()
     sampleOffset = 0;
 }
 
+void SincResampler::snapshot(libsidplayfp::Snapshot &s)
+{
+    s.value(sampleIndex);
+    s.value(sampleOffset);
+    s.value(outputValue);
+
+    // The upper half of the ring mirrors the lower one
+    s.bytes(sample, RINGSIZE * sizeof(short));
+
+    if (s.loading())
+    {
+        if (sampleIndex < 0 || sampleIndex >= RINGSIZE)
+            s.fail();
+
+        memcpy(sample + RINGSIZE, sample, RINGSIZE * sizeof(short));
+    }
+}
+
 } // namespace reSIDfp
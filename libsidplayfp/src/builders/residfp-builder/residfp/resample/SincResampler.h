@@ -24,9 +24,7 @@
 #define SINCRESAMPLER_H
 
 #include "Resampler.h"
-
-#include <string>
-#include <map>
+#include "convolve.h"
 
 #include "../array.h"
 
@@ -48,7 +46,8 @@ namespace reSIDfp
  * By building shifted FIR tables with samples according to the sampling frequency,
  * this implementation dramatically reduces the computational effort in the
  * filter convolutions, without any loss of accuracy.
- * The filter convolutions are also vectorizable on current hardware.
+ * The filter convolutions are also vectorizable on current hardware,
+ * the kernel is selected at runtime according to the CPU capabilities.
  */
 class SincResampler final : public Resampler
 {
@@ -60,6 +59,9 @@ private:
     /// Table of the fir filter coefficients
     matrix_t* firTable;
 
+    /// Convolution kernel, the fastest one supported by the CPU
+    const convolve_t convolve;
+
     int sampleIndex;
 
     /// Filter resolution
@@ -107,6 +109,8 @@ public:
     int output() const override { return outputValue; }
 
     void reset() override;
+
+    void snapshot(libsidplayfp::Snapshot &s) override;
 };
 
 } // namespace reSIDfp
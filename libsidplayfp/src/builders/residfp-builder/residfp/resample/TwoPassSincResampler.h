@@ -76,6 +76,12 @@ public:
         s1->reset();
         s2->reset();
     }
+
+    void snapshot(libsidplayfp::Snapshot &s) override
+    {
+        s1->snapshot(s);
+        s2->snapshot(s);
+    }
 };
 
 } // namespace reSIDfp
@@ -81,6 +81,13 @@ public:
         sampleOffset = 0;
         cachedSample = 0;
     }
+
+    void snapshot(libsidplayfp::Snapshot &s) override
+    {
+        s.value(cachedSample);
+        s.value(sampleOffset);
+        s.value(outputValue);
+    }
 };
 
 } // namespace reSIDfp
@@ -0,0 +1,75 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <vector>
+#include <ctime>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+#include "convolve.h"
+
+/**
+ * Time the available convolution kernels on sinc lengths
+ * typical of the two pass resampler.
+ */
+int main(int argc, const char* argv[])
+{
+    const int LENGTHS[] = { 31, 63, 125, 255 };
+    const int ITERATIONS = 2000000;
+    const int BUFSIZE = 512;
+
+    std::vector<short> samples(BUFSIZE);
+    std::vector<short> sinc(BUFSIZE);
+
+    srand(1);
+    for (int i = 0; i < BUFSIZE; i++)
+    {
+        samples[i] = static_cast<short>(rand() - RAND_MAX / 2);
+        sinc[i] = static_cast<short>((rand() & 511) - 256);
+    }
+
+    const std::vector<reSIDfp::convolve_kernel_t> &kernels = reSIDfp::convolveKernels();
+
+    for (size_t l = 0; l < sizeof(LENGTHS) / sizeof(LENGTHS[0]); l++)
+    {
+        const int length = LENGTHS[l];
+
+        for (std::vector<reSIDfp::convolve_kernel_t>::const_iterator it = kernels.begin(); it != kernels.end(); ++it)
+        {
+            int result = 0;
+            clock_t start = clock();
+
+            for (int i = 0; i < ITERATIONS; i++)
+            {
+                // Walk the sample buffer to defeat alignment
+                const int offset = i & 127;
+                result += (*it).convolve(&samples[offset], &sinc[0], length);
+            }
+
+            clock_t end = clock();
+
+            const double ns = (end - start) * 1e9 / CLOCKS_PER_SEC / ITERATIONS;
+            std::cout << std::setw(4) << length << " taps " << std::setw(6) << (*it).name
+                << " " << std::fixed << std::setprecision(2) << ns << " ns/call"
+                << " (checksum " << result << ")" << std::endl;
+        }
+    }
+}
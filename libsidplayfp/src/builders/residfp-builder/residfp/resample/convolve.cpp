@@ -0,0 +1,231 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "convolve.h"
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_MMINTRIN_H
+#  include <mmintrin.h>
+#endif
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+#  include <immintrin.h>
+#endif
+
+namespace reSIDfp
+{
+
+/**
+ * Round the sum of the products and scale it down to 16 bit.
+ */
+inline int scale(int out)
+{
+    return (out + (1 << 14)) >> 15;
+}
+
+/**
+ * Portable kernel, simple enough for the compiler to auto-vectorize.
+ */
+int dotProductPortable(const short* a, const short* b, int bLength)
+{
+    int out = 0;
+
+    for (int i = 0; i < bLength; i++)
+    {
+        out += a[i] * b[i];
+    }
+
+    return out;
+}
+
+int convolvePortable(const short* a, const short* b, int bLength)
+{
+    return scale(dotProductPortable(a, b, bLength));
+}
+
+#ifdef HAVE_MMINTRIN_H
+int dotProductMMX(const short* a, const short* b, int bLength)
+{
+    __m64 acc = _mm_setzero_si64();
+
+    const int n = bLength / 4;
+
+    for (int i = 0; i < n; i++)
+    {
+        const __m64 tmp = _mm_madd_pi16(*(__m64*)a, *(__m64*)b);
+        acc = _mm_add_pi32(acc, tmp);
+        a += 4;
+        b += 4;
+    }
+
+    int out = _mm_cvtsi64_si32(acc) + _mm_cvtsi64_si32(_mm_srli_si64(acc, 32));
+    _mm_empty();
+
+    bLength &= 3;
+
+    for (int i = 0; i < bLength; i++)
+    {
+        out += *a++ * *b++;
+    }
+
+    return out;
+}
+
+int convolveMMX(const short* a, const short* b, int bLength)
+{
+    return scale(dotProductMMX(a, b, bLength));
+}
+#endif
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+__attribute__((target("sse2")))
+int dotProductSSE2(const short* a, const short* b, int bLength)
+{
+    __m128i acc = _mm_setzero_si128();
+
+    const int n = bLength / 8;
+
+    for (int i = 0; i < n; i++)
+    {
+        const __m128i tmp = _mm_madd_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+        acc = _mm_add_epi32(acc, tmp);
+        a += 8;
+        b += 8;
+    }
+
+    // Horizontal sum of the four partial sums
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    int out = _mm_cvtsi128_si32(acc);
+
+    bLength &= 7;
+
+    for (int i = 0; i < bLength; i++)
+    {
+        out += *a++ * *b++;
+    }
+
+    return out;
+}
+
+__attribute__((target("sse2")))
+int convolveSSE2(const short* a, const short* b, int bLength)
+{
+    return scale(dotProductSSE2(a, b, bLength));
+}
+
+__attribute__((target("avx2")))
+int dotProductAVX2(const short* a, const short* b, int bLength)
+{
+    __m256i acc = _mm256_setzero_si256();
+
+    const int n = bLength / 16;
+
+    for (int i = 0; i < n; i++)
+    {
+        const __m256i tmp = _mm256_madd_epi16(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));
+        acc = _mm256_add_epi32(acc, tmp);
+        a += 16;
+        b += 16;
+    }
+
+    // Fold the remaining 8 to 15 taps into the lower half
+    __m128i acc128 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+
+    if (bLength & 8)
+    {
+        const __m128i tmp = _mm_madd_epi16(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(a)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(b)));
+        acc128 = _mm_add_epi32(acc128, tmp);
+        a += 8;
+        b += 8;
+    }
+
+    // Horizontal sum of the four partial sums
+    acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, _MM_SHUFFLE(2, 3, 0, 1)));
+    int out = _mm_cvtsi128_si32(acc128);
+
+    bLength &= 7;
+
+    for (int i = 0; i < bLength; i++)
+    {
+        out += *a++ * *b++;
+    }
+
+    return out;
+}
+
+__attribute__((target("avx2")))
+int convolveAVX2(const short* a, const short* b, int bLength)
+{
+    return scale(dotProductAVX2(a, b, bLength));
+}
+#endif
+
+/**
+ * Build the list of the kernels supported by the CPU.
+ */
+std::vector<convolve_kernel_t> detectKernels()
+{
+    std::vector<convolve_kernel_t> kernels;
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        const convolve_kernel_t avx2 = { "AVX2", convolveAVX2, dotProductAVX2 };
+        kernels.push_back(avx2);
+    }
+
+    if (__builtin_cpu_supports("sse2"))
+    {
+        const convolve_kernel_t sse2 = { "SSE2", convolveSSE2, dotProductSSE2 };
+        kernels.push_back(sse2);
+    }
+#endif
+
+#ifdef HAVE_MMINTRIN_H
+    const convolve_kernel_t mmx = { "MMX", convolveMMX, dotProductMMX };
+    kernels.push_back(mmx);
+#endif
+
+    const convolve_kernel_t portable = { "C++", convolvePortable, dotProductPortable };
+    kernels.push_back(portable);
+
+    return kernels;
+}
+
+const std::vector<convolve_kernel_t> &convolveKernels()
+{
+    static const std::vector<convolve_kernel_t> kernels = detectKernels();
+    return kernels;
+}
+
+} // namespace reSIDfp
@@ -0,0 +1,60 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef CONVOLVE_H
+#define CONVOLVE_H
+
+#include <vector>
+
+namespace reSIDfp
+{
+
+/**
+ * Calculate convolution with sample and sinc.
+ *
+ * @param a sample buffer input
+ * @param b sinc buffer
+ * @param bLength length of the sinc buffer
+ * @return convolved result
+ */
+typedef int (*convolve_t)(const short* a, const short* b, int bLength);
+
+/**
+ * A convolution kernel implementation.
+ * All the kernels produce bit exact results.
+ */
+typedef struct
+{
+    const char* name;
+    /// Sum of the products, rounded and scaled down by 2^15
+    convolve_t convolve;
+    /// Plain sum of the products, accumulated in 32 bit
+    convolve_t dotProduct;
+} convolve_kernel_t;
+
+/**
+ * Get the convolution kernels usable on the running CPU,
+ * fastest first. The last one is always the portable C++ kernel.
+ */
+const std::vector<convolve_kernel_t> &convolveKernels();
+
+} // namespace reSIDfp
+
+#endif
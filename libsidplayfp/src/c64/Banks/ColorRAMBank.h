@@ -26,6 +26,7 @@
 #include <cstring>
 
 #include "Bank.h"
+#include "Snapshot.h"
 
 #include "sidcxx11.h"
 
@@ -50,6 +51,11 @@ public:
          memset(ram, 0, sizeof(ram));
     }
 
+    void snapshot(Snapshot &s)
+    {
+        s.bytes(ram, sizeof(ram));
+    }
+
     void poke(uint_least16_t address, uint8_t value) override
     {
         ram[address & 0x3ff] = value & 0xf;
@@ -27,6 +27,7 @@
 
 #include "Bank.h"
 #include "c64/CPU/opcodes.h"
+#include "Snapshot.h"
 
 #include "sidcxx11.h"
 
@@ -122,6 +123,14 @@ public:
         resetVectorHi = getVal(0xfffd);
     }
 
+    /**
+     * Save or restore the patched Reset Vector.
+     */
+    void snapshot(Snapshot &s)
+    {
+        s.bytes(getPtr(0xfffc), 2);
+    }
+
     void reset()
     {
         // Restore original Reset Vector
@@ -163,6 +172,15 @@ public:
         memcpy(subTune, getPtr(0xbf53), sizeof(subTune));
     }
 
+    /**
+     * Save or restore the patched BASIC Warm Start.
+     */
+    void snapshot(Snapshot &s)
+    {
+        s.bytes(getPtr(0xa7ae), sizeof(trap));
+        s.bytes(getPtr(0xbf53), sizeof(subTune));
+    }
+
     void reset()
     {
         // Restore original BASIC Warm Start
@@ -0,0 +1,123 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef WATCHBANK_H
+#define WATCHBANK_H
+
+#include <stdint.h>
+
+#include "Bank.h"
+#include "Event.h"
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+/**
+ * Follows the CPU reads to run an event when an instruction
+ * is executed from a given address.
+ *
+ * While active it takes the place of the whole CPU read map and
+ * forwards each read to the bank mapped by the MMU, so machines
+ * which are not watched do not pay for it.
+ * Every instruction reads the byte after its opcode on its second cycle,
+ * so the event runs on a read of address + 1 right after a read of address.
+ * This skips the throw-away reads of the opcode made by an implied
+ * instruction or an RTS just before the watched address.
+ */
+class WatchBank final : public Bank
+{
+private:
+    /// CPU read memory mapping in 4k chunks, as set up by the MMU
+    Bank* readMap[16];
+
+    Event *event;
+
+    uint_least16_t address;
+
+    /// The last read was from the watched address
+    bool watched;
+
+public:
+    WatchBank() :
+        event(nullptr),
+        address(0),
+        watched(false) {}
+
+    bool active() const { return event != nullptr; }
+
+    /**
+     * Set the event to run, nullptr to disable.
+     * Remove the bank from the read map before changing it.
+     */
+    void set(Event *newEvent, uint_least16_t newAddress)
+    {
+        event = newEvent;
+        address = newAddress;
+        watched = false;
+    }
+
+    /**
+     * Take the place of the banks in the CPU read map.
+     * Entries which already point to this bank are kept.
+     */
+    void install(Bank* map[16])
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            if (map[i] != this)
+            {
+                readMap[i] = map[i];
+                map[i] = this;
+            }
+        }
+    }
+
+    /**
+     * Put back the banks in the CPU read map.
+     */
+    void remove(Bank* map[16])
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            map[i] = readMap[i];
+        }
+    }
+
+    /**
+     * Only installed in the read map.
+     */
+    void poke(uint_least16_t, uint8_t) override {}
+
+    uint8_t peek(uint_least16_t addr) override
+    {
+        if (watched && addr == ((address + 1) & 0xffff))
+            event->event();
+
+        watched = addr == address;
+
+        return readMap[addr >> 12]->peek(addr);
+    }
+};
+
+}
+
+#endif
@@ -29,6 +29,7 @@
 #include "SystemRAMBank.h"
 
 #include "Event.h"
+#include "Snapshot.h"
 
 #include "sidcxx11.h"
 
@@ -127,6 +128,13 @@ public:
         dataSet = value & (1 << Bit);
         isFallingOff = true;
     }
+
+    void snapshot(Snapshot &s)
+    {
+        s.value(dataSetClk);
+        s.value(isFallingOff);
+        s.value(dataSet);
+    }
 };
 
 /**
@@ -210,6 +218,20 @@ public:
         updateCpuPort();
     }
 
+    /**
+     * Save or restore the processor port.
+     * The PLA lines are restored by the MMU.
+     */
+    void snapshot(Snapshot &s)
+    {
+        dataBit6.snapshot(s);
+        dataBit7.snapshot(s);
+        s.value(dir);
+        s.value(data);
+        s.value(dataRead);
+        s.value(procPortPins);
+    }
+
     uint8_t peek(uint_least16_t address) override
     {
         switch (address)
@@ -52,6 +52,13 @@ public:
         buffered = false;
     }
 
+    void snapshot(Snapshot &s)
+    {
+        s.value(count);
+        s.value(buffered);
+        s.value(out);
+    }
+
     void setBuffered() { buffered = true; }
 
     void handle(uint8_t serialDataReg)
@@ -25,9 +25,12 @@
 
 #include "Event.h"
 #include "EventScheduler.h"
+#include "Snapshot.h"
 
 #include <stdint.h>
 
+#include <vector>
+
 #include "sidcxx11.h"
 
 namespace libsidplayfp
@@ -124,6 +127,20 @@ public:
      *
      * @param interruptMask control mask bits
      */
+    /**
+     * Get the events of the interrupt source, see EventScheduler::snapshot.
+     */
+    void events(std::vector<Event*> &list) { list.push_back(this); }
+
+    /**
+     * Save or restore the interrupt state.
+     */
+    virtual void snapshot(Snapshot &s)
+    {
+        s.value(icr);
+        s.value(idr);
+    }
+
     void set(uint8_t interruptMask)
     {
         if (interruptMask & 0x80)
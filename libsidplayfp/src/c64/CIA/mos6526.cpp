@@ -25,6 +25,7 @@
 
 #include <cstring>
 
+#include "Snapshot.h"
 #include "sidendian.h"
 
 namespace libsidplayfp
@@ -183,6 +184,28 @@ void MOS6526::reset()
     eventScheduler.cancel(bTickEvent);
 }
 
+void MOS6526::events(std::vector<Event*> &list)
+{
+    timerA.events(list);
+    timerB.events(list);
+    interruptSource->events(list);
+    tod.events(list);
+    list.push_back(&bTickEvent);
+}
+
+void MOS6526::snapshot(Snapshot &s)
+{
+    s.bytes(regs, sizeof(regs));
+
+    timerA.snapshot(s);
+    timerB.snapshot(s);
+    interruptSource->snapshot(s);
+    tod.snapshot(s);
+    serialPort.snapshot(s);
+
+    s.value(triggerScheduled);
+}
+
 uint8_t MOS6526::read(uint_least8_t addr)
 {
     addr &= 0x0f;
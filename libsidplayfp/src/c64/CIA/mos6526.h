@@ -161,6 +161,12 @@ public:
     void event() override;
 
     void reset() override;
+
+    void snapshot(Snapshot &s) override
+    {
+        InterruptSource::snapshot(s);
+        s.value(scheduled);
+    }
 };
 
 /**
@@ -299,12 +305,30 @@ public:
      */
     static const char *credits();
 
+    /**
+     * Get the events of the CIA, see EventScheduler::snapshot.
+     */
+    void events(std::vector<Event*> &list);
+
+    /**
+     * Save or restore the CIA state.
+     */
+    virtual void snapshot(Snapshot &s);
+
     /**
      * Set day-of-time event occurence of rate.
      *
      * @param clock
      */
     void setDayOfTimeRate(unsigned int clock) { tod.setPeriod(clock); }
+
+    /**
+     * Get the last value written to a register,
+     * e.g. a timer latch, for state inspection.
+     *
+     * @param addr the register
+     */
+    uint8_t lastWrite(uint_least8_t addr) const { return regs[addr & 0x0f]; }
 };
 
 }
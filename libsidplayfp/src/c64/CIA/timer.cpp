@@ -22,6 +22,7 @@
 
 #include "timer.h"
 
+#include "Snapshot.h"
 #include "sidendian.h"
 
 namespace libsidplayfp
@@ -139,6 +140,22 @@ void Timer::reset()
     eventScheduler.schedule(*this, 1, EVENT_CLOCK_PHI1);
 }
 
+void Timer::events(std::vector<Event*> &list)
+{
+    list.push_back(this);
+    list.push_back(&m_cycleSkippingEvent);
+}
+
+void Timer::snapshot(Snapshot &s)
+{
+    s.value(ciaEventPauseTime);
+    s.value(pbToggle);
+    s.value(timer);
+    s.value(latch);
+    s.value(lastControlValue);
+    s.value(state);
+}
+
 void Timer::latchLo(uint8_t data)
 {
     endian_16lo8(latch, data);
@@ -35,6 +35,7 @@ namespace libsidplayfp
 {
 
 class MOS6526;
+class Snapshot;
 
 /**
  * This is the base class for the MOS6526 timers.
@@ -173,6 +174,16 @@ public:
      */
     void reset();
 
+    /**
+     * Get the events of the timer, see EventScheduler::snapshot.
+     */
+    void events(std::vector<Event*> &list);
+
+    /**
+     * Save or restore the timer state.
+     */
+    void snapshot(Snapshot &s);
+
     /**
      * Set low byte of Timer start value (Latch).
      *
@@ -26,6 +26,7 @@
 #include <cstring>
 
 #include "mos6526.h"
+#include "Snapshot.h"
 
 namespace libsidplayfp
 {
@@ -45,6 +46,16 @@ void Tod::reset()
     eventScheduler.schedule(*this, 0, EVENT_CLOCK_PHI1);
 }
 
+void Tod::snapshot(Snapshot &s)
+{
+    s.value(cycles);
+    s.value(isLatched);
+    s.value(isStopped);
+    s.bytes(clock, sizeof(clock));
+    s.bytes(latch, sizeof(latch));
+    s.bytes(alarm, sizeof(alarm));
+}
+
 uint8_t Tod::read(uint_least8_t reg)
 {
     // TOD clock is latched by reading Hours, and released
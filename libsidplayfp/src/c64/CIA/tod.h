@@ -32,6 +32,7 @@ namespace libsidplayfp
 {
 
 class MOS6526;
+class Snapshot;
 
 /**
  * TOD implementation taken from Vice.
@@ -87,6 +88,16 @@ public:
      */
     void reset();
 
+    /**
+     * Get the events of the clock, see EventScheduler::snapshot.
+     */
+    void events(std::vector<Event*> &list) { list.push_back(this); }
+
+    /**
+     * Save or restore the clock state.
+     */
+    void snapshot(Snapshot &s);
+
     /**
      * Read TOD register.
      *
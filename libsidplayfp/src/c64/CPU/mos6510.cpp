@@ -23,6 +23,7 @@
 #include "mos6510.h"
 
 #include "Event.h"
+#include "Snapshot.h"
 #include "sidendian.h"
 
 #include "opcodes.h"
@@ -2233,6 +2234,42 @@ void MOS6510::reset()
     Register_ProgramCounter = Cycle_EffectiveAddress;
 }
 
+void MOS6510::events(std::vector<Event*> &list)
+{
+    list.push_back(&m_nosteal);
+    list.push_back(&m_steal);
+}
+
+void MOS6510::snapshot(Snapshot &s)
+{
+    s.value(cycleCount);
+    s.value(interruptCycle);
+    s.value(irqAssertedOnPin);
+    s.value(nmiFlag);
+    s.value(rstFlag);
+    s.value(rdy);
+    s.value(adl_carry);
+#ifdef CORRECT_SH_INSTRUCTIONS
+    s.value(rdyOnThrowAwayRead);
+#endif
+
+    uint8_t sr = flags.get();
+    s.value(sr);
+    flags.set(sr);
+
+    s.value(Register_ProgramCounter);
+    s.value(Cycle_EffectiveAddress);
+    s.value(Cycle_Pointer);
+    s.value(Cycle_Data);
+    s.value(Register_StackPointer);
+    s.value(Register_Accumulator);
+    s.value(Register_X);
+    s.value(Register_Y);
+
+    if (cycleCount < 0 || cycleCount >= (0x101 << 3))
+        s.fail();
+}
+
 /**
  * Module Credits.
  */
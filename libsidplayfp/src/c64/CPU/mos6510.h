@@ -26,6 +26,8 @@
 #include <stdint.h>
 #include <cstdio>
 
+#include <vector>
+
 #include "flags.h"
 #include "EventCallback.h"
 #include "EventScheduler.h"
@@ -39,6 +41,8 @@ class EventContext;
 namespace libsidplayfp
 {
 
+class Snapshot;
+
 #ifdef DEBUG
 class MOS6510;
 
@@ -326,6 +330,30 @@ public:
     void debug(bool enable, FILE *out);
     void setRDY(bool newRDY);
 
+    /**
+     * Get the events of the CPU, see EventScheduler::snapshot.
+     */
+    void events(std::vector<Event*> &list);
+
+    /**
+     * Save or restore the CPU state.
+     */
+    void snapshot(Snapshot &s);
+
+    /**
+     * Get the registers packed as PC, SP, A, X, Y and status
+     * from the most significant byte down, for state inspection.
+     */
+    uint_least64_t getRegisters() const
+    {
+        return (static_cast<uint_least64_t>(Register_ProgramCounter) << 40)
+            | (static_cast<uint_least64_t>(Register_StackPointer) << 32)
+            | (static_cast<uint_least64_t>(Register_Accumulator) << 24)
+            | (static_cast<uint_least64_t>(Register_X) << 16)
+            | (static_cast<uint_least64_t>(Register_Y) << 8)
+            | flags.get();
+    }
+
     // Non-standard functions
     void triggerRST();
     void triggerNMI();
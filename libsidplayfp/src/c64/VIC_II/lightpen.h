@@ -24,6 +24,8 @@
 #ifndef LIGHTPEN_H
 #define LIGHTPEN_H
 
+#include "Snapshot.h"
+
 namespace libsidplayfp
 {
 
@@ -72,6 +74,13 @@ public:
         isTriggered = false;
     }
 
+    void snapshot(Snapshot &s)
+    {
+        s.value(lpx);
+        s.value(lpy);
+        s.value(isTriggered);
+    }
+
     /**
      * Return the low byte of x coordinate.
      */
@@ -94,6 +94,36 @@ void MOS656X::reset()
     eventScheduler.schedule(*this, 0, EVENT_CLOCK_PHI1);
 }
 
+void MOS656X::events(std::vector<Event*> &list)
+{
+    list.push_back(this);
+    list.push_back(&badLineStateChangeEvent);
+    list.push_back(&rasterYIRQEdgeDetectorEvent);
+}
+
+void MOS656X::snapshot(Snapshot &s)
+{
+    s.value(rasterClk);
+    s.value(lineCycle);
+    s.value(rasterY);
+    s.value(yscroll);
+    s.value(areBadLinesEnabled);
+    s.value(isBadLine);
+    s.value(rasterYIRQCondition);
+    s.value(vblanking);
+    s.value(lpAsserted);
+    s.value(irqFlags);
+    s.value(irqMask);
+
+    lp.snapshot(s);
+    sprites.snapshot(s);
+
+    s.bytes(regs, sizeof(regs));
+
+    if (lineCycle >= cyclesPerLine || rasterY >= maxRasters)
+        s.fail();
+}
+
 void MOS656X::chip(model_t model)
 {
     maxRasters    = modelData[model].rasterLines;
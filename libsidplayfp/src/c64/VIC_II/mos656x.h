@@ -330,6 +330,11 @@ public:
      */
     void chip(model_t model);
 
+    /**
+     * Get the length of a frame in cycles.
+     */
+    unsigned int getCyclesPerFrame() const { return cyclesPerLine * maxRasters; }
+
     /**
      * Trigger the lightpen. Sets the lightpen usage flag.
      */
@@ -345,6 +350,16 @@ public:
      */
     void reset();
 
+    /**
+     * Get the events of the VIC, see EventScheduler::snapshot.
+     */
+    void events(std::vector<Event*> &list);
+
+    /**
+     * Save or restore the VIC state.
+     */
+    void snapshot(Snapshot &s);
+
     static const char *credits();
 };
 
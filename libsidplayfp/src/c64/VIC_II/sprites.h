@@ -28,6 +28,8 @@
 
 #include <cstring>
 
+#include "Snapshot.h"
+
 #define SPRITES 8
 
 namespace libsidplayfp
@@ -60,6 +62,14 @@ public:
         memset(mc, 0, sizeof(mc));
     }
 
+    void snapshot(Snapshot &s)
+    {
+        s.value(exp_flop);
+        s.value(dma);
+        s.bytes(mc_base, sizeof(mc_base));
+        s.bytes(mc, sizeof(mc));
+    }
+
     /**
      * Update mc values in one pass
      * after the dma has been processed
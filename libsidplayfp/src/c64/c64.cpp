@@ -25,6 +25,7 @@
 #include <algorithm>
 
 #include "c64/VIC_II/mos656x.h"
+#include "Snapshot.h"
 
 namespace libsidplayfp
 {
@@ -119,6 +120,27 @@ void c64::reset()
     oldBAState = true;
 }
 
+void c64::snapshot(Snapshot &s)
+{
+    std::vector<Event*> events;
+    cpu.events(events);
+    cia1.events(events);
+    cia2.events(events);
+    vic.events(events);
+
+    eventScheduler.snapshot(s, events);
+
+    s.value(irqCount);
+    s.value(oldBAState);
+
+    cpu.snapshot(s);
+    cia1.snapshot(s);
+    cia2.snapshot(s);
+    vic.snapshot(s);
+    colorRAMBank.snapshot(s);
+    mmu.snapshot(s);
+}
+
 void c64::setModel(model_t model)
 {
     cpuFrequency = getCpuFreq(model);
@@ -53,6 +53,7 @@ namespace libsidplayfp
 
 class c64sid;
 class sidmemory;
+class Snapshot;
 
 #ifdef PC64_TESTSUITE
 class testEnv
@@ -224,6 +225,15 @@ public:
     void reset();
     void resetCpu() { cpu.reset(); }
 
+    /**
+     * Save or restore the state of the machine,
+     * the SIDs excluded.
+     * The model and the ROMs must be the same when restoring.
+     *
+     * @param s the snapshot
+     */
+    void snapshot(Snapshot &s);
+
     /**
      * Set the c64 model.
      */
@@ -276,6 +286,29 @@ public:
     sidmemory& getMemInterface() { return mmu; }
 
     uint_least16_t getCia1TimerA() const { return cia1.getTimerA(); }
+
+    /**
+     * Get the last values written to the CIA registers, see MOS6526::lastWrite.
+     */
+    //@{
+    uint8_t getCia1Register(uint_least8_t addr) const { return cia1.lastWrite(addr); }
+    uint8_t getCia2Register(uint_least8_t addr) const { return cia2.lastWrite(addr); }
+    //@}
+
+    /**
+     * Run an event on each instruction executed from an address, see MMU::setWatch.
+     */
+    void setCpuWatch(Event *event, uint_least16_t address) { mmu.setWatch(event, address); }
+
+    /**
+     * Get the CPU registers, see MOS6510::getRegisters.
+     */
+    uint_least64_t getCpuRegisters() const { return cpu.getRegisters(); }
+
+    /**
+     * Get the length of a video frame in cycles.
+     */
+    unsigned int getCyclesPerFrame() const { return vic.getCyclesPerFrame(); }
 };
 
 void c64::interruptIRQ(bool state)
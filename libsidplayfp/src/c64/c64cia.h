@@ -88,6 +88,12 @@ public:
         MOS6526::reset();
     }
 
+    void snapshot(Snapshot &s) override
+    {
+        MOS6526::snapshot(s);
+        s.value(last_ta);
+    }
+
     uint_least16_t getTimerA() const { return last_ta; }
 };
 
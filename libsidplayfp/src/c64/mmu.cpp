@@ -24,6 +24,7 @@
 
 #include "Banks/Bank.h"
 #include "Banks/IOBank.h"
+#include "Snapshot.h"
 
 namespace libsidplayfp
 {
@@ -71,6 +72,20 @@ void MMU::updateMappingPHI2()
         cpuReadMap[0xd] = (!charen && (loram || hiram)) ? (Bank*)&characterRomBank : &ramBank;
         cpuWriteMap[0xd] = &ramBank;
     }
+
+    if (watchBank.active())
+        watchBank.install(cpuReadMap);
+}
+
+void MMU::setWatch(Event *event, uint_least16_t address)
+{
+    if (watchBank.active())
+        watchBank.remove(cpuReadMap);
+
+    watchBank.set(event, address);
+
+    if (watchBank.active())
+        watchBank.install(cpuReadMap);
 }
 
 void MMU::reset()
@@ -89,4 +104,20 @@ void MMU::reset()
     updateMappingPHI2();
 }
 
+void MMU::snapshot(Snapshot &s)
+{
+    s.bytes(ramBank.ram, sizeof(ramBank.ram));
+    zeroRAMBank.snapshot(s);
+
+    kernalRomBank.snapshot(s);
+    basicRomBank.snapshot(s);
+
+    s.value(loram);
+    s.value(hiram);
+    s.value(charen);
+
+    if (s.loading())
+        updateMappingPHI2();
+}
+
 }
@@ -32,6 +32,7 @@
 #include "Banks/SystemRAMBank.h"
 #include "Banks/SystemROMBanks.h"
 #include "Banks/ZeroRAMBank.h"
+#include "Banks/WatchBank.h"
 
 #include "sidcxx11.h"
 
@@ -78,6 +79,9 @@ private:
     /// RAM bank 0
     ZeroRAMBank zeroRAMBank;
 
+    /// Follows the CPU reads when a watch is set
+    WatchBank watchBank;
+
 private:
     void setCpuPort(uint8_t state) override;
     uint8_t getLastReadByte() const override { return 0; }
@@ -91,6 +95,22 @@ public:
 
     void reset();
 
+    /**
+     * Save or restore the RAM, the processor port
+     * and the ROM patches.
+     */
+    void snapshot(Snapshot &s);
+
+    /**
+     * Run an event whenever the CPU executes an instruction
+     * from the given address, see WatchBank.
+     * The CPU reads only go through the watch while one is set.
+     *
+     * @param event the event to run, nullptr to disable
+     * @param address the address to watch
+     */
+    void setWatch(Event *event, uint_least16_t address);
+
     void setRoms(const uint8_t* kernal, const uint8_t* basic, const uint8_t* character)
     {
         kernalRomBank.set(kernal);
@@ -22,10 +22,10 @@
 
 #include "mixer.h"
 
-#include <cassert>
 #include <algorithm>
 
 #include "sidemu.h"
+#include "Snapshot.h"
 
 
 namespace libsidplayfp
@@ -47,9 +47,9 @@ class bufferMove
 {
 public:
     bufferMove(int p, int s) : pos(p), samples(s) {}
-    void operator()(short *dest)
+    void operator()(float *dest)
     {
-        const short* src = dest + pos;
+        const float* src = dest + pos;
         for (int j = 0; j < samples; j++)
         {
             dest[j] = src[j];
@@ -61,6 +61,19 @@ private:
     int samples;
 };
 
+Mixer::Mixer() :
+    oldRandomValue(0),
+    m_randomSeed(0),
+    m_fastForwardFactor(1),
+    m_sampleBuffer(nullptr),
+    m_floatBuffer(nullptr),
+    m_sampleCount(0),
+    m_bufferStart(0),
+    m_stereo(false)
+{
+    m_mix.push_back(&Mixer::mono<1>);
+}
+
 void Mixer::clockChips()
 {
     std::for_each(m_chips.begin(), m_chips.end(), clockChip);
@@ -69,18 +82,57 @@ void Mixer::clockChips()
 void Mixer::resetBufs()
 {
     std::for_each(m_chips.begin(), m_chips.end(), bufferPos(0));
+    m_bufferStart = 0;
 }
 
-void Mixer::doMix()
+bool Mixer::snapshot(Snapshot &s)
+{
+    for (std::vector<sidemu*>::const_iterator it = m_chips.begin(); it != m_chips.end(); ++it)
+    {
+        if (!(*it)->snapshot(s))
+            return false;
+    }
+
+    s.value(m_bufferStart);
+
+    if (s.loading() && (m_bufferStart < 0
+        || (!m_chips.empty() && m_bufferStart > m_chips.front()->bufferpos())))
+    {
+        m_bufferStart = 0;
+        s.fail();
+    }
+
+    s.value(oldRandomValue);
+    s.value(m_randomSeed);
+
+    return true;
+}
+
+void Mixer::putSample(short *&buf, float sample, float dither)
 {
-    short *buf = m_sampleBuffer + m_sampleIndex;
+    int_least32_t tmp = static_cast<int_least32_t>(sample + dither);
+
+    // Chip output is not clipped, do it only once here
+    if (tmp < -32768) tmp = -32768;
+    if (tmp > 32767) tmp = 32767;
 
+    *buf++ = static_cast<short>(tmp);
+}
+
+void Mixer::putSample(float *&buf, float sample, float)
+{
+    *buf++ = sample * (1.f / 32768.f);
+}
+
+template <typename T>
+void Mixer::mix(T *buf)
+{
     // extract buffer info now that the SID is updated.
     // clock() may update bufferpos.
     // NB: if more than one chip exists, their bufferpos is identical to first chip's.
     const int sampleCount = m_chips.front()->bufferpos();
 
-    int i = 0;
+    int i = m_bufferStart;
     while (i < sampleCount)
     {
         // Handle whatever output the sid has generated so far
@@ -98,35 +150,54 @@ void Mixer::doMix()
         // reduce aliasing during fast forward.
         for (size_t k = 0; k < m_buffers.size(); k++)
         {
-            int_least32_t sample = 0;
-            const short *buffer = m_buffers[k] + i;
+            float sample = 0.f;
+            const float *buffer = m_buffers[k] + i;
             for (int j = 0; j < m_fastForwardFactor; j++)
             {
                 sample += buffer[j];
             }
 
-            m_iSamples[k] = sample / m_fastForwardFactor;
+            m_samples[k] = sample / m_fastForwardFactor;
         }
 
         // increment i to mark we ate some samples, finish the boxcar thing.
         i += m_fastForwardFactor;
 
-        const int dither = triangularDithering();
+        const float ditherValue = dither(buf);
 
         const unsigned int channels = m_stereo ? 2 : 1;
         for (unsigned int ch = 0; ch < channels; ch++)
         {
-            const int_least32_t tmp = ((this->*(m_mix[ch]))() * m_volume[ch] + dither) / VOLUME_MAX;
-            assert(tmp >= -32768 && tmp <= 32767);
-            *buf++ = static_cast<short>(tmp);
+            const float sample = (this->*(m_mix[ch]))() * m_volume[ch] * (1.f / VOLUME_MAX);
+            putSample(buf, sample, ditherValue);
             m_sampleIndex++;
         }
     }
 
-    // move the unhandled data to start of buffer, if any.
-    const int samplesLeft = sampleCount - i;
-    std::for_each(m_buffers.begin(), m_buffers.end(), bufferMove(i, samplesLeft));
-    std::for_each(m_chips.begin(), m_chips.end(), bufferPos(samplesLeft));
+    m_bufferStart = i;
+}
+
+void Mixer::doMix()
+{
+    doMix(sidemu::OUTPUTBUFFERSIZE);
+}
+
+void Mixer::doMix(int room)
+{
+    if (m_floatBuffer != nullptr)
+        mix(m_floatBuffer + m_sampleIndex);
+    else
+        mix(m_sampleBuffer + m_sampleIndex);
+
+    // move the unhandled data to start of buffer, if needed.
+    const int sampleCount = m_chips.front()->bufferpos();
+    if (sampleCount + room > sidemu::OUTPUTBUFFERSIZE)
+    {
+        const int samplesLeft = sampleCount - m_bufferStart;
+        std::for_each(m_buffers.begin(), m_buffers.end(), bufferMove(m_bufferStart, samplesLeft));
+        std::for_each(m_chips.begin(), m_chips.end(), bufferPos(samplesLeft));
+        m_bufferStart = 0;
+    }
 }
 
 void Mixer::begin(short *buffer, uint_least32_t count)
@@ -134,6 +205,15 @@ void Mixer::begin(short *buffer, uint_least32_t count)
     m_sampleIndex  = 0;
     m_sampleCount  = count;
     m_sampleBuffer = buffer;
+    m_floatBuffer  = nullptr;
+}
+
+void Mixer::begin(float *buffer, uint_least32_t count)
+{
+    m_sampleIndex  = 0;
+    m_sampleCount  = count;
+    m_sampleBuffer = nullptr;
+    m_floatBuffer  = buffer;
 }
 
 void Mixer::updateParams()
@@ -168,7 +248,7 @@ void Mixer::addSid(sidemu *chip)
         m_chips.push_back(chip);
         m_buffers.push_back(chip->buffer());
 
-        m_iSamples.resize(m_buffers.size());
+        m_samples.resize(m_buffers.size());
 
         if (m_mix.size() > 0)
             updateParams();
@@ -27,7 +27,6 @@
 #include "sidcxx11.h"
 
 #include <stdint.h>
-#include <cstdlib>
 
 #include <vector>
 
@@ -35,6 +34,7 @@ namespace libsidplayfp
 {
 
 class sidemu;
+class Snapshot;
 
 /**
  * This class implements the mixer.
@@ -55,7 +55,7 @@ public:
     static const int_least32_t C2 = static_cast<int_least32_t>(SQRT_0_5 / (1.0 + SQRT_0_5) * SCALE_FACTOR);
 
 private:
-    typedef int_least32_t (Mixer::*mixer_func_t)() const;
+    typedef float (Mixer::*mixer_func_t)() const;
 
 public:
     /// Maximum allowed volume, must be a power of 2.
@@ -63,21 +63,26 @@ public:
 
 private:
     std::vector<sidemu*> m_chips;
-    std::vector<short*> m_buffers;
+    std::vector<float*> m_buffers;
 
-    std::vector<int_least32_t> m_iSamples;
+    std::vector<float> m_samples;
     std::vector<int_least32_t> m_volume;
 
     std::vector<mixer_func_t> m_mix;
 
     int oldRandomValue;
+    uint_least32_t m_randomSeed;
     int m_fastForwardFactor;
 
-    // Mixer settings
+    // Mixer settings, only one of the output buffers is in use
     short         *m_sampleBuffer;
+    float         *m_floatBuffer;
     uint_least32_t m_sampleCount;
     uint_least32_t m_sampleIndex;
 
+    /// Position of the first chip sample not mixed yet
+    int m_bufferStart;
+
     bool m_stereo;
 
 private:
@@ -86,10 +91,21 @@ private:
     int triangularDithering()
     {
         const int prevValue = oldRandomValue;
-        oldRandomValue = rand() & (VOLUME_MAX-1);
+        // A plain LCG is good enough for dithering and much cheaper than rand()
+        m_randomSeed = m_randomSeed * 1664525 + 1013904223;
+        oldRandomValue = (m_randomSeed >> 16) & (VOLUME_MAX-1);
         return oldRandomValue - prevValue;
     }
 
+    template <typename T>
+    void mix(T *buf);
+
+    float dither(const short*) { return triangularDithering() * (1.f / VOLUME_MAX); }
+    float dither(const float*) { return 0.f; }
+
+    static void putSample(short *&buf, float sample, float dither);
+    static void putSample(float *&buf, float sample, float dither);
+
     /*
      * Channel matrix
      *
@@ -113,41 +129,45 @@ private:
 
     // Mono mixing
     template <int Chips>
-    int_least32_t mono() const
+    float mono() const
     {
-        int_least32_t res = 0;
+        float res = 0.f;
         for (int i = 0; i < Chips; i++)
-            res += m_iSamples[i];
-        return res /= Chips;
+            res += m_samples[i];
+        return res / Chips;
     }
 
     // Stereo mixing
-    int_least32_t stereo_OneChip() const { return m_iSamples[0]; }
+    float stereo_OneChip() const { return m_samples[0]; }
 
-    int_least32_t stereo_ch1_TwoChips() const { return m_iSamples[0]; }
-    int_least32_t stereo_ch2_TwoChips() const { return m_iSamples[1]; }
+    float stereo_ch1_TwoChips() const { return m_samples[0]; }
+    float stereo_ch2_TwoChips() const { return m_samples[1]; }
 
-    int_least32_t stereo_ch1_ThreeChips() const { return (C1*m_iSamples[0] + C2*m_iSamples[1]) / SCALE_FACTOR; }
-    int_least32_t stereo_ch2_ThreeChips() const { return (C2*m_iSamples[1] + C1*m_iSamples[2]) / SCALE_FACTOR; }
+    float stereo_ch1_ThreeChips() const { return (C1*m_samples[0] + C2*m_samples[1]) / SCALE_FACTOR; }
+    float stereo_ch2_ThreeChips() const { return (C2*m_samples[1] + C1*m_samples[2]) / SCALE_FACTOR; }
 
 public:
     /**
      * Create a new mixer.
      */
-    Mixer() :
-        oldRandomValue(0),
-        m_fastForwardFactor(1),
-        m_sampleCount(0),
-        m_stereo(false)
-    {
-        m_mix.push_back(&Mixer::mono<1>);
-    }
+    Mixer();
 
     /**
      * Do the mixing.
+     * The samples that can't be mixed yet are moved
+     * to the start of the chip buffers.
      */
     void doMix();
 
+    /**
+     * Do the mixing, leaving the samples that can't be mixed yet
+     * in place as long as the chip buffers have room after them.
+     *
+     * @param room the number of samples the chips will produce
+     *             before the next mix
+     */
+    void doMix(int room);
+
     /**
      * This clocks the SID chips to the present moment, if they aren't already.
      */
@@ -166,6 +186,16 @@ public:
      */
     void begin(short *buffer, uint_least32_t count);
 
+    /**
+     * Prepare for mixing cycle with float output.
+     * Samples are in the [-1,1] range and are
+     * neither clipped nor dithered.
+     *
+     * @param buffer output buffer
+     * @param count size of the buffer in samples
+     */
+    void begin(float *buffer, uint_least32_t count);
+
     /**
      * Remove all SIDs from the mixer.
      */
@@ -209,6 +239,14 @@ public:
      */
     void setStereo(bool stereo);
 
+    /**
+     * Save or restore the state of the chips and of the dithering.
+     *
+     * @param s the snapshot
+     * @return false if an emulation does not support snapshots
+     */
+    bool snapshot(Snapshot &s);
+
     /**
      * Check if the buffer have been filled.
      */
@@ -29,9 +29,14 @@
 #include "sidemu.h"
 #include "psiddrv.h"
 #include "romCheck.h"
+#include "Snapshot.h"
 
 #include "sidcxx11.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 namespace libsidplayfp
 {
 
@@ -51,6 +56,18 @@ const char ERR_UNSUPPORTED_FREQ[]     = "SIDPLAYER ERROR: Unsupported sampling f
 const char ERR_UNSUPPORTED_SID_ADDR[] = "SIDPLAYER ERROR: Unsupported SID address.";
 const char ERR_UNSUPPORTED_SIZE[]     = "SIDPLAYER ERROR: Size of music data exceeds C64 memory.";
 const char ERR_INVALID_PERCENTAGE[]   = "SIDPLAYER ERROR: Percentage value out of range.";
+const char ERR_NO_SIDS[]              = "SIDPLAYER ERROR: No SID emulation to capture.";
+const char ERR_NO_TUNE[]              = "SIDPLAYER ERROR: No tune loaded.";
+const char ERR_STATE_UNSUPPORTED[]    = "SIDPLAYER ERROR: SID emulation does not support saving the state.";
+const char ERR_STATE_MISMATCH[]       = "SIDPLAYER ERROR: Saved state belongs to a different tune or configuration.";
+const char ERR_STATE_CORRUPT[]        = "SIDPLAYER ERROR: Saved state is corrupt.";
+
+/// Milliseconds of audible clocking before a seek target,
+/// to let the filters and the resampler settle
+const unsigned int SEEK_WARMUP = 100;
+
+/// Identifies the saved states, the last byte is the format version
+const uint8_t STATE_MAGIC[4] = { 'S', 'P', 'S', 1 };
 
 /**
  * Configuration error exception.
@@ -69,7 +86,8 @@ Player::Player() :
     // Set default settings for system
     m_tune(nullptr),
     m_errorString(ERR_NA),
-    m_isPlaying(STOPPED)
+    m_isPlaying(STOPPED),
+    m_renderExcess(0.)
 {
 #ifdef PC64_TESTSUITE
     m_c64.setTestEnv(this);
@@ -119,6 +137,10 @@ bool Player::fastForward(unsigned int percent)
 void Player::initialise()
 {
     m_isPlaying = STOPPED;
+    m_renderExcess = 0.;
+
+    if (m_capture.get() != nullptr)
+        m_capture->reset(0xf);
 
     m_c64.reset();
 
@@ -179,7 +201,28 @@ void Player::run(unsigned int events)
         m_c64.getEventScheduler()->clock();
 }
 
-uint_least32_t Player::play(short *buffer, uint_least32_t count)
+void Player::runUntil(event_clock_t time)
+{
+    EventScheduler &scheduler = *m_c64.getEventScheduler();
+    while (m_isPlaying && scheduler.getTime(EVENT_CLOCK_PHI1) < time)
+        scheduler.clock();
+}
+
+void Player::checkStopping()
+{
+    if (m_isPlaying == STOPPING)
+    {
+        try
+        {
+            initialise();
+        }
+        catch (configError const &) {}
+        m_isPlaying = STOPPED;
+    }
+}
+
+template <typename T>
+uint_least32_t Player::playSamples(T *buffer, uint_least32_t count)
 {
     // Make sure a tune is loaded
     if (m_tune == nullptr)
@@ -231,17 +274,196 @@ uint_least32_t Player::play(short *buffer, uint_least32_t count)
         }
     }
 
-    if (m_isPlaying == STOPPING)
+    checkStopping();
+
+    return count;
+}
+
+uint_least32_t Player::play(short *buffer, uint_least32_t count)
+{
+    return playSamples(buffer, count);
+}
+
+uint_least32_t Player::playFloat(float *buffer, uint_least32_t count)
+{
+    return playSamples(buffer, count);
+}
+
+template <typename T>
+uint_least32_t Player::renderSamples(T *buffer, uint_least32_t count, double cycles)
+{
+    // Make sure a tune is loaded
+    if (m_tune == nullptr)
+        return 0;
+
+    // Start the player loop
+    if (m_isPlaying == STOPPED)
+        m_isPlaying = PLAYING;
+
+    uint_least32_t samples = 0;
+
+    if (m_isPlaying == PLAYING)
+    {
+        EventScheduler &scheduler = *m_c64.getEventScheduler();
+
+        // The machine may stop a bit past the requested time,
+        // the next call takes it into account so that splitting
+        // the rendering in several calls doesn't drift.
+        // Round up so that time() reports the elapsed seconds
+        const double target = scheduler.getTime(EVENT_CLOCK_PHI1) - m_renderExcess + cycles;
+        const event_clock_t end = static_cast<event_clock_t>(std::ceil(target));
+
+        if (m_mixer.getSid(0) != nullptr)
+        {
+            // Run in chunks that fill at most a quarter of the chip buffers,
+            // the samples not mixed yet are moved back only when the rest
+            // of the buffers gets too short for another chunk
+            const event_clock_t chunk = static_cast<event_clock_t>(
+                m_c64.getMainCpuSpeed() * (sidemu::OUTPUTBUFFERSIZE / 4) / m_cfg.frequency);
+            const int room = sidemu::OUTPUTBUFFERSIZE / 4 + 1;
+
+            const bool mix = count && buffer != nullptr;
+
+            m_mixer.begin(buffer, count);
+
+            // Samples left over from the previous call come first,
+            // if they fill up the buffer the emulation doesn't run
+            if (mix)
+                m_mixer.doMix(room);
+
+            for (event_clock_t time = scheduler.getTime(EVENT_CLOCK_PHI1);
+                 m_isPlaying && time < end && (!mix || m_mixer.notFinished()); )
+            {
+                time = std::min(time + chunk, end);
+                runUntil(time);
+
+                m_mixer.clockChips();
+                if (mix)
+                    m_mixer.doMix(room);
+                else
+                    m_mixer.resetBufs();
+            }
+
+            samples = m_mixer.samplesGenerated();
+        }
+        else
+        {
+            // Clock the machine
+            runUntil(end);
+        }
+
+        // Nothing is owed if the emulation stopped early
+        m_renderExcess = std::max(scheduler.getTime(EVENT_CLOCK_PHI1) - target, 0.);
+    }
+
+    checkStopping();
+
+    return samples;
+}
+
+template <typename T>
+uint_least32_t Player::renderTime(T *buffer, uint_least32_t count, unsigned int seconds)
+{
+    const double cpuFreq = m_c64.getMainCpuSpeed();
+
+    uint_least32_t samples = 0;
+    for (unsigned int i = 0; i < seconds; i++)
+    {
+        // Without a buffer only the emulation is clocked
+        if (buffer != nullptr && samples >= count)
+            break;
+
+        samples += renderSamples(buffer ? buffer + samples : nullptr, count - samples, cpuFreq);
+
+        if (!m_isPlaying)
+            break;
+    }
+
+    return samples;
+}
+
+uint_least32_t Player::renderCycles(short *buffer, uint_least32_t count, uint_least32_t cycles)
+{
+    return renderSamples(buffer, count, static_cast<double>(cycles));
+}
+
+uint_least32_t Player::renderCyclesFloat(float *buffer, uint_least32_t count, uint_least32_t cycles)
+{
+    return renderSamples(buffer, count, static_cast<double>(cycles));
+}
+
+uint_least32_t Player::renderSeconds(short *buffer, uint_least32_t count, unsigned int seconds)
+{
+    return renderTime(buffer, count, seconds);
+}
+
+uint_least32_t Player::renderSecondsFloat(float *buffer, uint_least32_t count, unsigned int seconds)
+{
+    return renderTime(buffer, count, seconds);
+}
+
+void Player::skipUntil(event_clock_t time)
+{
+    EventScheduler &scheduler = *m_c64.getEventScheduler();
+
+    for (event_clock_t now = scheduler.getTime(EVENT_CLOCK_PHI1);
+         m_isPlaying && now < time;
+         now = scheduler.getTime(EVENT_CLOCK_PHI1))
+    {
+        renderCycles(nullptr, 0, static_cast<uint_least32_t>(std::min<event_clock_t>(time - now, 0x10000000)));
+    }
+}
+
+bool Player::seek(uint_least32_t milliseconds)
+{
+    const double time = cpuFreq() * milliseconds / 1000.;
+
+    // Round up so that time() reports the requested second
+    const event_clock_t cycles = static_cast<event_clock_t>(std::ceil(time));
+    if (!seekCycles(cycles))
+        return false;
+
+    m_renderExcess += cycles - time;
+    return true;
+}
+
+bool Player::seekCycles(event_clock_t cycles)
+{
+    // Make sure a tune is loaded
+    if (m_tune == nullptr)
+    {
+        m_errorString = ERR_NO_TUNE;
+        return false;
+    }
+
+    // Seeking backwards replays from the start
+    if (cycles < m_c64.getEventScheduler()->getTime(EVENT_CLOCK_PHI1))
     {
         try
         {
             initialise();
         }
-        catch (configError const &) {}
-        m_isPlaying = STOPPED;
+        catch (configError const &e)
+        {
+            m_errorString = e.message();
+            return false;
+        }
     }
 
-    return count;
+    if (m_isPlaying == STOPPED)
+        m_isPlaying = PLAYING;
+
+    const event_clock_t warmup = static_cast<event_clock_t>(cpuFreq() * SEEK_WARMUP / 1000.);
+
+    sidSilent(true);
+    skipUntil(cycles - warmup);
+    sidSilent(false);
+
+    skipUntil(cycles);
+
+    // Rendering continues from the requested time
+    m_renderExcess = static_cast<double>(m_c64.getEventScheduler()->getTime(EVENT_CLOCK_PHI1) - cycles);
+    return true;
 }
 
 void Player::stop()
@@ -447,8 +669,185 @@ SidConfig::sid_model_t getSidModel(SidTuneInfo::model_t sidModel, SidConfig::sid
     return newModel;
 }
 
+bool Player::captureSidWrites(bool enable)
+{
+    if (m_capture.get() != nullptr)
+    {
+        m_capture->end();
+        // Detach from the chips before deleting it
+        sidCapture(nullptr);
+        m_capture.reset();
+    }
+
+    if (!enable)
+        return true;
+
+    if (m_sidModels.empty())
+    {
+        m_errorString = ERR_NO_SIDS;
+        return false;
+    }
+
+    m_captureStream.clear();
+    m_capture.reset(new SidCapture(m_captureStream, *m_c64.getEventScheduler(), cpuFreq(), m_sidModels));
+    sidCapture(m_capture.get());
+    return true;
+}
+
+uint_least32_t Player::capturedSidWrites(uint_least8_t *stream, uint_least32_t size) const
+{
+    // Only copy if it fits, so the size can be queried first
+    if (stream != nullptr && m_captureStream.size() <= size)
+        std::copy(m_captureStream.begin(), m_captureStream.end(), stream);
+
+    return static_cast<uint_least32_t>(m_captureStream.size());
+}
+
+bool Player::snapshotHeader(Snapshot &s)
+{
+    struct header_t
+    {
+        uint8_t magic[4];
+        char md5[SidTune::MD5_LENGTH + 1];
+        unsigned int song;
+        double cpuFreq;
+        int frequency;
+        SidConfig::sampling_method_t sampling;
+        bool fastSampling;
+        uint32_t sids;
+        SidConfig::sid_model_t models[3];
+    };
+
+    header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, STATE_MAGIC, sizeof(STATE_MAGIC));
+    m_tune->createMD5(header.md5);
+    header.song = m_tune->getInfo()->currentSong();
+    header.cpuFreq = cpuFreq();
+    header.frequency = m_cfg.frequency;
+    header.sampling = m_cfg.samplingMethod;
+    header.fastSampling = m_cfg.fastSampling;
+    header.sids = static_cast<uint32_t>(m_sidModels.size());
+    std::copy(m_sidModels.begin(), m_sidModels.begin() + std::min<size_t>(m_sidModels.size(), 3), header.models);
+
+    if (!s.loading())
+    {
+        s.value(header);
+        return true;
+    }
+
+    header_t saved;
+    s.value(saved);
+    return s.ok() && memcmp(&saved, &header, sizeof(header)) == 0;
+}
+
+uint_least32_t Player::saveState(uint_least8_t *state, uint_least32_t size)
+{
+    if (m_tune == nullptr)
+    {
+        m_errorString = ERR_NO_TUNE;
+        return 0;
+    }
+
+    std::vector<uint_least8_t> buffer;
+    Snapshot s(buffer);
+
+    snapshotHeader(s);
+    m_c64.snapshot(s);
+
+    if (!m_mixer.snapshot(s))
+    {
+        m_errorString = ERR_STATE_UNSUPPORTED;
+        return 0;
+    }
+
+    s.value(m_renderExcess);
+
+    if (!s.ok())
+    {
+        m_errorString = ERR_STATE_CORRUPT;
+        return 0;
+    }
+
+    // Only copy if it fits, so the size can be queried first
+    if (state != nullptr && buffer.size() <= size)
+        std::copy(buffer.begin(), buffer.end(), state);
+
+    return static_cast<uint_least32_t>(buffer.size());
+}
+
+bool Player::restoreState(const uint_least8_t *state, uint_least32_t size)
+{
+    if (m_tune == nullptr)
+    {
+        m_errorString = ERR_NO_TUNE;
+        return false;
+    }
+
+    Snapshot s(state, size);
+
+    if (!snapshotHeader(s))
+    {
+        m_errorString = ERR_STATE_MISMATCH;
+        return false;
+    }
+
+    // A capture can't continue across the jump
+    captureSidWrites(false);
+
+    m_c64.snapshot(s);
+    const bool supported = m_mixer.snapshot(s);
+    if (supported)
+        s.value(m_renderExcess);
+
+    if (!supported || !s.ok() || s.remaining() != 0)
+    {
+        // Don't leave a half restored machine around
+        try
+        {
+            initialise();
+        }
+        catch (configError const &) {}
+
+        m_errorString = supported ? ERR_STATE_CORRUPT : ERR_STATE_UNSUPPORTED;
+        return false;
+    }
+
+    m_isPlaying = PLAYING;
+    return true;
+}
+
+void Player::sidCapture(SidCapture *capture)
+{
+    for (unsigned int i = 0; ; i++)
+    {
+        sidemu *s = m_mixer.getSid(i);
+        if (s == nullptr)
+            break;
+
+        s->capture(capture, i);
+    }
+}
+
+void Player::sidSilent(bool enable)
+{
+    for (unsigned int i = 0; ; i++)
+    {
+        sidemu *s = m_mixer.getSid(i);
+        if (s == nullptr)
+            break;
+
+        s->silent(enable);
+    }
+}
+
 void Player::sidRelease()
 {
+    // The capture doesn't survive a change of the chips
+    captureSidWrites(false);
+
+    m_sidModels.clear();
+
     m_c64.clearSids();
 
     for (unsigned int i = 0; ; i++)
@@ -483,6 +882,7 @@ void Player::sidCreate(sidbuilder *builder, SidConfig::sid_model_t defaultModel,
 
         m_c64.setBaseSid(s);
         m_mixer.addSid(s);
+        m_sidModels.push_back(userModel);
 
         // Setup extra SIDs if needed
         if (extraSidAddresses.size() != 0)
@@ -507,6 +907,7 @@ void Player::sidCreate(sidbuilder *builder, SidConfig::sid_model_t defaultModel,
                     throw configError(ERR_UNSUPPORTED_SID_ADDR);
 
                 m_mixer.addSid(s);
+                m_sidModels.push_back(userModel);
             }
         }
     }
@@ -33,6 +33,7 @@
 
 #include "SidInfoImpl.h"
 #include "mixer.h"
+#include "SidCapture.h"
 #include "c64/c64.h"
 
 #ifdef HAVE_CONFIG_H
@@ -43,6 +44,7 @@
 #  include <string>
 #endif
 
+#include <memory>
 #include <vector>
 
 class SidTune;
@@ -53,6 +55,8 @@ class sidbuilder;
 namespace libsidplayfp
 {
 
+class Snapshot;
+
 class Player
 #ifdef PC64_TESTSUITE
   : public testEnv
@@ -90,6 +94,18 @@ private:
     /// PAL/NTSC switch value
     uint8_t videoSwitch;
 
+    /// Models of the created SIDs
+    std::vector<SidConfig::sid_model_t> m_sidModels;
+
+    /// Stream of the captured SID writes
+    std::vector<uint_least8_t> m_captureStream;
+
+    /// Capture of the SID writes, referenced by the chips while running
+    std::unique_ptr<SidCapture> m_capture;
+
+    /// Cycles run by the last render beyond the exact requested time
+    double m_renderExcess;
+
 private:
     /**
      * Get the C64 model for the current loaded tune.
@@ -125,17 +141,85 @@ private:
      * @param cpuFreq the CPU clock frequency
      * @param frequency the output sampling frequency
      * @param sampling the sampling method to use
-     * @param fastSampling true to enable fast low quality resampling (only for reSID)
+     * @param fastSampling true to enable fast low quality resampling
      */
     void sidParams(double cpuFreq, int frequency,
                     SidConfig::sampling_method_t sampling, bool fastSampling);
 
+    /**
+     * Attach the capture to the SIDs, or detach it if nullptr.
+     */
+    void sidCapture(SidCapture *capture);
+
 #ifdef PC64_TESTSUITE
     void load(const char *file);
 #endif
 
     inline void run(unsigned int events);
 
+    /**
+     * Run the machine up to the specified time.
+     *
+     * @param time the target time in PHI1 cycles
+     */
+    inline void runUntil(event_clock_t time);
+
+    /**
+     * Run the emulation up to the specified time, discarding the output.
+     *
+     * @param time the target time in PHI1 cycles
+     */
+    void skipUntil(event_clock_t time);
+
+    /**
+     * Switch the SIDs to silent clocking.
+     */
+    void sidSilent(bool enable);
+
+    /**
+     * Reset the machine if a stop has been requested.
+     */
+    void checkStopping();
+
+    /**
+     * Run the emulation and mix the produced samples into the buffer.
+     *
+     * @param buffer the output buffer, short or float
+     * @param count the size of the buffer in samples
+     */
+    template <typename T>
+    uint_least32_t playSamples(T *buffer, uint_least32_t count);
+
+    /**
+     * Run the emulation for the given number of cycles
+     * and mix the produced samples into the buffer.
+     *
+     * @param buffer the output buffer, short or float, or nullptr
+     * @param count the size of the buffer in samples
+     * @param cycles the number of CPU cycles to run, may be fractional
+     */
+    template <typename T>
+    uint_least32_t renderSamples(T *buffer, uint_least32_t count, double cycles);
+
+    /**
+     * Run the emulation for the given number of seconds
+     * and mix the produced samples into the buffer.
+     *
+     * @param buffer the output buffer, short or float, or nullptr
+     * @param count the size of the buffer in samples
+     * @param seconds the playing time to render
+     */
+    template <typename T>
+    uint_least32_t renderTime(T *buffer, uint_least32_t count, unsigned int seconds);
+
+    /**
+     * Save or restore the fields identifying the tune
+     * and the configuration a snapshot belongs to.
+     *
+     * @return false if restoring and they don't match
+     */
+    bool snapshotHeader(Snapshot &s);
+
 public:
     Player();
     ~Player() {}
@@ -154,10 +238,32 @@ public:
 
     uint_least32_t play(short *buffer, uint_least32_t samples);
 
+    uint_least32_t playFloat(float *buffer, uint_least32_t samples);
+
+    uint_least32_t renderCycles(short *buffer, uint_least32_t samples, uint_least32_t cycles);
+
+    uint_least32_t renderCyclesFloat(float *buffer, uint_least32_t samples, uint_least32_t cycles);
+
+    uint_least32_t renderSeconds(short *buffer, uint_least32_t samples, unsigned int seconds);
+
+    uint_least32_t renderSecondsFloat(float *buffer, uint_least32_t samples, unsigned int seconds);
+
+    bool seek(uint_least32_t milliseconds);
+
+    bool seekCycles(event_clock_t cycles);
+
     bool isPlaying() const { return m_isPlaying != STOPPED; }
 
     void stop();
 
+    bool captureSidWrites(bool enable);
+
+    uint_least32_t capturedSidWrites(uint_least8_t *stream, uint_least32_t size) const;
+
+    uint_least32_t saveState(uint_least8_t *state, uint_least32_t size);
+
+    bool restoreState(const uint_least8_t *state, uint_least32_t size);
+
     uint_least32_t time() const { return static_cast<uint_least32_t>(m_c64.getEventScheduler().getTime(EVENT_CLOCK_PHI1) / cpuFreq()); }
 
     void debug(const bool enable, FILE *out) { m_c64.debug(enable, out); }
@@ -169,6 +275,19 @@ public:
     void setRoms(const uint8_t* kernal, const uint8_t* basic, const uint8_t* character);
 
     uint_least16_t getCia1TimerA() const { return m_c64.getCia1TimerA(); }
+
+    /**
+     * Get the emulated machine, for state inspection.
+     */
+    c64 &machine() { return m_c64; }
+
+    /**
+     * Get the SID emulation.
+     *
+     * @param i the chip number
+     * @return the emulation, nullptr if not present
+     */
+    sidemu *getSid(unsigned int i) const { return m_mixer.getSid(i); }
 };
 
 }
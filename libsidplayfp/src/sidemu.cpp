@@ -22,6 +22,8 @@
 
 #include "sidemu.h"
 
+#include "Snapshot.h"
+
 namespace libsidplayfp
 {
 
@@ -44,6 +46,28 @@ void sidemu::unlock()
 {
     isLocked  = false;
     eventScheduler = nullptr;
+
+    // The capture belongs to the player that locked us
+    m_capture = nullptr;
+}
+
+bool sidemu::snapshot(Snapshot &s)
+{
+    if (!chipSnapshot(s))
+        return false;
+
+    s.value(m_accessClk);
+    s.value(m_bufferpos);
+
+    if (s.loading() && (m_bufferpos < 0 || m_bufferpos > OUTPUTBUFFERSIZE))
+    {
+        m_bufferpos = 0;
+        s.fail();
+    }
+
+    s.bytes(m_buffer, m_bufferpos * sizeof(float));
+
+    return true;
 }
 
 }
@@ -31,6 +31,7 @@
 #include "EventScheduler.h"
 
 #include "c64/c64sid.h"
+#include "SidCapture.h"
 
 #include "sidcxx11.h"
 
@@ -40,6 +41,8 @@ class sidbuilder;
 namespace libsidplayfp
 {
 
+class Snapshot;
+
 /**
  * Inherit this class to create a new SID emulation.
  */
@@ -62,13 +65,22 @@ protected:
     static const char ERR_INVALID_SAMPLING[];
     static const char ERR_INVALID_CHIP[];
 
+protected:
+    /**
+     * Save or restore the chip emulation state.
+     *
+     * @param s the snapshot
+     * @return false if the emulation does not support it
+     */
+    virtual bool chipSnapshot(Snapshot &s SID_UNUSED) { return false; }
+
 protected:
     EventScheduler *eventScheduler;
 
     event_clock_t m_accessClk;
 
-    /// The sample buffer
-    short *m_buffer;
+    /// The sample buffer, not clipped, full scale is the 16 bit range
+    float *m_buffer;
 
     /// Current position in buffer
     int m_bufferpos;
@@ -78,6 +90,10 @@ protected:
 
     std::string m_error;
 
+    /// Capture of the register writes, if any
+    SidCapture *m_capture;
+    unsigned int m_captureChip;
+
 public:
     sidemu(sidbuilder *builder) :
         m_builder(builder),
@@ -86,7 +102,9 @@ public:
         m_bufferpos(0),
         m_status(true),
         isLocked(false),
-        m_error("N/A") {}
+        m_error("N/A"),
+        m_capture(nullptr),
+        m_captureChip(0) {}
     virtual ~sidemu() {}
 
     /**
@@ -127,6 +145,45 @@ public:
     virtual void sampling(float systemfreq SID_UNUSED, float outputfreq SID_UNUSED,
         SidConfig::sampling_method_t method SID_UNUSED, bool fast SID_UNUSED) {}
 
+    /**
+     * Skip the audio synthesis when clocking, only keeping
+     * the registers and the voices up to date.
+     * Used for seeking, the emulations that don't support it
+     * keep producing samples that are discarded.
+     *
+     * @param enable
+     */
+    virtual void silent(bool enable SID_UNUSED) {}
+
+    /**
+     * Record the register writes.
+     *
+     * @param capture the capture to record to, nullptr to stop
+     * @param chip the chip number in the capture
+     */
+    void capture(SidCapture *capture, unsigned int chip)
+    {
+        m_capture = capture;
+        m_captureChip = chip;
+    }
+
+    /**
+     * Save or restore the emulation state, including
+     * the samples not yet consumed from the buffer.
+     *
+     * @param s the snapshot
+     * @return false if the emulation does not support it
+     */
+    bool snapshot(Snapshot &s);
+
+    // Bank functions
+    void poke(uint_least16_t address, uint8_t value) override
+    {
+        if (m_capture != nullptr)
+            m_capture->write(m_captureChip, address & 0x1f, value);
+        write(address & 0x1f, value);
+    }
+
     /**
      * Get a detailed error message.
      */
@@ -147,7 +204,7 @@ public:
     /**
      * Get the buffer.
      */
-    short *buffer() const { return m_buffer; }
+    float *buffer() const { return m_buffer; }
 };
 
 }
@@ -0,0 +1,86 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "SidAnalyzer.h"
+
+#include "Analyzer.h"
+
+SidAnalyzer::SidAnalyzer() :
+    analyzer(*(new libsidplayfp::Analyzer)) {}
+
+SidAnalyzer::~SidAnalyzer()
+{
+    delete &analyzer;
+}
+
+const SidConfig &SidAnalyzer::config() const
+{
+    return analyzer.config();
+}
+
+bool SidAnalyzer::config(const SidConfig &cfg)
+{
+    return analyzer.config(cfg);
+}
+
+void SidAnalyzer::setRoms(const uint8_t* kernal, const uint8_t* basic, const uint8_t* character)
+{
+    analyzer.setRoms(kernal, basic, character);
+}
+
+bool SidAnalyzer::analyze(SidTune *tune, unsigned int maxSeconds, unsigned int silenceSeconds)
+{
+    return analyzer.analyze(tune, maxSeconds, silenceSeconds);
+}
+
+SidAnalyzer::result_t SidAnalyzer::result() const
+{
+    switch (analyzer.result())
+    {
+    case libsidplayfp::LoopDetector::EXACT:
+    case libsidplayfp::LoopDetector::AUDIO:
+        return LOOP;
+    case libsidplayfp::LoopDetector::SILENCE:
+        return SILENCE;
+    default:
+        return UNKNOWN;
+    }
+}
+
+double SidAnalyzer::loopStart() const
+{
+    return analyzer.loopStart();
+}
+
+double SidAnalyzer::loopLength() const
+{
+    return analyzer.loopLength();
+}
+
+double SidAnalyzer::confidence() const
+{
+    return analyzer.confidence();
+}
+
+const char *SidAnalyzer::error() const
+{
+    return analyzer.error();
+}
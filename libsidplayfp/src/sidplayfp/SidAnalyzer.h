@@ -0,0 +1,131 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef SIDANALYZER_H
+#define SIDANALYZER_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+
+class SidConfig;
+class SidTune;
+
+namespace libsidplayfp
+{
+    class Analyzer;
+}
+
+/**
+ * Find the length of a tune without rendering audio.
+ *
+ * The machine is run with SIDs that only keep their registers.
+ * At every player call the CPU registers, the zero page, the stack,
+ * the tune memory and the SID registers are hashed: when a state
+ * repeats the tune loops exactly. Otherwise a repeated sequence
+ * of SID writes is taken as a loop once it has been verified for
+ * long enough, and sustained silence marks the end of the tune.
+ *
+ * Each instance is independent so tunes can be analysed
+ * in parallel using one instance per thread.
+ */
+class SID_EXTERN SidAnalyzer
+{
+public:
+    typedef enum
+    {
+        UNKNOWN,    ///< No loop or silence found in the given time
+        LOOP,       ///< The tune loops
+        SILENCE     ///< The tune ends in silence
+    } result_t;
+
+private:
+    libsidplayfp::Analyzer &analyzer;
+
+public:
+    SidAnalyzer();
+    ~SidAnalyzer();
+
+    /**
+     * Get the current configuration.
+     */
+    const SidConfig &config() const;
+
+    /**
+     * Configure the machine.
+     * The SID emulation setting is ignored.
+     *
+     * @param cfg the new configuration
+     * @return true on success, false otherwise.
+     */
+    bool config(const SidConfig &cfg);
+
+    /**
+     * Set ROM images.
+     *
+     * @param kernal pointer to Kernal ROM.
+     * @param basic pointer to Basic ROM, generally needed only for BASIC tunes.
+     * @param character pointer to character generator ROM.
+     */
+    void setRoms(const uint8_t* kernal, const uint8_t* basic=0, const uint8_t* character=0);
+
+    /**
+     * Analyse the selected song of a tune.
+     *
+     * @param tune the tune
+     * @param maxSeconds the maximum emulated time
+     * @param silenceSeconds the seconds of silence that end a tune
+     * @return false on error, check #error.
+     */
+    bool analyze(SidTune *tune, unsigned int maxSeconds, unsigned int silenceSeconds=5);
+
+    /**
+     * Get the outcome of the last analysis.
+     */
+    result_t result() const;
+
+    /**
+     * Get the start of the loop or of the silence in seconds.
+     */
+    double loopStart() const;
+
+    /**
+     * Get the length of the loop in seconds, zero for silence.
+     */
+    double loopLength() const;
+
+    /**
+     * Get the confidence of the result from 0 to 1.
+     * It is 1 for an exact repetition of the machine state,
+     * from 0.5 to 0.9 for an audio loop depending on how long
+     * it was verified and 0.5 for silence.
+     */
+    double confidence() const;
+
+    /**
+     * Error message.
+     *
+     * @return string error message.
+     */
+    const char *error() const;
+};
+
+#endif // SIDANALYZER_H
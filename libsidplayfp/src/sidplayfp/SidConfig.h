@@ -156,8 +156,9 @@ public:
     sampling_method_t samplingMethod;
 
     /**
-     * Faster low-quality emulation,
-     * available only for reSID.
+     * Faster low-quality emulation.
+     * - reSID: uses fast sampling
+     * - reSIDfp: runs the filters at a reduced rate
      */
     bool fastSampling;
 
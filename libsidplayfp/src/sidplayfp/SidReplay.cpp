@@ -0,0 +1,72 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#include "SidReplay.h"
+
+#include "Replayer.h"
+
+SidReplay::SidReplay() :
+    replayer(*(new libsidplayfp::Replayer)) {}
+
+SidReplay::~SidReplay()
+{
+    delete &replayer;
+}
+
+const SidConfig &SidReplay::config() const
+{
+    return replayer.config();
+}
+
+bool SidReplay::config(const SidConfig &cfg)
+{
+    return replayer.config(cfg);
+}
+
+bool SidReplay::load(const uint_least8_t *stream, uint_least32_t size)
+{
+    return replayer.load(stream, size);
+}
+
+uint_least32_t SidReplay::play(short *buffer, uint_least32_t count)
+{
+    return replayer.play(buffer, count);
+}
+
+uint_least32_t SidReplay::playFloat(float *buffer, uint_least32_t count)
+{
+    return replayer.playFloat(buffer, count);
+}
+
+bool SidReplay::isPlaying() const
+{
+    return replayer.isPlaying();
+}
+
+uint_least32_t SidReplay::time() const
+{
+    return replayer.time();
+}
+
+const char *SidReplay::error() const
+{
+    return replayer.error();
+}
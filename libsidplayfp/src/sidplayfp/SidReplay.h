@@ -0,0 +1,124 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+
+#ifndef SIDREPLAY_H
+#define SIDREPLAY_H
+
+#include <stdint.h>
+
+#include "sidplayfp/siddefs.h"
+
+class SidConfig;
+
+namespace libsidplayfp
+{
+    class Replayer;
+}
+
+/**
+ * Plays back the SID writes captured with sidplayfp::captureSidWrites.
+ *
+ * Only the SID chips are emulated, which saves the cost of
+ * running the whole machine. As the SID emulation usually
+ * dominates, rendering is only about 1.2-1.5 times faster.
+ * The output is the same as the original one as long as the
+ * same emulation and sampling settings are used.
+ */
+class SID_EXTERN SidReplay
+{
+private:
+    libsidplayfp::Replayer &replayer;
+
+public:
+    SidReplay();
+    ~SidReplay();
+
+    /**
+     * Get the current configuration.
+     *
+     * @return a const reference to the current configuration.
+     */
+    const SidConfig &config() const;
+
+    /**
+     * Configure the engine.
+     * Only the SID emulation, model, sampling and output
+     * settings are used, the machine settings come from the stream.
+     * Check #error for detailed message if something goes wrong.
+     *
+     * @param cfg the new configuration
+     * @return true on success, false otherwise.
+     */
+    bool config(const SidConfig &cfg);
+
+    /**
+     * Load a stream and rewind to its start.
+     * The stream is not copied and must stay valid while playing.
+     *
+     * @param stream the captured stream
+     * @param size the size of the stream in bytes
+     * @return false if the stream is invalid or the SIDs can't be created.
+     */
+    bool load(const uint_least8_t *stream, uint_least32_t size);
+
+    /**
+     * Render the stream.
+     *
+     * @param buffer pointer to the buffer to fill with 16 bit samples.
+     * @param count the size of the buffer measured in samples.
+     * @return the number of produced samples, less than count
+     *         at the end of the stream.
+     */
+    uint_least32_t play(short *buffer, uint_least32_t count);
+
+    /**
+     * Render the stream as floating point samples.
+     *
+     * @param buffer pointer to the buffer to fill, full scale is [-1, 1].
+     * @param count the size of the buffer measured in samples.
+     * @return the number of produced samples, less than count
+     *         at the end of the stream.
+     */
+    uint_least32_t playFloat(float *buffer, uint_least32_t count);
+
+    /**
+     * Check if there is something left to play.
+     *
+     * @return false at the end of the stream or on error.
+     */
+    bool isPlaying() const;
+
+    /**
+     * Get the current playing time.
+     *
+     * @return the current playing time measured in seconds.
+     */
+    uint_least32_t time() const;
+
+    /**
+     * Error message.
+     *
+     * @return string error message.
+     */
+    const char *error() const;
+};
+
+#endif // SIDREPLAY_H
@@ -20,7 +20,11 @@
 
 #include "SidTune.h"
 
+#include <vector>
+
 #include "sidtune/SidTuneBase.h"
+#include "sidtune/PSID.h"
+#include "utils/md5Multi.h"
 
 #include "sidcxx11.h"
 
@@ -100,6 +104,36 @@ void SidTune::read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
     }
 }
 
+void SidTune::attach(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
+{
+    try
+    {
+        tune.reset(SidTuneBase::attach(sourceBuffer, bufferLen));
+        m_status = true;
+        m_statusString = MSG_NO_ERRORS;
+    }
+    catch (loadError const &e)
+    {
+        m_status = false;
+        m_statusString = e.message();
+    }
+}
+
+void SidTune::loadMapped(const char* fileName, bool separatorIsSlash)
+{
+    try
+    {
+        tune.reset(SidTuneBase::loadMapped(fileName, fileNameExtensions, separatorIsSlash));
+        m_status = true;
+        m_statusString = MSG_NO_ERRORS;
+    }
+    catch (loadError const &e)
+    {
+        m_status = false;
+        m_statusString = e.message();
+    }
+}
+
 unsigned int SidTune::selectSong(unsigned int songNum)
 {
     return tune.get() != nullptr ? tune->selectSong(songNum) : 0;
@@ -132,6 +166,74 @@ const char* SidTune::createMD5(char *md5)
 {
     return tune.get() != nullptr ? tune->createMD5(md5) : nullptr;
 }
+
+/**
+ * Format the digest as lowercase hex string.
+ */
+static void hexDigest(const uint8_t* digest, char* md5)
+{
+    const char hex[] = "0123456789abcdef";
+
+    for (int i = 0; i < md5Multi::DIGEST_SIZE; i++)
+    {
+        *md5++ = hex[digest[i] >> 4];
+        *md5++ = hex[digest[i] & 0x0f];
+    }
+    *md5 = '\0';
+}
+
+const char* SidTune::createMD5(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen, char *md5)
+{
+    return createMD5(1, &sourceBuffer, &bufferLen, &md5) != 0 ? md5 : nullptr;
+}
+
+unsigned int SidTune::createMD5(unsigned int count, const uint_least8_t* const sourceBuffers[],
+                                const uint_least32_t bufferLens[], char* const md5s[])
+{
+    std::vector<std::vector<uint8_t>> messages(count);
+    std::vector<const uint8_t*> data;
+    std::vector<size_t> sizes;
+    std::vector<unsigned int> index;
+    data.reserve(count);
+    sizes.reserve(count);
+    index.reserve(count);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        md5s[i][0] = '\0';
+
+        try
+        {
+            PSID::md5Message(sourceBuffers[i], bufferLens[i], messages[i]);
+        }
+        catch (loadError const &)
+        {
+            continue;
+        }
+
+        data.push_back(&messages[i][0]);
+        sizes.push_back(messages[i].size());
+        index.push_back(i);
+    }
+
+    if (index.empty())
+        return 0;
+
+    // A single message would leave the other lanes idle
+    const md5Multi::md5_kernel_t* kernel = (index.size() == 1) ? &md5Multi::kernels().back() : nullptr;
+
+    std::vector<uint8_t> digests(index.size() * md5Multi::DIGEST_SIZE);
+    md5Multi::digest(index.size(), &data[0], &sizes[0],
+        reinterpret_cast<uint8_t (*)[md5Multi::DIGEST_SIZE]>(&digests[0]), kernel);
+
+    for (size_t i = 0; i < index.size(); i++)
+    {
+        hexDigest(&digests[i * md5Multi::DIGEST_SIZE], md5s[index[i]]);
+    }
+
+    return index.size();
+}
+
 const uint_least8_t* SidTune::c64Data() const
 {
     return tune.get() != nullptr ? tune->c64Data() : nullptr;
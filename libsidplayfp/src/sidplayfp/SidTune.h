@@ -115,6 +115,29 @@ public:  // ----------------------------------------------------------------
      */
     void read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
 
+    /**
+     * Load a sidtune into an existing object from a buffer
+     * without copying it.
+     * The buffer must stay valid until another tune is loaded
+     * or the object is destroyed.
+     * Currently only PSID data is referenced, other formats are copied.
+     *
+     * @param sourceBuffer the buffer that contains song data
+     * @param bufferLen length of the buffer
+     */
+    void attach(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
+
+    /**
+     * Load a sidtune into an existing object from a file
+     * mapped in memory instead of reading it.
+     * Currently only PSID files are mapped, other formats
+     * are loaded as with load().
+     *
+     * @param fileName
+     * @param separatorIsSlash
+     */
+    void loadMapped(const char* fileName, bool separatorIsSlash = false);
+
     /**
      * Select sub-song.
      *
@@ -166,6 +189,27 @@ public:  // ----------------------------------------------------------------
      */
     const char *createMD5(char *md5 = 0);
 
+    /**
+     * Calculates the MD5 hash of a PSID/RSID file in memory
+     * without loading the tune.
+     * The buffer must be MD5_LENGTH + 1
+     *
+     * @return a pointer to the buffer containing the md5 string,
+     *         0 if the data is not a supported tune.
+     */
+    static const char *createMD5(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen, char *md5);
+
+    /**
+     * Calculates the MD5 hashes of several PSID/RSID files in memory
+     * at once, hashing them in parallel where the CPU allows.
+     * Each md5 buffer must be MD5_LENGTH + 1,
+     * it is set to an empty string if the data is not a supported tune.
+     *
+     * @return the number of hashes calculated
+     */
+    static unsigned int createMD5(unsigned int count, const uint_least8_t* const sourceBuffers[],
+                                  const uint_least32_t bufferLens[], char* const md5s[]);
+
     const uint_least8_t* c64Data() const;
 
 private:    // prevent copying
@@ -56,11 +56,66 @@ void sidplayfp::stop()
     sidplayer.stop();
 }
 
+bool sidplayfp::captureSidWrites(bool enable)
+{
+    return sidplayer.captureSidWrites(enable);
+}
+
+uint_least32_t sidplayfp::capturedSidWrites(uint_least8_t *stream, uint_least32_t size) const
+{
+    return sidplayer.capturedSidWrites(stream, size);
+}
+
+bool sidplayfp::seek(uint_least32_t milliseconds)
+{
+    return sidplayer.seek(milliseconds);
+}
+
+bool sidplayfp::seekCycles(uint_least64_t cycles)
+{
+    return sidplayer.seekCycles(static_cast<libsidplayfp::event_clock_t>(cycles));
+}
+
+uint_least32_t sidplayfp::saveState(uint_least8_t *state, uint_least32_t size)
+{
+    return sidplayer.saveState(state, size);
+}
+
+bool sidplayfp::restoreState(const uint_least8_t *state, uint_least32_t size)
+{
+    return sidplayer.restoreState(state, size);
+}
+
 uint_least32_t sidplayfp::play(short *buffer, uint_least32_t count)
 {
     return sidplayer.play(buffer, count);
 }
 
+uint_least32_t sidplayfp::playFloat(float *buffer, uint_least32_t count)
+{
+    return sidplayer.playFloat(buffer, count);
+}
+
+uint_least32_t sidplayfp::renderCycles(short *buffer, uint_least32_t count, uint_least32_t cycles)
+{
+    return sidplayer.renderCycles(buffer, count, cycles);
+}
+
+uint_least32_t sidplayfp::renderCyclesFloat(float *buffer, uint_least32_t count, uint_least32_t cycles)
+{
+    return sidplayer.renderCyclesFloat(buffer, count, cycles);
+}
+
+uint_least32_t sidplayfp::renderSeconds(short *buffer, uint_least32_t count, unsigned int seconds)
+{
+    return sidplayer.renderSeconds(buffer, count, seconds);
+}
+
+uint_least32_t sidplayfp::renderSecondsFloat(float *buffer, uint_least32_t count, unsigned int seconds)
+{
+    return sidplayer.renderSecondsFloat(buffer, count, seconds);
+}
+
 bool sidplayfp::load(SidTune *tune)
 {
     return sidplayer.load(tune);
@@ -103,13 +103,105 @@ public:
      *
      * @param buffer pointer to the buffer to fill with samples.
      * @param count the size of the buffer measured in 16 bit samples
-     *              or 0 if no output is needed (e.g. Hardsid)
+     *              or 0 if no output is needed (e.g. Hardsid).
      * @return the number of produced samples. If less than requested
      * and #isPlaying() is true an error occurred, use #error() to get
      * a detailed message.
      */
     uint_least32_t play(short *buffer, uint_least32_t count);
 
+    /**
+     * Run the emulation and produce float samples to play.
+     * Samples are in the [-1,1] range and, unlike #play(short*, uint_least32_t),
+     * they are neither clipped nor dithered, so they may slightly
+     * exceed full scale.
+     *
+     * @param buffer pointer to the buffer to fill with samples.
+     * @param count the size of the buffer measured in samples
+     * @return the number of produced samples.
+     */
+    uint_least32_t playFloat(float *buffer, uint_least32_t count);
+
+    /**
+     * Run the emulation for the given number of CPU cycles
+     * and mix the produced samples into the buffer.
+     * The machine is clocked in large chunks, mixing straight
+     * into the caller's buffer, so it is cheaper than calling
+     * #play() repeatedly with small buffers.
+     * Emulation stops early if the buffer is filled up.
+     *
+     * @param buffer pointer to the buffer to fill with samples,
+     *               or 0 if no output is needed
+     * @param count the size of the buffer measured in 16 bit samples
+     * @param cycles the number of CPU cycles to run
+     * @return the number of produced samples.
+     */
+    uint_least32_t renderCycles(short *buffer, uint_least32_t count, uint_least32_t cycles);
+
+    /**
+     * Run the emulation for the given number of CPU cycles
+     * and mix the produced float samples into the buffer.
+     * See #renderCycles() and #playFloat().
+     *
+     * @param buffer pointer to the buffer to fill with samples,
+     *               or 0 if no output is needed
+     * @param count the size of the buffer measured in samples
+     * @param cycles the number of CPU cycles to run
+     * @return the number of produced samples.
+     */
+    uint_least32_t renderCyclesFloat(float *buffer, uint_least32_t count, uint_least32_t cycles);
+
+    /**
+     * Run the emulation for the given number of seconds
+     * and mix the produced samples into the buffer.
+     * Consecutive calls render the same as a single call
+     * for the whole time.
+     * See #renderCycles().
+     *
+     * @param buffer pointer to the buffer to fill with samples,
+     *               or 0 if no output is needed
+     * @param count the size of the buffer measured in 16 bit samples
+     * @param seconds the playing time to render
+     * @return the number of produced samples.
+     */
+    uint_least32_t renderSeconds(short *buffer, uint_least32_t count, unsigned int seconds);
+
+    /**
+     * Run the emulation for the given number of seconds
+     * and mix the produced float samples into the buffer.
+     * See #renderSeconds() and #playFloat().
+     *
+     * @param buffer pointer to the buffer to fill with samples,
+     *               or 0 if no output is needed
+     * @param count the size of the buffer measured in samples
+     * @param seconds the playing time to render
+     * @return the number of produced samples.
+     */
+    uint_least32_t renderSecondsFloat(float *buffer, uint_least32_t count, unsigned int seconds);
+
+    /**
+     * Seek to the given playing time.
+     * The time up to shortly before the target is emulated
+     * without audio synthesis, running at about the speed
+     * of the machine emulation alone; the last few milliseconds
+     * are clocked audibly so that the filters settle and
+     * playback resumes without clicks.
+     * Seeking backwards restarts the tune.
+     *
+     * @param milliseconds the target time
+     * @return false if no tune is loaded.
+     */
+    bool seek(uint_least32_t milliseconds);
+
+    /**
+     * Seek to the given machine cycle.
+     * See #seek().
+     *
+     * @param cycles the target time in CPU cycles
+     * @return false if no tune is loaded.
+     */
+    bool seekCycles(uint_least64_t cycles);
+
     /**
      * Check if the engine is playing or stopped.
      *
@@ -122,6 +214,62 @@ public:
      */
     void stop();
 
+    /**
+     * Capture the SID register writes into a stream that can be
+     * played back with SidReplay without emulating the machine.
+     * Start the capture right after loading the tune, before playing,
+     * so that the stream begins from the reset state.
+     * Starting a capture discards the previously captured stream.
+     * The capture ends when called with false
+     * or when the SIDs are released on reconfiguration.
+     *
+     * @param enable true to start a capture, false to end it.
+     * @return false if there are no SIDs to capture.
+     */
+    bool captureSidWrites(bool enable);
+
+    /**
+     * Get the stream of the captured SID writes,
+     * complete once the capture has ended.
+     * The stream is only copied if it fits in the buffer,
+     * call with a null buffer to get the needed size.
+     *
+     * @param stream the buffer to store the stream into, can be nullptr
+     * @param size the size of the buffer in bytes
+     * @return the size of the stream
+     */
+    uint_least32_t capturedSidWrites(uint_least8_t *stream, uint_least32_t size) const;
+
+    /**
+     * Save the whole emulation state, machine and SIDs,
+     * so that playback can later be resumed from this point.
+     * Taking a snapshot every few seconds on a first pass
+     * allows seeking anywhere by restoring the nearest one
+     * and rendering only the remaining time.
+     * The state can only be restored by the same build of the library,
+     * with the same tune, song and configuration.
+     * The state is only copied if it fits in the buffer,
+     * call with a null buffer to get the needed size.
+     *
+     * @param state the buffer to store the state into, can be nullptr
+     * @param size the size of the buffer in bytes
+     * @return the size of the state, 0 if no tune is loaded
+     *         or the SID emulation does not support it.
+     */
+    uint_least32_t saveState(uint_least8_t *state, uint_least32_t size);
+
+    /**
+     * Restore a state saved by #saveState().
+     * Any running capture of the SID writes is ended.
+     * If the state is invalid the tune is restarted.
+     *
+     * @param state the saved state
+     * @param size the size of the saved state in bytes
+     * @return false if the state doesn't belong to the loaded
+     *         tune and configuration or it is corrupt.
+     */
+    bool restoreState(const uint_least8_t *state, uint_least32_t size);
+
     /**
      * Control debugging.
      * Only has effect if library have been compiled
@@ -144,14 +144,22 @@ bool validateAddress(uint_least8_t address)
 }
 
 SidTuneBase* PSID::load(buffer_t& dataBuf)
+{
+    if (dataBuf.empty())
+        return nullptr;
+
+    return load(&dataBuf[0], dataBuf.size());
+}
+
+SidTuneBase* PSID::load(const uint_least8_t* dataBuf, uint_least32_t dataLen)
 {
     // File format check
-    if (dataBuf.size() < 4)
+    if (dataLen < 4)
     {
         return nullptr;
     }
 
-    const uint32_t magic = endian_big32(&dataBuf[0]);
+    const uint32_t magic = endian_big32(dataBuf);
     if ((magic != PSID_ID)
         && (magic != RSID_ID))
     {
@@ -159,7 +167,7 @@ SidTuneBase* PSID::load(buffer_t& dataBuf)
     }
 
     psidHeader pHeader;
-    readHeader(dataBuf, pHeader);
+    readHeader(dataBuf, dataLen, pHeader);
 
     std::unique_ptr<PSID> tune(new PSID());
     tune->tryLoad(pHeader);
@@ -167,12 +175,12 @@ SidTuneBase* PSID::load(buffer_t& dataBuf)
     return tune.release();
 }
 
-void PSID::readHeader(const buffer_t &dataBuf, psidHeader &hdr)
+void PSID::readHeader(const uint_least8_t* dataBuf, uint_least32_t dataLen, psidHeader &hdr)
 {
     // Due to security concerns, input must be at least as long as version 1
     // header plus 16-bit C64 load address. That is the area which will be
     // accessed.
-    if (dataBuf.size() < (psid_headerSize + 2))
+    if (dataLen < (psid_headerSize + 2))
     {
         throw loadError(ERR_TRUNCATED);
     }
@@ -193,7 +201,7 @@ void PSID::readHeader(const buffer_t &dataBuf, psidHeader &hdr)
 
     if (hdr.version >= 2)
     {
-        if (dataBuf.size() < (psidv2_headerSize + 2))
+        if (dataLen < (psidv2_headerSize + 2))
         {
             throw loadError(ERR_TRUNCATED);
         }
@@ -358,67 +366,114 @@ void PSID::tryLoad(const psidHeader &pHeader)
         throw loadError("Compute!'s Sidplayer MUS data is not supported yet"); // TODO
 }
 
-const char *PSID::createMD5(char *md5)
+void PSID::md5Message(const uint_least8_t* dataBuf, uint_least32_t dataLen,
+                      std::vector<uint8_t>& message)
 {
-    if (md5 == nullptr)
-        md5 = m_md5;
-
-    *md5 = '\0';
+    if (dataLen > MAX_FILELEN)
+    {
+        throw loadError(ERR_INVALID);
+    }
 
-    try
+    // File format check
+    if ((dataLen < 4)
+        || ((endian_big32(dataBuf) != PSID_ID)
+            && (endian_big32(dataBuf) != RSID_ID)))
     {
-        // Include C64 data.
-        sidmd5 myMD5;
-        myMD5.append(&cache[fileOffset], info->m_c64dataLen);
+        throw loadError(ERR_INVALID);
+    }
 
-        uint8_t tmp[2];
-        // Include INIT and PLAY address.
-        endian_little16(tmp, info->m_initAddr);
-        myMD5.append(tmp, sizeof(tmp));
-        endian_little16(tmp, info->m_playAddr);
-        myMD5.append(tmp, sizeof(tmp));
+    psidHeader pHeader;
+    readHeader(dataBuf, dataLen, pHeader);
 
-        // Include number of songs.
-        endian_little16(tmp, info->m_songs);
-        myMD5.append(tmp, sizeof(tmp));
+    // Load the tune like SidTune::attach, only referencing the data
+    PSID tune;
+    tune.tryLoad(pHeader);
+    tune.acceptSidTuneData(nullptr, nullptr, dataBuf, dataLen, false);
 
-        {
-            // Include song speed for each song.
-            const unsigned int currentSong = info->m_currentSong;
-            for (unsigned int s = 1; s <= info->m_songs; s++)
-            {
-                selectSong(s);
-                const uint8_t songSpeed = static_cast<uint8_t>(info->m_songSpeed);
-                myMD5.append(&songSpeed, sizeof(songSpeed));
-            }
-            // Restore old song
-            selectSong(currentSong);
-        }
+    tune.fingerprintData(message);
+}
+
+void PSID::fingerprintData(std::vector<uint8_t>& message)
+{
+    message.clear();
+    message.reserve(info->m_c64dataLen + 6 + info->m_songs + 1);
+
+    // Include C64 data.
+    message.insert(message.end(), tuneData + fileOffset, tuneData + fileOffset + info->m_c64dataLen);
 
-        // Deal with PSID v2NG clock speed flags: Let only NTSC
-        // clock speed change the MD5 fingerprint. That way the
-        // fingerprint of a PAL-speed sidtune in PSID v1, v2, and
-        // PSID v2NG format is the same.
-        if (info->m_clockSpeed == SidTuneInfo::CLOCK_NTSC)
+    uint8_t tmp[2];
+    // Include INIT and PLAY address.
+    endian_little16(tmp, info->m_initAddr);
+    message.insert(message.end(), tmp, tmp + sizeof(tmp));
+    endian_little16(tmp, info->m_playAddr);
+    message.insert(message.end(), tmp, tmp + sizeof(tmp));
+
+    // Include number of songs.
+    endian_little16(tmp, info->m_songs);
+    message.insert(message.end(), tmp, tmp + sizeof(tmp));
+
+    {
+        // Include song speed for each song.
+        const unsigned int currentSong = info->m_currentSong;
+        for (unsigned int s = 1; s <= info->m_songs; s++)
         {
-            const uint8_t ntsc_val = 2;
-            myMD5.append(&ntsc_val, sizeof(ntsc_val));
+            selectSong(s);
+            message.push_back(static_cast<uint8_t>(info->m_songSpeed));
         }
+        // Restore old song
+        selectSong(currentSong);
+    }
+
+    // Deal with PSID v2NG clock speed flags: Let only NTSC
+    // clock speed change the MD5 fingerprint. That way the
+    // fingerprint of a PAL-speed sidtune in PSID v1, v2, and
+    // PSID v2NG format is the same.
+    if (info->m_clockSpeed == SidTuneInfo::CLOCK_NTSC)
+    {
+        message.push_back(2);
+    }
+
+    // NB! If the fingerprint is used as an index into a
+    // song-lengths database or cache, modify above code to
+    // allow for PSID v2NG files which have clock speed set to
+    // SIDTUNE_CLOCK_ANY. If the SID player program fully
+    // supports the SIDTUNE_CLOCK_ANY setting, a sidtune could
+    // either create two different fingerprints depending on
+    // the clock speed chosen by the player, or there could be
+    // two different values stored in the database/cache.
+}
+
+const char *PSID::createMD5(char *md5)
+{
+    if (md5 == nullptr)
+        md5 = m_md5;
+
+    // Already calculated
+    if (m_md5[0] != '\0')
+    {
+        if (md5 != m_md5)
+            memcpy(md5, m_md5, SidTune::MD5_LENGTH + 1);
+        return md5;
+    }
+
+    *md5 = '\0';
+
+    try
+    {
+        std::vector<uint8_t> message;
+        fingerprintData(message);
 
-        // NB! If the fingerprint is used as an index into a
-        // song-lengths database or cache, modify above code to
-        // allow for PSID v2NG files which have clock speed set to
-        // SIDTUNE_CLOCK_ANY. If the SID player program fully
-        // supports the SIDTUNE_CLOCK_ANY setting, a sidtune could
-        // either create two different fingerprints depending on
-        // the clock speed chosen by the player, or there could be
-        // two different values stored in the database/cache.
+        sidmd5 myMD5;
+        myMD5.append(&message[0], message.size());
 
         myMD5.finish();
 
         // Get fingerprint.
         myMD5.getDigest().copy(md5, SidTune::MD5_LENGTH);
         md5[SidTune::MD5_LENGTH] = '\0';
+
+        if (md5 != m_md5)
+            memcpy(m_md5, md5, SidTune::MD5_LENGTH + 1);
     }
     catch (md5Error const &)
     {
@@ -22,6 +22,7 @@
 #define PSID_H
 
 #include <stdint.h>
+#include <vector>
 
 #include "SidTuneBase.h"
 
@@ -52,10 +53,17 @@ private:
      *
      * @throw loadError
      */
-    static void readHeader(const buffer_t &dataBuf, psidHeader &hdr);
+    static void readHeader(const uint_least8_t* dataBuf, uint_least32_t dataLen, psidHeader &hdr);
+
+    /**
+     * Build the data hashed for the Songlengths fingerprint.
+     *
+     * @param message receives the data to hash
+     */
+    void fingerprintData(std::vector<uint8_t>& message);
 
 protected:
-    PSID() {}
+    PSID() { m_md5[0] = '\0'; }
 
 public:
     virtual ~PSID() {}
@@ -66,6 +74,27 @@ public:
      */
     static SidTuneBase* load(buffer_t& dataBuf);
 
+    /**
+     * @return pointer to a SidTune or 0 if not a PSID file
+     * @throw loadError if PSID file is corrupt
+     */
+    static SidTuneBase* load(const uint_least8_t* dataBuf, uint_least32_t dataLen);
+
+    /**
+     * Build the data hashed by createMD5 straight from the file contents,
+     * without copying them.
+     *
+     * @param dataBuf the PSID/RSID file
+     * @param dataLen the file length
+     * @param message receives the data to hash
+     * @throw loadError if not a valid PSID/RSID file
+     */
+    static void md5Message(const uint_least8_t* dataBuf, uint_least32_t dataLen,
+                           std::vector<uint8_t>& message);
+
+    /**
+     * The digest is calculated only once and then cached.
+     */
     virtual const char *createMD5(char *md5) override;
 
 private:
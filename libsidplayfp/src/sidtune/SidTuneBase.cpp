@@ -42,6 +42,15 @@
 #include "prg.h"
 #include "PSID.h"
 
+#include "sidcxx11.h"
+
+#ifdef HAVE_SYS_MMAN_H
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 namespace libsidplayfp
 {
 
@@ -85,12 +94,6 @@ const char CHR_tab[256] =
   0x2f,0x2d,0x2d,0x7c,0x7c,0x7c,0x7c,0x2d,0x2d,0x2d,0x2f,0x5c,0x5c,0x2f,0x2f,0x23
 };
 
-/// The Commodore 64 memory size
-const uint_least32_t MAX_MEMORY = 65536;
-
-/// C64KB + LOAD + PSID
-const uint_least32_t MAX_FILELEN = MAX_MEMORY + 2 + 0x7C;
-
 /// Minimum load address for real c64 only tunes
 const uint_least16_t SIDTUNE_R64_MIN_LOAD_ADDR = 0x07e8;
 
@@ -113,6 +116,80 @@ SidTuneBase* SidTuneBase::read(const uint_least8_t* sourceBuffer, uint_least32_t
     return getFromBuffer(sourceBuffer, bufferLen);
 }
 
+SidTuneBase* SidTuneBase::attach(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen)
+{
+    if (sourceBuffer == nullptr || bufferLen == 0)
+    {
+        throw loadError(ERR_EMPTY);
+    }
+
+    if (bufferLen > MAX_FILELEN)
+    {
+        throw loadError(ERR_FILE_TOO_LONG);
+    }
+
+    std::unique_ptr<SidTuneBase> s(PSID::load(sourceBuffer, bufferLen));
+    if (s.get() == nullptr)
+    {
+        // MUS data gets modified while loading
+        return getFromBuffer(sourceBuffer, bufferLen);
+    }
+
+    s->acceptSidTuneData("-", "-", sourceBuffer, bufferLen, false);
+    return s.release();
+}
+
+SidTuneBase* SidTuneBase::loadMapped(const char* fileName, const char **fileNameExt,
+                 bool separatorIsSlash)
+{
+#ifdef HAVE_SYS_MMAN_H
+    if (fileName != nullptr && strcmp(fileName, "-") != 0)
+    {
+        const int fd = open(fileName, O_RDONLY);
+        if (fd >= 0)
+        {
+            void* map = MAP_FAILED;
+            struct stat st;
+            if ((fstat(fd, &st) == 0)
+                && (st.st_size > 0)
+                && (st.st_size <= static_cast<off_t>(MAX_FILELEN)))
+            {
+                map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            }
+            close(fd);
+
+            if (map != MAP_FAILED)
+            {
+                const uint_least8_t* data = static_cast<const uint_least8_t*>(map);
+                const uint_least32_t dataLen = st.st_size;
+
+                std::unique_ptr<SidTuneBase> s;
+                try
+                {
+                    s.reset(PSID::load(data, dataLen));
+                    if (s.get() != nullptr)
+                    {
+                        s->mappedData = map;
+                        s->mappedLen = dataLen;
+                        s->acceptSidTuneData(fileName, nullptr, data, dataLen, separatorIsSlash);
+                        return s.release();
+                    }
+                }
+                catch (loadError const &)
+                {
+                    if (s.get() == nullptr)
+                        munmap(map, dataLen);
+                    throw;
+                }
+
+                munmap(map, dataLen);
+            }
+        }
+    }
+#endif
+    return load(fileName, fileNameExt, separatorIsSlash, nullptr);
+}
+
 const SidTuneInfo* SidTuneBase::getInfo() const
 {
     return info.get();
@@ -178,7 +255,7 @@ void SidTuneBase::placeSidTuneInC64mem(sidmemory& mem)
     mem.writeMemWord(0xae, end);
 
     // Copy data from cache to the correct destination.
-    mem.fillRam(info->m_loadAddr, &cache[fileOffset], info->m_c64dataLen);
+    mem.fillRam(info->m_loadAddr, tuneData + fileOffset, info->m_c64dataLen);
 }
 
 void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
@@ -201,18 +278,18 @@ void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
     inFile.seekg(0, inFile.beg);
 
     buffer_t fileBuf;
-    fileBuf.reserve(fileLen);
 
     try
     {
-        fileBuf.assign(std::istreambuf_iterator<char>(inFile), std::istreambuf_iterator<char>());
+        fileBuf.resize(fileLen);
+        inFile.read(reinterpret_cast<char*>(&fileBuf[0]), fileLen);
     }
     catch (std::exception &ex)
     {
         throw loadError(ex.what());
     }
 
-    if (inFile.bad())
+    if (inFile.bad() || (inFile.gcount() != fileLen))
     {
         throw loadError(ERR_CANT_LOAD_FILE);
     }
@@ -224,7 +301,10 @@ void SidTuneBase::loadFile(const char* fileName, buffer_t& bufferRef)
 
 SidTuneBase::SidTuneBase() :
     info(new SidTuneInfoImpl()),
-    fileOffset(0)
+    fileOffset(0),
+    tuneData(nullptr),
+    mappedData(nullptr),
+    mappedLen(0)
 {
     // Initialize the object with some safe defaults.
     for (unsigned int si = 0; si < MAX_SONGS; si++)
@@ -234,6 +314,14 @@ SidTuneBase::SidTuneBase() :
     }
 }
 
+SidTuneBase::~SidTuneBase()
+{
+#ifdef HAVE_SYS_MMAN_H
+    if (mappedData != nullptr)
+        munmap(mappedData, mappedLen);
+#endif
+}
+
 #if !defined(SIDTUNE_NO_STDIN_LOADER)
 
 SidTuneBase* SidTuneBase::getFromStdIn()
@@ -287,6 +375,15 @@ SidTuneBase* SidTuneBase::getFromBuffer(const uint_least8_t* const buffer, uint_
 
 void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileName,
                             buffer_t& buf, bool isSlashedFileName)
+{
+    acceptSidTuneData(dataFileName, infoFileName, &buf[0], buf.size(), isSlashedFileName);
+
+    cache.swap(buf);
+    tuneData = &cache[0];
+}
+
+void SidTuneBase::acceptSidTuneData(const char* dataFileName, const char* infoFileName,
+                            const uint_least8_t* data, uint_least32_t dataLen, bool isSlashedFileName)
 {
     // Make a copy of the data file name and path, if available.
     if (dataFileName != nullptr)
@@ -323,12 +420,12 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
         info->m_startSong = 1;
     }
 
-    info->m_dataFileLen = buf.size();
-    info->m_c64dataLen = buf.size() - fileOffset;
+    info->m_dataFileLen = dataLen;
+    info->m_c64dataLen = dataLen - fileOffset;
 
     // Calculate any remaining addresses and then
     // confirm all the file details are correct
-    resolveAddrs(&buf[fileOffset]);
+    resolveAddrs(data + fileOffset);
 
     if (checkRelocInfo() == false)
     {
@@ -344,7 +441,7 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
         // We only detect an offset of two. Some position independent
         // sidtunes contain a load address of 0xE000, but are loaded
         // to 0x0FFE and call player at 0x1000.
-        info->m_fixLoad = (endian_little16(&buf[fileOffset])==(info->m_loadAddr+2));
+        info->m_fixLoad = (endian_little16(data + fileOffset)==(info->m_loadAddr+2));
     }
 
     // Check the size of the data.
@@ -357,7 +454,7 @@ void SidTuneBase::acceptSidTune(const char* dataFileName, const char* infoFileNa
         throw loadError(ERR_EMPTY);
     }
 
-    cache.swap(buf);
+    tuneData = data;
 }
 
 void SidTuneBase::createNewFileName(std::string& destString,
@@ -66,12 +66,18 @@ protected:
     /// Also PSID file format limit.
     enum {MAX_SONGS = 256};
 
+    /// The Commodore 64 memory size
+    enum {MAX_MEMORY = 65536};
+
+    /// C64KB + LOAD + PSID
+    enum {MAX_FILELEN = MAX_MEMORY + 2 + 0x7C};
+
     // Generic error messages
     static const char ERR_TRUNCATED[];
     static const char ERR_INVALID[];
 
 public:  // ----------------------------------------------------------------
-    virtual ~SidTuneBase() {}
+    virtual ~SidTuneBase();
 
     /**
      * Load a sidtune from a file.
@@ -103,6 +109,31 @@ public:  // ----------------------------------------------------------------
      */
     static SidTuneBase* read(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
 
+    /**
+     * Load a single-file sidtune from a memory buffer without copying it.
+     * The buffer must stay valid for the lifetime of the tune.
+     * Currently supported: PSID format, other formats are copied.
+     *
+     * @param sourceBuffer
+     * @param bufferLen
+     * @return the sid tune
+     * @throw loadError
+     */
+    static SidTuneBase* attach(const uint_least8_t* sourceBuffer, uint_least32_t bufferLen);
+
+    /**
+     * Load a sidtune from a file mapped in memory.
+     * Currently supported: PSID format, other formats
+     * or systems without mmap fall back to load.
+     *
+     * @param fileName
+     * @param fileNameExt
+     * @param separatorIsSlash
+     * @return the sid tune
+     * @throw loadError
+     */
+    static SidTuneBase* loadMapped(const char* fileName, const char **fileNameExt, bool separatorIsSlash);
+
     /**
      * Select sub-song (0 = default starting song)
      * and return active song number out of [1,2,..,SIDTUNE_MAX_SONGS].
@@ -144,7 +175,7 @@ public:  // ----------------------------------------------------------------
     /**
      * Get the pointer to the tune data.
      */
-    const uint_least8_t* c64Data() const { return &cache[fileOffset]; }
+    const uint_least8_t* c64Data() const { return tuneData + fileOffset; }
 
 protected:  // -------------------------------------------------------------
 
@@ -156,6 +187,9 @@ protected:  // -------------------------------------------------------------
     /// For files with header: offset to real data
     uint_least32_t fileOffset;
 
+    /// The file contents, either the cache or memory owned by someone else
+    const uint_least8_t* tuneData;
+
     buffer_t cache;
 
 protected:
@@ -217,6 +251,15 @@ protected:
     virtual void acceptSidTune(const char* dataFileName, const char* infoFileName,
                         buffer_t& buf, bool isSlashedFileName);
 
+    /**
+     * Same as acceptSidTune but only references the data,
+     * which must outlive the tune.
+     *
+     * @throw loadError
+     */
+    void acceptSidTuneData(const char* dataFileName, const char* infoFileName,
+                        const uint_least8_t* data, uint_least32_t dataLen, bool isSlashedFileName);
+
     /**
      * Petscii to Ascii converter.
      */
@@ -244,6 +287,11 @@ private:  // ---------------------------------------------------------------
     static void createNewFileName(std::string& destString,
                            const char* sourceName, const char* sourceExt);
 
+private:
+    /// Mapped file backing tuneData, if any
+    void* mappedData;
+    size_t mappedLen;
+
 private:
     // prevent copying
     SidTuneBase(const SidTuneBase&);
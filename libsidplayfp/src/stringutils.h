@@ -45,6 +45,17 @@ namespace stringutils
      */
     inline bool casecompare(char c1, char c2) { return (tolower(c1) == tolower(c2)); }
 
+    /**
+     * Convert a string to lower case, e.g. to build
+     * case insensitive keys.
+     */
+    inline std::string lower(std::string s)
+    {
+        for (std::string::iterator it = s.begin(); it != s.end(); ++it)
+            *it = tolower(static_cast<unsigned char>(*it));
+        return s;
+    }
+
     /**
      * Compare two strings in a case insensitive way. 
      *
@@ -99,8 +99,6 @@ STIL::STIL(const char *stilPath, const char *bugsPath) :
     PATH_TO_STIL(stilPath),
     PATH_TO_BUGLIST(bugsPath),
     STILVersion(0.0f),
-    STIL_EOL('\n'),
-    STIL_EOL2('\0'),
     lastError(NO_STIL_ERROR)
 {
     setVersionString();
@@ -143,9 +141,9 @@ STIL::setBaseDir(const char *pathToHVSC)
     // Temporary placeholder for STIL.txt's version number.
     const float tempSTILVersion = STILVersion;
 
-    // Temporary placeholders for lists of sections.
-    dirList tempStilDirs;
-    dirList tempBugDirs;
+    // Temporary placeholders for the indexed files.
+    textIndex tempStilIndex;
+    textIndex tempBugIndex;
 
     lastError = NO_STIL_ERROR;
 
@@ -169,102 +167,62 @@ STIL::setBaseDir(const char *pathToHVSC)
         tempBaseDir.erase(lastChar);
     }
 
-    // Attempt to open STIL
+    // Save away the current string so we can restore it if needed.
+    const string tempVersionString(versionString);
+
+    setVersionString();
+
+    // This is necessary so the version number gets scanned in from the new
+    // file, too.
+    STILVersion = 0.0;
+
+    // Attempt to load STIL
 
     // Create the full path+filename
     string tempName = tempBaseDir;
     tempName.append(PATH_TO_STIL);
     convertSlashes(tempName);
 
-    ifstream stilFile(tempName.c_str(), STILopenFlags);
+    const STILerror stilError = loadIndex(tempName, tempStilIndex, true);
 
-    if (stilFile.fail())
+    if (stilError != NO_STIL_ERROR)
     {
-        CERR_STIL_DEBUG << "setBaseDir() open failed for " << tempName << endl;
-        lastError = STIL_OPEN;
+        CERR_STIL_DEBUG << "setBaseDir() failed for " << tempName << endl;
+        lastError = stilError;
+
+        // Clean up and restore things.
+        STILVersion = tempSTILVersion;
+        versionString = tempVersionString;
         return false;
     }
 
-    CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << tempName << endl;
-
-    // Attempt to open BUGlist
+    // Attempt to load BUGlist
 
     // Create the full path+filename
     tempName = tempBaseDir;
     tempName.append(PATH_TO_BUGLIST);
     convertSlashes(tempName);
 
-    ifstream bugFile(tempName.c_str(), STILopenFlags);
-
-    if (bugFile.fail())
+    if (loadIndex(tempName, tempBugIndex, false) != NO_STIL_ERROR)
     {
         // This is not a critical error - some earlier versions of HVSC did
-        // not have a BUGlist.txt file at all.
+        // not have a BUGlist.txt file at all, and it is possible that the
+        // BUGlist.txt file has no entries in it at all (in fact, that's
+        // good!).
 
-        CERR_STIL_DEBUG << "setBaseDir() open failed for " << tempName << endl;
+        CERR_STIL_DEBUG << "setBaseDir() failed for " << tempName << endl;
         lastError = BUG_OPEN;
     }
-    else
-    {
-        CERR_STIL_DEBUG << "setBaseDir(): open succeeded for " << tempName << endl;
-    }
 
-    // Find out what the EOL really is
-    if (determineEOL(stilFile) != true)
-    {
-        CERR_STIL_DEBUG << "determinEOL() failed" << endl;
-        lastError = NO_EOL;
-        return false;
-    }
-
-    // Save away the current string so we can restore it if needed.
-    const string tempVersionString(versionString);
-
-    setVersionString();
-
-    // This is necessary so the version number gets scanned in from the new
-    // file, too.
-    STILVersion = 0.0;
-
-    // These will populate the tempStilDirs and tempBugDirs maps (or not :)
-
-    if (getDirs(stilFile, tempStilDirs, true) != true)
-    {
-        CERR_STIL_DEBUG << "getDirs() failed for stilFile" << endl;
-        lastError = NO_STIL_DIRS;
-
-        // Clean up and restore things.
-        STILVersion = tempSTILVersion;
-        versionString = tempVersionString;
-        return false;
-    }
-
-    if (bugFile.good())
-    {
-        if (getDirs(bugFile, tempBugDirs, false) != true)
-        {
-            // This is not a critical error - it is possible that the
-            // BUGlist.txt file has no entries in it at all (in fact, that's
-            // good!).
-
-            CERR_STIL_DEBUG << "getDirs() failed for bugFile" << endl;
-            lastError = BUG_OPEN;
-        }
-    }
-
-    // Now we can copy the stuff into private data.
+    // Now we can move the stuff into private data.
     // NOTE: At this point, STILVersion and the versionString should contain
     // the new info!
 
-    // Copy.
     baseDir = tempBaseDir;
-    stilDirs = tempStilDirs;
-    bugDirs = tempBugDirs;
-
-    // Clear the buffers (caches).
-    entrybuf.clear();
-    globalbuf.clear();
-    bugbuf.clear();
+    stilIndex.text.swap(tempStilIndex.text);
+    stilIndex.entries.swap(tempStilIndex.entries);
+    bugIndex.text.swap(tempBugIndex.text);
+    bugIndex.entries.swap(tempBugIndex.entries);
 
     CERR_STIL_DEBUG << "setBaseDir() succeeded" << endl;
 
@@ -308,76 +266,14 @@ STIL::getEntry(const char *relPathToEntry, int tuneNo, STILField field)
 
     CERR_STIL_DEBUG << "getEntry() called, relPath=" << relPathToEntry << ", rest=" << tuneNo << "," << field << endl;
 
-    if (baseDir.empty())
-    {
-        CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
-        lastError = STIL_OPEN;
-        return NULL;
-    }
-
-    const size_t relPathToEntryLen = strlen(relPathToEntry);
-
-    // Fail if a section-global comment was asked for.
-
-    if (*(relPathToEntry + relPathToEntryLen - 1) == '/')
-    {
-        CERR_STIL_DEBUG << "getEntry() section-global comment was asked for - failed" << endl;
-        lastError = WRONG_ENTRY;
-        return NULL;
-    }
-
-    if (STILVersion < 2.59f)
-    {
-        // Older version of STIL is detected.
-
-        tuneNo = 0;
-        field = all;
-    }
-
-    // Find out whether we have this entry in the buffer.
-
-    if ((!stringutils::equal(entrybuf.data(), relPathToEntry, relPathToEntryLen))
-        || ((entrybuf.find_first_of('\n') != relPathToEntryLen)
-        && (STILVersion > 2.59f)))
-    {
-        // The relative pathnames don't match or they're not the same length:
-        // we don't have it in the buffer, so pull it in.
-
-        CERR_STIL_DEBUG << "getEntry(): entry not in buffer" << endl;
-
-        // Create the full path+filename
-        string tempName(baseDir);
-        tempName.append(PATH_TO_STIL);
-        convertSlashes(tempName);
-
-        ifstream stilFile(tempName.c_str(), STILopenFlags);
-
-        if (stilFile.fail())
-        {
-            CERR_STIL_DEBUG << "getEntry() open failed for stilFile" << endl;
-            lastError = STIL_OPEN;
-            return NULL;
-        }
-
-        CERR_STIL_DEBUG << "getEntry() open succeeded for stilFile" << endl;
-
-        if (positionToEntry(relPathToEntry, stilFile, stilDirs) == false)
-        {
-            // Copy the entry's name to the buffer.
-            entrybuf.assign(relPathToEntry).append("\n");
-            CERR_STIL_DEBUG << "getEntry() posToEntry() failed" << endl;
-            lastError = NOT_IN_STIL;
-        }
-        else
-        {
-            entrybuf.clear();
-            readEntry(stilFile, entrybuf);
-            CERR_STIL_DEBUG << "getEntry() entry read" << endl;
-        }
-    }
+    return lookupEntry(resultEntry, relPathToEntry, tuneNo, field, lastError) ? resultEntry.c_str() : NULL;
+}
 
-    // Put the requested field into the result string.
-    return getField(resultEntry, entrybuf.c_str(), tuneNo, field) ? resultEntry.c_str() : NULL;
+bool
+STIL::getEntry(string &result, const char *relPathToEntry, int tuneNo, STILField field) const
+{
+    STILerror error;
+    return lookupEntry(result, relPathToEntry, tuneNo, field, error);
 }
 
 const char *
@@ -416,68 +312,14 @@ STIL::getBug(const char *relPathToEntry, int tuneNo)
 
     CERR_STIL_DEBUG << "getBug() called, relPath=" << relPathToEntry << ", rest=" << tuneNo << endl;
 
-    if (baseDir.empty())
-    {
-        CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
-        lastError = BUG_OPEN;
-        return NULL;
-    }
-
-    // Older version of STIL is detected.
-
-    if (STILVersion < 2.59f)
-    {
-        tuneNo = 0;
-    }
-
-    // Find out whether we have this bug entry in the buffer.
-    // If the baseDir was changed, we'll have to read it in again,
-    // even if it might be in the buffer already.
-
-    const size_t relPathToEntryLen = strlen(relPathToEntry);
-
-    if ((!stringutils::equal(bugbuf.data(), relPathToEntry, relPathToEntryLen)) ||
-        ((bugbuf.find_first_of('\n') != relPathToEntryLen) &&
-         (STILVersion > 2.59f)))
-    {
-        // The relative pathnames don't match or they're not the same length:
-        // we don't have it in the buffer, so pull it in.
-
-        CERR_STIL_DEBUG << "getBug(): entry not in buffer" << endl;
-
-        // Create the full path+filename
-        string tempName(baseDir);
-        tempName.append(PATH_TO_BUGLIST);
-        convertSlashes(tempName);
-
-        ifstream bugFile(tempName.c_str(), STILopenFlags);
-
-        if (bugFile.fail())
-        {
-            CERR_STIL_DEBUG << "getBug() open failed for bugFile" << endl;
-            lastError = BUG_OPEN;
-            return NULL;
-        }
-
-        CERR_STIL_DEBUG << "getBug() open succeeded for bugFile" << endl;
-
-        if (positionToEntry(relPathToEntry, bugFile, bugDirs) == false)
-        {
-            // Copy the entry's name to the buffer.
-            bugbuf.assign(relPathToEntry).append("\n");
-            CERR_STIL_DEBUG << "getBug() posToEntry() failed" << endl;
-            lastError = NOT_IN_BUG;
-        }
-        else
-        {
-            bugbuf.clear();
-            readEntry(bugFile, bugbuf);
-            CERR_STIL_DEBUG << "getBug() entry read" << endl;
-        }
-    }
+    return lookupBug(resultBug, relPathToEntry, tuneNo, lastError) ? resultBug.c_str() : NULL;
+}
 
-    // Put the requested field into the result string.
-    return getField(resultBug, bugbuf.c_str(), tuneNo) ? resultBug.c_str() : NULL;
+bool
+STIL::getBug(string &result, const char *relPathToEntry, int tuneNo) const
+{
+    STILerror error;
+    return lookupBug(result, relPathToEntry, tuneNo, error);
 }
 
 const char *
@@ -516,339 +358,274 @@ STIL::getGlobalComment(const char *relPathToEntry)
 
     CERR_STIL_DEBUG << "getGC() called, relPath=" << relPathToEntry << endl;
 
-    if (baseDir.empty())
-    {
-        CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
-        lastError = STIL_OPEN;
-        return NULL;
-    }
-
-    // Save the dirpath.
-
-    const char *lastSlash = strrchr(relPathToEntry, '/');
-
-    if (lastSlash == NULL)
-    {
-        lastError = WRONG_DIR;
-        return NULL;
-    }
-
-    const size_t pathLen = lastSlash - relPathToEntry + 1;
-    const string dir(relPathToEntry, pathLen);
-
-    // Find out whether we have this global comment in the buffer.
-    // If the baseDir was changed, we'll have to read it in again,
-    // even if it might be in the buffer already.
-
-    if ((!stringutils::equal(globalbuf.data(), dir.data(), pathLen)) ||
-        ((globalbuf.find_first_of('\n') != pathLen) &&
-         (STILVersion > 2.59f)))
-    {
-        // The relative pathnames don't match or they're not the same length:
-        // we don't have it in the buffer, so pull it in.
-
-        CERR_STIL_DEBUG << "getGC(): entry not in buffer" << endl;
-
-        // Create the full path+filename
-        string tempName(baseDir);
-        tempName.append(PATH_TO_STIL);
-        convertSlashes(tempName);
-
-        ifstream stilFile(tempName.c_str(), STILopenFlags);
-
-        if (stilFile.fail())
-        {
-            CERR_STIL_DEBUG << "getGC() open failed for stilFile" << endl;
-            lastError = STIL_OPEN;
-            return NULL;
-        }
-
-        if (positionToEntry(dir.c_str(), stilFile, stilDirs) == false)
-        {
-            // Copy the dirname to the buffer.
-            globalbuf.assign(dir).append("\n");
-            CERR_STIL_DEBUG << "getGC() posToEntry() failed" << endl;
-            lastError = NOT_IN_STIL;
-        }
-        else
-        {
-            globalbuf.clear();
-            readEntry(stilFile, globalbuf);
-            CERR_STIL_DEBUG << "getGC() entry read" << endl;
-        }
-    }
-
-    CERR_STIL_DEBUG << "getGC() globalbuf=" << globalbuf << endl;
-    CERR_STIL_DEBUG << "-=END=-" << endl;
-
-    // Position pointer to the global comment field.
-
-    const size_t temp = globalbuf.find_first_of('\n') + 1;
+    return lookupGlobalComment(globalbuf, relPathToEntry, lastError) ? globalbuf.c_str() : NULL;
+}
 
-    // Check whether this is a NULL entry or not.
-    return temp != globalbuf.size() ? globalbuf.c_str() + temp : NULL;
+bool
+STIL::getGlobalComment(string &result, const char *relPathToEntry) const
+{
+    STILerror error;
+    return lookupGlobalComment(result, relPathToEntry, error);
 }
 
 //////// PRIVATE
 
-bool
-STIL::determineEOL(ifstream &stilFile)
+STIL::STILerror
+STIL::loadIndex(const string &fileName, textIndex &index, bool isSTILFile)
 {
-    CERR_STIL_DEBUG << "detEOL() called" << endl;
+    CERR_STIL_DEBUG << "loadIndex() called, fileName=" << fileName << endl;
+
+    ifstream inFile(fileName.c_str(), STILopenFlags);
 
-    if (stilFile.fail())
+    if (inFile.fail())
     {
-        CERR_STIL_DEBUG << "detEOL() open failed" << endl;
-        return false;
+        CERR_STIL_DEBUG << "loadIndex() open failed for " << fileName << endl;
+        return isSTILFile ? STIL_OPEN : BUG_OPEN;
     }
 
-    stilFile.seekg(0);
-
-    STIL_EOL = '\0';
-    STIL_EOL2 = '\0';
+    ostringstream contents;
+    contents << inFile.rdbuf();
+    const string raw = contents.str();
 
-    // Determine what the EOL character is
+    // Find out what the EOL really is
     // (it can be different from OS to OS).
-    istream::sentry se(stilFile, true);
-    if (se)
+    if (raw.find_first_of("\r\n") == string::npos)
     {
-        streambuf *sb = stilFile.rdbuf();
+        // Something is wrong - no EOL-like char was found.
+        CERR_STIL_DEBUG << "loadIndex() no EOL found" << endl;
+        return isSTILFile ? NO_EOL : BUG_OPEN;
+    }
 
-        const int eof = char_traits<char>::eof();
+    // Convert the line endings so that entries can be
+    // copied out verbatim.
+    string &text = index.text;
+    text.clear();
+    text.reserve(raw.size() + 1);
 
-        while (sb->sgetc() != eof)
+    for (string::const_iterator it = raw.begin(); it != raw.end(); ++it)
+    {
+        if (*it == '\r')
         {
-            const int c = sb->sbumpc();
-            if ((c == '\n') || (c == '\r'))
-            {
-                STIL_EOL = c;
-
-                if (c == '\r')
-                {
-                    if (sb->sgetc() == '\n')
-                        STIL_EOL2 = '\n';
-                }
-                break;
-            }
+            if ((it + 1) != raw.end() && *(it + 1) == '\n')
+                ++it;
+            text.push_back('\n');
+        }
+        else
+        {
+            text.push_back(*it);
         }
     }
 
-    if (STIL_EOL == '\0')
+    if (text[text.size() - 1] != '\n')
     {
-        // Something is wrong - no EOL-like char was found.
-        CERR_STIL_DEBUG << "detEOL() no EOL found" << endl;
-        return false;
+        text.push_back('\n');
     }
 
-    CERR_STIL_DEBUG << "detEOL() EOL1=0x" << hex << static_cast<int>(STIL_EOL) << " EOL2=0x" << hex << static_cast<int>(STIL_EOL2) << dec << endl;
+    size_t pos = 0;
 
-    return true;
-}
-
-bool
-STIL::getDirs(ifstream &inFile, dirList &dirs, bool isSTILFile)
-{
-    bool newDir = !isSTILFile;
-
-    CERR_STIL_DEBUG << "getDirs() called" << endl;
-
-    inFile.seekg(0);
-
-    while (inFile.good())
+    while (pos < text.size())
     {
-        string line;
-
-        getStilLine(inFile, line);
-
-        if (!isSTILFile) { CERR_STIL_DEBUG << line << '\n'; }
+        const size_t eol = text.find('\n', pos);
 
         // Try to extract STIL's version number if it's not done, yet.
 
-        if (isSTILFile && (STILVersion == 0.0f))
+        if (isSTILFile && (STILVersion == 0.0f) && (text.compare(pos, 9, "#  STIL v") == 0))
         {
-            if (strncmp(line.data(), "#  STIL v", 9) == 0)
-            {
-                // Get the version number
-                STILVersion = atof(line.c_str() + 9);
-
-                // Put it into the string, too.
-                ostringstream ss;
-                ss << fixed << setw(4) << setprecision(2);
-                ss << "SID Tune Information List (STIL) v" << STILVersion << endl;
-                versionString.append(ss.str());
+            // Get the version number
+            STILVersion = atof(text.c_str() + pos + 9);
 
-                CERR_STIL_DEBUG << "getDirs() STILVersion=" << STILVersion << endl;
+            // Put it into the string, too.
+            ostringstream ss;
+            ss << fixed << setw(4) << setprecision(2);
+            ss << "SID Tune Information List (STIL) v" << STILVersion << endl;
+            versionString.append(ss.str());
 
-                continue;
-            }
+            CERR_STIL_DEBUG << "loadIndex() STILVersion=" << STILVersion << endl;
         }
 
-        // Search for the start of a dir separator first.
+        // Is this the start of an entry?
 
-        if (isSTILFile && !newDir && stringutils::equal(line.data(), "### ", 4))
+        if (text[pos] == '/')
         {
-            newDir = true;
-            continue;
-        }
+            // The entry runs up to the first empty line
+            const size_t end = text.find("\n\n", eol);
+            const size_t size = ((end == string::npos) ? text.size() : end + 1) - pos;
 
-        // Is this the start of an entry immediately following a dir separator?
+            size_t keyEnd = eol;
 
-        if (newDir && (line[0] == '/'))
-        {
-            // Get the directory only
-            const string dirName(line, 0, line.find_last_of('/') + 1);
-
-            if (!isSTILFile)
+            // Older versions of STIL may have the tune designation on the
+            // first line of an entry together with the pathname.
+            if (STILVersion <= 2.59f)
             {
-                // Compare it to the stored dirnames
-                newDir = (dirs.count(dirName) == 0);
+                const size_t space = text.find_first_of(" \t", pos);
+                if (space < eol)
+                    keyEnd = space;
             }
 
-            // Store the info
-            if (newDir)
-            {
-                const streampos position = inFile.tellg() - (streampos)line.size() - 1L;
-
-                CERR_STIL_DEBUG << "getDirs() dirName=" << dirName << ", pos=" << position <<  endl;
-
-                dirs.insert(make_pair(dirName, position));
-            }
-
-            newDir = !isSTILFile;
+            // Like a sequential search the first entry wins.
+            // Paths are matched regardless of case.
+            index.entries.insert(make_pair(stringutils::lower(text.substr(pos, keyEnd - pos)), textIndex::range_t(pos, size)));
         }
+
+        pos = eol + 1;
     }
 
-    if (dirs.empty())
+    if (index.entries.empty())
     {
         // No entries found - something is wrong.
         // NOTE: It's perfectly valid to have a BUGlist.txt file with no
         // entries in it!
-        CERR_STIL_DEBUG << "getDirs() no dirs found" << endl;
-        return false;
+        CERR_STIL_DEBUG << "loadIndex() no entries found" << endl;
+        return isSTILFile ? NO_STIL_DIRS : NO_BUG_DIRS;
     }
 
-    CERR_STIL_DEBUG << "getDirs() successful" << endl;
+    CERR_STIL_DEBUG << "loadIndex() successful, " << index.entries.size() << " entries" << endl;
 
-    return true;
+    return NO_STIL_ERROR;
 }
 
 bool
-STIL::positionToEntry(const char *entryStr, ifstream &inFile, dirList &dirs)
+STIL::readEntry(const textIndex &index, const char *entryStr, string &buffer) const
 {
-    CERR_STIL_DEBUG << "pos2Entry() called, entryStr=" << entryStr << endl;
-
-    inFile.seekg(0);
+    const textIndex::entries_t::const_iterator elem = index.entries.find(stringutils::lower(entryStr));
 
-    // Get the dirpath.
+    if (elem == index.entries.end())
+    {
+        CERR_STIL_DEBUG << "readEntry() entry not found, entryStr=" << entryStr << endl;
+        return false;
+    }
 
-    char *chrptr = strrchr((char *)entryStr, '/');
+    buffer.assign(index.text, elem->second.first, elem->second.second);
+    return true;
+}
 
-    // If no slash was found, something is screwed up in the entryStr.
+bool
+STIL::lookupEntry(string &result, const char *relPathToEntry, int tuneNo, STILField field, STILerror &error) const
+{
+    result.clear();
+    error = NO_STIL_ERROR;
 
-    if (chrptr == NULL)
+    if (baseDir.empty())
     {
+        CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
+        error = STIL_OPEN;
         return false;
     }
 
-    const size_t pathLen = chrptr - entryStr + 1;
-
-    // Determine whether a section-global comment is asked for.
-
-    const size_t entryStrLen = strlen(entryStr);
-    const bool globComm = (pathLen == entryStrLen);
+    const size_t relPathToEntryLen = strlen(relPathToEntry);
 
-    // Find it in the table.
-    const string entry(entryStr, pathLen);
-    dirList::iterator elem = dirs.find(entry);
+    // Fail if a section-global comment was asked for.
 
-    if (elem == dirs.end())
+    if ((relPathToEntryLen == 0) || (relPathToEntry[relPathToEntryLen - 1] == '/'))
     {
-        // The directory was not found.
-        CERR_STIL_DEBUG << "pos2Entry() did not find the dir" << endl;
+        CERR_STIL_DEBUG << "getEntry() section-global comment was asked for - failed" << endl;
+        error = WRONG_ENTRY;
         return false;
     }
 
-    // Jump to the first entry of this section.
-    inFile.seekg(elem->second);
-    bool foundIt = false;
+    if (STILVersion < 2.59f)
+    {
+        // Older version of STIL is detected.
 
-    // Now find the desired entry
+        tuneNo = 0;
+        field = all;
+    }
 
-    string line;
+    string entry;
 
-    do
+    if (!readEntry(stilIndex, relPathToEntry, entry))
     {
-        getStilLine(inFile, line);
+        error = NOT_IN_STIL;
+        return false;
+    }
 
-        if (inFile.eof())
-        {
-            break;
-        }
+    // Put the requested field into the result string.
+    return getField(result, entry.c_str(), tuneNo, field);
+}
 
-        // Check if it is the start of an entry
+bool
+STIL::lookupBug(string &result, const char *relPathToEntry, int tuneNo, STILerror &error) const
+{
+    result.clear();
+    error = NO_STIL_ERROR;
 
-        if (line[0] == '/')
-        {
-            if (!stringutils::equal(elem->first.data(), line.data(), pathLen))
-            {
-                // We are outside the section - get out of the loop,
-                // which will fail the search.
-                break;
-            }
+    if (baseDir.empty())
+    {
+        CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
+        error = BUG_OPEN;
+        return false;
+    }
 
-            // Check whether we need to find a section-global comment or
-            // a specific entry.
+    // Older version of STIL is detected.
 
-            if (globComm || (STILVersion > 2.59f))
-            {
-                foundIt = stringutils::equal(line.c_str(), entryStr);
-            }
-            else
-            {
-                // To be compatible with older versions of STIL, which may have
-                // the tune designation on the first line of a STIL entry
-                // together with the pathname.
-                foundIt = stringutils::equal(line.data(), entryStr, entryStrLen);
-            }
+    if (STILVersion < 2.59f)
+    {
+        tuneNo = 0;
+    }
 
-            CERR_STIL_DEBUG << "pos2Entry() line=" << line << endl;
-        }
+    string entry;
+
+    if (!readEntry(bugIndex, relPathToEntry, entry))
+    {
+        error = NOT_IN_BUG;
+        return false;
     }
-    while (!foundIt);
 
-    if (foundIt)
+    // Put the requested field into the result string.
+    return getField(result, entry.c_str(), tuneNo);
+}
+
+bool
+STIL::lookupGlobalComment(string &result, const char *relPathToEntry, STILerror &error) const
+{
+    result.clear();
+    error = NO_STIL_ERROR;
+
+    if (baseDir.empty())
     {
-        // Reposition the file pointer back to the start of the entry.
-        inFile.seekg(inFile.tellg() - (streampos)line.size() - 1L);
-        CERR_STIL_DEBUG << "pos2Entry() entry found" << endl;
-        return true;
+        CERR_STIL_DEBUG << "HVSC baseDir is not yet set!" << endl;
+        error = STIL_OPEN;
+        return false;
     }
-    else
+
+    // Save the dirpath.
+
+    const char *lastSlash = strrchr(relPathToEntry, '/');
+
+    if (lastSlash == NULL)
     {
-        CERR_STIL_DEBUG << "pos2Entry() entry not found" << endl;
+        error = WRONG_DIR;
         return false;
     }
-}
 
-void
-STIL::readEntry(ifstream &inFile, string &buffer)
-{
-    string line;
+    const string dir(relPathToEntry, lastSlash - relPathToEntry + 1);
 
-    for (;;)
+    string entry;
+
+    if (!readEntry(stilIndex, dir.c_str(), entry))
     {
-        getStilLine(inFile, line);
+        error = NOT_IN_STIL;
+        return false;
+    }
+
+    CERR_STIL_DEBUG << "getGC() entry=" << entry << endl;
 
-        if (line.size() == 0)
-            break;
+    // Position pointer to the global comment field.
 
-        buffer.append(line);
-        buffer.append("\n");
+    const size_t temp = entry.find_first_of('\n') + 1;
+
+    // Check whether this is a NULL entry or not.
+    if (temp == entry.size())
+    {
+        return false;
     }
+
+    result.assign(entry, temp, string::npos);
+    return true;
 }
 
 bool
-STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
+STIL::getField(string &result, const char *buffer, int tuneNo, STILField field) const
 {
     CERR_STIL_DEBUG << "getField() called, buffer=" << buffer << ", rest=" << tuneNo << "," << field << endl;
 
@@ -1067,7 +844,7 @@ STIL::getField(string &result, const char *buffer, int tuneNo, STILField field)
 }
 
 bool
-STIL::getOneField(string &result, const char *start, const char *end, STILField field)
+STIL::getOneField(string &result, const char *start, const char *end, STILField field) const
 {
     // Sanity checking
 
@@ -1207,21 +984,3 @@ STIL::getOneField(string &result, const char *start, const char *end, STILField
     result.append(temp, nextField - temp);
     return true;
 }
-
-void
-STIL::getStilLine(ifstream &infile, string &line)
-{
-    if (STIL_EOL2 != '\0')
-    {
-        // If there was a remaining EOL char from the previous read, eat it up.
-
-        char temp = infile.peek();
-
-        if ((temp == 0x0d) || (temp == 0x0a))
-        {
-            infile.get(temp);
-        }
-    }
-
-    getline(infile, line, STIL_EOL);
-}
@@ -25,8 +25,8 @@
 
 #include <string>
 #include <algorithm>
-#include <map>
-#include <iosfwd>
+#include <unordered_map>
+#include <utility>
 
 #include "stildefs.h"
 
@@ -236,6 +236,22 @@ public:
      */
     const char *getAbsBug(const char *absPathToEntry, int tuneNo = 0);
 
+    /**
+     * Thread safe versions of #getEntry, #getGlobalComment and #getBug.
+     * The result is copied into 'result' and the last error is not
+     * updated, so these can be called concurrently once
+     * setBaseDir() has returned.
+     *
+     * @return
+     *      - true - 'result' holds the requested information
+     *      - false - there's no such entry or field
+     */
+    //@{
+    bool getEntry(std::string &result, const char *relPathToEntry, int tuneNo = 0, STILField field = all) const;
+    bool getGlobalComment(std::string &result, const char *relPathToEntry) const;
+    bool getBug(std::string &result, const char *relPathToEntry, int tuneNo = 0) const;
+    //@}
+
     /**
      * Returns a specific error number identifying the problem
      * that happened at the last invoked public method.
@@ -268,7 +284,23 @@ public:
     inline const char *getErrorStr() const {return (STIL_ERROR_STR[lastError]);}
 
 private:
-    typedef std::map<std::string, std::streampos> dirList;
+    /**
+     * A text file loaded in memory with an index of its entries.
+     * Entries are keyed by the lower case HVSC relative path on their
+     * first line and map to the byte range of the entry in the text.
+     */
+    struct textIndex
+    {
+        typedef std::pair<size_t, size_t> range_t;
+        typedef std::unordered_map<std::string, range_t> entries_t;
+
+        /// File contents with line endings converted to '\n'
+        std::string text;
+
+        entries_t entries;
+
+        void clear() { text.clear(); entries.clear(); }
+    };
 
     /// Path to STIL.
     const char *PATH_TO_STIL;
@@ -285,19 +317,12 @@ private:
     /// Base dir
     std::string baseDir;
 
-    /// Maps of sections (subdirs) for easier positioning.
+    /// Indexed STIL.txt and BUGlist.txt.
     //@{
-    dirList stilDirs;
-    dirList bugDirs;
+    textIndex stilIndex;
+    textIndex bugIndex;
     //@}
 
-    /**
-     * This tells us what the line delimiter is in STIL.txt.
-     * (It may be two chars!)
-     */
-    char STIL_EOL;
-    char STIL_EOL2;
-
     /// Error number of the last error that happened.
     STILerror lastError;
 
@@ -306,15 +331,9 @@ private:
 
     ////////////////
 
-    /// The last retrieved entry
-    std::string entrybuf;
-
     /// The last retrieved section-global comment
     std::string globalbuf;
 
-    /// The last retrieved BUGentry
-    std::string bugbuf;
-
     /// Buffers to hold the resulting strings
     std::string resultEntry;
     std::string resultBug;
@@ -324,53 +343,33 @@ private:
     void setVersionString();
 
     /**
-     * Determines what the EOL char is (or are) from STIL.txt.
-     * It is assumed that BUGlist.txt will use the same EOL.
-     *
-     * @return
-     *      - false - something went wrong
-     *      - true  - everything is okay
-     */
-    bool determineEOL(std::ifstream &stilFile);
-
-    /**
-     * Populates the given dirList array with the directories
-     * obtained from 'inFile' for faster positioning within
-     * 'inFile'.
+     * Reads 'fileName' into 'index' and indexes its entries.
+     * For the STIL file the version number is also extracted.
      *
-     * @param inFile - where to read the directories from
-     * @param dirs   - the dirList array that should be populated with the
-     *                 directory list
+     * @param fileName   - the file to read
+     * @param index      - where to store the text and the entries
      * @param isSTILFile - is this the STIL or the BUGlist we are parsing
      * @return
-     *      - false - No entries were found or otherwise failed to process
-     *                inFile
-     *      - true  - everything is okay
+     *      - NO_STIL_ERROR if everything is okay, the error otherwise
      */
-    bool getDirs(std::ifstream &inFile, dirList &dirs, bool isSTILFile);
+    STILerror loadIndex(const std::string &fileName, textIndex &index, bool isSTILFile);
 
     /**
-     * Positions the file pointer to the given entry in 'inFile'
-     * using the 'dirs' dirList for faster positioning.
+     * Copies the entry for 'entryStr' from 'index' into 'buffer'
+     * in standard STIL format.
      *
-     * @param entryStr - the entry to position to
-     * @param inFile   - position the file pointer in this file
-     * @param dirs     - the list of dirs in inFile for easier positioning
      * @return
-     *      - true - if successful
+     *      - true - if the entry was found
      *      - false - otherwise
      */
-    bool positionToEntry(const char *entryStr, std::ifstream &inFile, dirList &dirs);
+    bool readEntry(const textIndex &index, const char *entryStr, std::string &buffer) const;
 
-    /**
-     * Reads the entry from 'inFile' into 'buffer'. 'inFile' should
-     * already be positioned to the entry to be read.
-     *
-     * @param inFile   - filehandle of file to read from
-     * @param entryStr - the entry needed to be read
-     * @param buffer   - where to put the result to
-     */
-    void readEntry(std::ifstream &inFile, std::string &buffer);
+    /// Lookups shared by the caching and the thread safe accessors.
+    //@{
+    bool lookupEntry(std::string &result, const char *relPathToEntry, int tuneNo, STILField field, STILerror &error) const;
+    bool lookupGlobalComment(std::string &result, const char *relPathToEntry, STILerror &error) const;
+    bool lookupBug(std::string &result, const char *relPathToEntry, int tuneNo, STILerror &error) const;
+    //@}
 
     /**
      * Given a STIL formatted entry in 'buffer', a tune number,
@@ -389,7 +388,7 @@ private:
      *      - false - if nothing was put into 'result'
      *      - true  - 'result' has the resulting field
      */
-    bool getField(std::string &result, const char *buffer, int tuneNo = 0, STILField field = all);
+    bool getField(std::string &result, const char *buffer, int tuneNo = 0, STILField field = all) const;
 
     /**
      * @param result - where to put the resulting string to (if any)
@@ -403,18 +402,8 @@ private:
      *      - false - if nothing was put into 'result'
      *      - true  - 'result' has the resulting field
      */
-    bool getOneField(std::string &result, const char *start, const char *end, STILField field);
+    bool getOneField(std::string &result, const char *start, const char *end, STILField field) const;
 
-    /**
-     * Extracts one line from 'infile' to 'line[]'. The end of
-     * the line is marked by endOfLineChar. Also eats up
-     * additional EOL-like chars.
-     *
-     * @param infile - filehandle (streampos should already be positioned
-     *                 to the start of the desired line)
-     * @param line   - char array to put the line into
-     */
-    void getStilLine(std::ifstream &infile, std::string &line);
 };
 
 #endif // STIL_H
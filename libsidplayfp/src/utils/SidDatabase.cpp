@@ -22,6 +22,7 @@
 
 #include <cctype>
 #include <cstdlib>
+#include <string>
 
 #include "SidDatabase.h"
 
@@ -29,6 +30,7 @@
 #include "sidplayfp/SidTuneInfo.h"
 
 #include "iniParser.h"
+#include "SongLengthIndex.h"
 
 #include "sidcxx11.h"
 
@@ -37,11 +39,15 @@ const char ERR_NO_DATABASE_LOADED[]      = "SID DATABASE ERROR: Songlength datab
 const char ERR_NO_SELECTED_SONG[]        = "SID DATABASE ERROR: No song selected for retrieving song length.";
 const char ERR_MEM_ALLOC[]               = "SID DATABASE ERROR: Memory Allocation Failure.";
 const char ERR_UNABLE_TO_LOAD_DATABASE[] = "SID DATABASE ERROR: Unable to load the songlegnth database.";
+const char ERR_UNABLE_TO_LOAD_INDEX[]    = "SID DATABASE ERROR: Unable to load the songlength index.";
+
+const char INDEX_EXTENSION[] = ".idx";
 
 class parseError {};
 
 SidDatabase::SidDatabase() :
     m_parser(0),
+    m_index(0),
     errorString(ERR_NO_DATABASE_LOADED)
 {}
 
@@ -75,6 +81,17 @@ const char *parseTime(const char *str, long &result)
 
 bool SidDatabase::open(const char *filename)
 {
+    close();
+
+    // Prefer the compiled index if it's up to date
+    const std::string indexName = std::string(filename) + INDEX_EXTENSION;
+    m_index.reset(new libsidplayfp::SongLengthIndex());
+    if (m_index->open(indexName.c_str(), filename))
+    {
+        return true;
+    }
+    m_index.reset(nullptr);
+
     m_parser.reset(new libsidplayfp::iniParser());
 
     if (!m_parser->open(filename))
@@ -87,9 +104,34 @@ bool SidDatabase::open(const char *filename)
     return true;
 }
 
+bool SidDatabase::openIndex(const char *filename)
+{
+    close();
+
+    m_index.reset(new libsidplayfp::SongLengthIndex());
+    if (!m_index->open(filename, nullptr))
+    {
+        close();
+        errorString = ERR_UNABLE_TO_LOAD_INDEX;
+        return false;
+    }
+
+    return true;
+}
+
+bool SidDatabase::buildIndex(const char *filename, const char *indexName)
+{
+    const std::string name = indexName != nullptr
+        ? std::string(indexName)
+        : std::string(filename) + INDEX_EXTENSION;
+
+    return libsidplayfp::SongLengthIndex::build(filename, name.c_str());
+}
+
 void SidDatabase::close()
 {
     m_parser.reset(nullptr);
+    m_index.reset(nullptr);
 }
 
 int_least32_t SidDatabase::length(SidTune &tune)
@@ -109,6 +151,16 @@ int_least32_t SidDatabase::length(SidTune &tune)
 
 int_least32_t SidDatabase::length(const char *md5, unsigned int song)
 {
+    if (m_index.get() != nullptr)
+    {
+        const int_least32_t time = m_index->length(md5, song);
+        if (time < 0)
+        {
+            errorString = ERR_DATABASE_CORRUPT;
+        }
+        return time;
+    }
+
     if (m_parser.get() == nullptr)
     {
         errorString = ERR_NO_DATABASE_LOADED;
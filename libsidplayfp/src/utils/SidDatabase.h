@@ -33,6 +33,7 @@ class SidTune;
 namespace libsidplayfp
 {
 class iniParser;
+class SongLengthIndex;
 }
 
 /**
@@ -44,6 +45,8 @@ class SID_EXTERN SidDatabase
 private:
     std::auto_ptr<libsidplayfp::iniParser> m_parser;
 
+    std::auto_ptr<libsidplayfp::SongLengthIndex> m_index;
+
     const char *errorString;
 
 public:
@@ -52,12 +55,35 @@ public:
 
     /**
      * Open the songlength DataBase.
+     * If an up to date compiled index named after the file
+     * with an added ".idx" extension exists it is used instead.
      *
      * @param filename songlengthDB file name with full path.
      * @return false in case of errors, true otherwise.
      */
     bool open(const char *filename);
 
+    /**
+     * Open a compiled songlength index.
+     * The index is memory mapped and not checked against
+     * the text DataBase it was built from.
+     *
+     * @param filename index file name with full path.
+     * @return false in case of errors, true otherwise.
+     */
+    bool openIndex(const char *filename);
+
+    /**
+     * Compile the songlength DataBase into a binary index
+     * for faster loading and lookups.
+     *
+     * @param filename songlengthDB file name with full path.
+     * @param indexName the index file to write, if null the DataBase
+     *                  file name with an added ".idx" extension.
+     * @return false in case of errors, true otherwise.
+     */
+    static bool buildIndex(const char *filename, const char *indexName = nullptr);
+
     /**
      * Close the songlength DataBase.
      */
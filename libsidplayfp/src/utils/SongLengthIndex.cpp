@@ -0,0 +1,411 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "SongLengthIndex.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_UNISTD_H
+#  include <unistd.h>
+#endif
+
+#ifdef HAVE_SYS_MMAN_H
+#  include <sys/mman.h>
+#  include <fcntl.h>
+#endif
+
+#include "sidcxx11.h"
+
+namespace libsidplayfp
+{
+
+/// Bump when the file layout changes.
+const uint32_t INDEX_VERSION = 1;
+
+const char INDEX_MAGIC[8] = { 'S', 'I', 'D', 'L', 'E', 'N', 'D', 'B' };
+
+const unsigned int DIGEST_SIZE = 16;
+
+struct header_t
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t buckets;     ///< hash table size, a power of two
+    uint32_t lengths;     ///< number of entries in the lengths array
+    uint32_t reserved;
+    uint64_t sourceSize;  ///< size of the text database
+    int64_t sourceTime;   ///< modification time of the text database
+};
+
+struct entry_t
+{
+    unsigned char digest[DIGEST_SIZE];
+    uint32_t offset;      ///< first length in the lengths array
+    uint32_t songs;       ///< number of subtunes, zero for empty buckets
+};
+
+static_assert(sizeof(header_t) == 40, "Unexpected index header size");
+static_assert(sizeof(entry_t) == 24, "Unexpected index entry size");
+
+static bool parseDigest(const char *str, unsigned char *digest)
+{
+    for (unsigned int i = 0; i < DIGEST_SIZE * 2; i++)
+    {
+        const int c = tolower(static_cast<unsigned char>(str[i]));
+        int value;
+        if (c >= '0' && c <= '9')
+            value = c - '0';
+        else if (c >= 'a' && c <= 'f')
+            value = c - 'a' + 10;
+        else
+            return false;
+
+        if (i & 1)
+            digest[i >> 1] |= value;
+        else
+            digest[i >> 1] = value << 4;
+    }
+
+    return str[DIGEST_SIZE * 2] == '\0';
+}
+
+/**
+ * Fold the digest into a bucket hash. Real MD5 digests are already
+ * well distributed but mixing both halves keeps the table usable
+ * with any key set.
+ */
+static inline uint32_t hash(const unsigned char *digest)
+{
+    uint64_t lo, hi;
+    memcpy(&lo, digest, sizeof(lo));
+    memcpy(&hi, digest + sizeof(lo), sizeof(hi));
+
+    // MurmurHash3 finalizer
+    uint64_t h = lo ^ (hi * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<uint32_t>(h);
+}
+
+static bool sourceStat(const char *source, uint64_t &size, int64_t &time)
+{
+    struct stat st;
+    if (stat(source, &st) != 0)
+        return false;
+
+    size = st.st_size;
+    time = st.st_mtime;
+    return true;
+}
+
+/**
+ * Parse the "m:ss" lengths of a database entry, following the
+ * same rules as the text database lookup: fractions of a second
+ * and attributes like "(G)" are skipped.
+ */
+static void parseLengths(const char *str, std::vector<uint32_t> &lengths)
+{
+    for (;;)
+    {
+        while (isspace(static_cast<unsigned char>(*str)))
+            str++;
+
+        if (*str == '\0')
+            return;
+
+        char *end;
+        const long minutes = strtol(str, &end, 10);
+        if (*end != ':')
+            return;
+
+        const long seconds = strtol(end + 1, &end, 10);
+        lengths.push_back(static_cast<uint32_t>(minutes * 60 + seconds));
+
+        while (*end != '\0' && !isspace(static_cast<unsigned char>(*end)))
+            end++;
+
+        str = end;
+    }
+}
+
+bool SongLengthIndex::build(const char *source, const char *index)
+{
+    std::ifstream in(source);
+    if (in.fail())
+        return false;
+
+    header_t header;
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.reserved = 0;
+    if (!sourceStat(source, header.sourceSize, header.sourceTime))
+        return false;
+
+    std::vector<entry_t> entries;
+    std::vector<uint32_t> lengths;
+
+    bool database = false;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (line.empty() || line[0] == ';' || line[0] == '#')
+            continue;
+
+        if (line[0] == '[')
+        {
+            database = line.compare(0, 10, "[Database]") == 0;
+            continue;
+        }
+
+        const size_t pos = line.find('=');
+        if (!database || pos == std::string::npos)
+            continue;
+
+        const std::string key = line.substr(0, line.find_last_not_of(' ', pos - 1) + 1);
+
+        entry_t entry;
+        if (!parseDigest(key.c_str(), entry.digest))
+            continue;
+
+        entry.offset = lengths.size();
+        parseLengths(line.c_str() + pos + 1, lengths);
+        entry.songs = lengths.size() - entry.offset;
+
+        if (entry.songs != 0)
+            entries.push_back(entry);
+    }
+
+    // Keep the load factor at 50% at most
+    uint32_t buckets = 1;
+    while (buckets < entries.size() * 2)
+        buckets <<= 1;
+
+    entry_t empty;
+    memset(&empty, 0, sizeof(entry_t));
+    std::vector<entry_t> table(buckets, empty);
+
+    for (std::vector<entry_t>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        uint32_t i = hash(it->digest) & (buckets - 1);
+        while (table[i].songs != 0 && memcmp(table[i].digest, it->digest, DIGEST_SIZE) != 0)
+            i = (i + 1) & (buckets - 1);
+
+        // Like the text database the first entry wins
+        if (table[i].songs == 0)
+            table[i] = *it;
+    }
+
+    header.buckets = buckets;
+    header.lengths = lengths.size();
+
+    // Write to a private file and rename it in place so that
+    // concurrent readers never see a partial file.
+    std::string tmpPath(index);
+#ifdef HAVE_UNISTD_H
+    tmpPath.append(".").append(std::to_string(static_cast<long>(getpid())));
+#endif
+    tmpPath.append(".tmp");
+
+    FILE *f = fopen(tmpPath.c_str(), "wb");
+    if (f == nullptr)
+        return false;
+
+    bool ok = fwrite(&header, sizeof(header_t), 1, f) == 1
+        && fwrite(&table[0], sizeof(entry_t), table.size(), f) == table.size()
+        && (lengths.empty() || fwrite(&lengths[0], sizeof(uint32_t), lengths.size(), f) == lengths.size());
+
+    if (fclose(f) != 0)
+        ok = false;
+
+#ifdef _WIN32
+    // rename doesn't replace existing files on Windows
+    remove(index);
+#endif
+    if (!ok || rename(tmpPath.c_str(), index) != 0)
+    {
+        remove(tmpPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+SongLengthIndex::SongLengthIndex() :
+    m_data(nullptr),
+    m_size(0),
+    m_mapped(false),
+    m_mask(0),
+    m_count(0),
+    m_table(nullptr),
+    m_lengths(nullptr) {}
+
+SongLengthIndex::~SongLengthIndex()
+{
+    close();
+}
+
+bool SongLengthIndex::open(const char *index, const char *source)
+{
+    close();
+
+#ifdef HAVE_SYS_MMAN_H
+    const int fd = ::open(index, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void *map = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            m_data = static_cast<const unsigned char*>(map);
+            m_size = st.st_size;
+            m_mapped = true;
+        }
+    }
+
+    ::close(fd);
+#else
+    FILE *f = fopen(index, "rb");
+    if (f == nullptr)
+        return false;
+
+    if (fseek(f, 0, SEEK_END) == 0)
+    {
+        const long size = ftell(f);
+        if (size > 0 && fseek(f, 0, SEEK_SET) == 0)
+        {
+            m_buffer.resize(size);
+            if (fread(&m_buffer[0], 1, size, f) == static_cast<size_t>(size))
+            {
+                m_data = &m_buffer[0];
+                m_size = size;
+            }
+        }
+    }
+
+    fclose(f);
+#endif
+
+    if (!validate(source))
+    {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SongLengthIndex::validate(const char *source)
+{
+    if (m_data == nullptr || m_size < sizeof(header_t))
+        return false;
+
+    header_t header;
+    memcpy(&header, m_data, sizeof(header_t));
+
+    if (memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0
+        || header.version != INDEX_VERSION
+        || header.buckets == 0
+        || (header.buckets & (header.buckets - 1)) != 0)
+        return false;
+
+    const uint64_t size = sizeof(header_t)
+        + static_cast<uint64_t>(header.buckets) * sizeof(entry_t)
+        + static_cast<uint64_t>(header.lengths) * sizeof(uint32_t);
+    if (size != m_size)
+        return false;
+
+    if (source != nullptr)
+    {
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        if (!sourceStat(source, sourceSize, sourceTime)
+            || sourceSize != header.sourceSize
+            || sourceTime != header.sourceTime)
+            return false;
+    }
+
+    m_mask = header.buckets - 1;
+    m_count = header.lengths;
+    m_table = m_data + sizeof(header_t);
+    m_lengths = reinterpret_cast<const uint32_t*>(m_table + header.buckets * sizeof(entry_t));
+
+    return true;
+}
+
+void SongLengthIndex::close()
+{
+#ifdef HAVE_SYS_MMAN_H
+    if (m_mapped)
+        munmap(const_cast<unsigned char*>(m_data), m_size);
+#endif
+
+    std::vector<unsigned char>().swap(m_buffer);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_mask = 0;
+    m_count = 0;
+    m_table = nullptr;
+    m_lengths = nullptr;
+}
+
+int_least32_t SongLengthIndex::length(const char *md5, unsigned int song) const
+{
+    unsigned char digest[DIGEST_SIZE];
+    if (m_table == nullptr || song == 0 || !parseDigest(md5, digest))
+        return -1;
+
+    const entry_t *table = reinterpret_cast<const entry_t*>(m_table);
+
+    // The probe count is bounded so that a damaged file can't hang us
+    uint32_t i = hash(digest) & m_mask;
+    for (uint32_t probes = 0; probes <= m_mask && table[i].songs != 0; probes++)
+    {
+        if (memcmp(table[i].digest, digest, DIGEST_SIZE) == 0)
+        {
+            const uint64_t pos = static_cast<uint64_t>(table[i].offset) + song - 1;
+            return (song <= table[i].songs && pos < m_count) ? m_lengths[pos] : -1;
+        }
+        i = (i + 1) & m_mask;
+    }
+
+    return -1;
+}
+
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef SONGLENGTHINDEX_H
+#define SONGLENGTHINDEX_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace libsidplayfp
+{
+
+/**
+ * Compiled songlength database.
+ *
+ * The index is built from the Songlengths.txt file, which stays
+ * the reference, and is laid out so that it can be used directly
+ * from a memory mapped file: a header, an open addressing hash
+ * table keyed by the MD5 digest and the packed subtune lengths.
+ * The header records size and modification time of the text file
+ * so that a stale index can be detected.
+ *
+ * The file is in native byte order, it is meant to be built
+ * on the machine that uses it.
+ */
+class SongLengthIndex
+{
+private:
+    const unsigned char *m_data;
+    size_t m_size;
+
+    /// Whether m_data is a memory mapping
+    bool m_mapped;
+
+    /// Holds the file contents when memory mapping is not available
+    std::vector<unsigned char> m_buffer;
+
+    uint32_t m_mask;
+    uint32_t m_count;
+    const unsigned char *m_table;
+    const uint32_t *m_lengths;
+
+private:
+    bool validate(const char *source);
+
+public:
+    SongLengthIndex();
+    ~SongLengthIndex();
+
+    /**
+     * Compile a text database into an index file.
+     *
+     * @param source the Songlengths.txt file
+     * @param index the file to create
+     * @return false in case of errors
+     */
+    static bool build(const char *source, const char *index);
+
+    /**
+     * Open an index file.
+     *
+     * @param index the index file
+     * @param source if not null the text file the index must be up to date with
+     * @return false if the file is missing, invalid or stale
+     */
+    bool open(const char *index, const char *source);
+
+    void close();
+
+    /**
+     * Get the length of a subtune.
+     *
+     * @param md5 the md5 hash of the tune, in hex
+     * @param song the subtune, starting from 1
+     * @return tune length in seconds, -1 if not found
+     */
+    int_least32_t length(const char *md5, unsigned int song) const;
+};
+
+}
+
+#endif // SONGLENGTHINDEX_H
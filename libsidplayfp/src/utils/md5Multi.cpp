@@ -0,0 +1,417 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include "md5Multi.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+#  include <immintrin.h>
+#endif
+
+namespace libsidplayfp
+{
+
+namespace md5Multi
+{
+
+/**
+ * The 64 MD5 steps from RFC 1321:
+ * function, registers, message word, rotation and additive constant.
+ */
+#define MD5_STEPS(STEP) \
+    STEP(F, a, b, c, d,  0,  7, 0xd76aa478) \
+    STEP(F, d, a, b, c,  1, 12, 0xe8c7b756) \
+    STEP(F, c, d, a, b,  2, 17, 0x242070db) \
+    STEP(F, b, c, d, a,  3, 22, 0xc1bdceee) \
+    STEP(F, a, b, c, d,  4,  7, 0xf57c0faf) \
+    STEP(F, d, a, b, c,  5, 12, 0x4787c62a) \
+    STEP(F, c, d, a, b,  6, 17, 0xa8304613) \
+    STEP(F, b, c, d, a,  7, 22, 0xfd469501) \
+    STEP(F, a, b, c, d,  8,  7, 0x698098d8) \
+    STEP(F, d, a, b, c,  9, 12, 0x8b44f7af) \
+    STEP(F, c, d, a, b, 10, 17, 0xffff5bb1) \
+    STEP(F, b, c, d, a, 11, 22, 0x895cd7be) \
+    STEP(F, a, b, c, d, 12,  7, 0x6b901122) \
+    STEP(F, d, a, b, c, 13, 12, 0xfd987193) \
+    STEP(F, c, d, a, b, 14, 17, 0xa679438e) \
+    STEP(F, b, c, d, a, 15, 22, 0x49b40821) \
+    STEP(G, a, b, c, d,  1,  5, 0xf61e2562) \
+    STEP(G, d, a, b, c,  6,  9, 0xc040b340) \
+    STEP(G, c, d, a, b, 11, 14, 0x265e5a51) \
+    STEP(G, b, c, d, a,  0, 20, 0xe9b6c7aa) \
+    STEP(G, a, b, c, d,  5,  5, 0xd62f105d) \
+    STEP(G, d, a, b, c, 10,  9, 0x02441453) \
+    STEP(G, c, d, a, b, 15, 14, 0xd8a1e681) \
+    STEP(G, b, c, d, a,  4, 20, 0xe7d3fbc8) \
+    STEP(G, a, b, c, d,  9,  5, 0x21e1cde6) \
+    STEP(G, d, a, b, c, 14,  9, 0xc33707d6) \
+    STEP(G, c, d, a, b,  3, 14, 0xf4d50d87) \
+    STEP(G, b, c, d, a,  8, 20, 0x455a14ed) \
+    STEP(G, a, b, c, d, 13,  5, 0xa9e3e905) \
+    STEP(G, d, a, b, c,  2,  9, 0xfcefa3f8) \
+    STEP(G, c, d, a, b,  7, 14, 0x676f02d9) \
+    STEP(G, b, c, d, a, 12, 20, 0x8d2a4c8a) \
+    STEP(H, a, b, c, d,  5,  4, 0xfffa3942) \
+    STEP(H, d, a, b, c,  8, 11, 0x8771f681) \
+    STEP(H, c, d, a, b, 11, 16, 0x6d9d6122) \
+    STEP(H, b, c, d, a, 14, 23, 0xfde5380c) \
+    STEP(H, a, b, c, d,  1,  4, 0xa4beea44) \
+    STEP(H, d, a, b, c,  4, 11, 0x4bdecfa9) \
+    STEP(H, c, d, a, b,  7, 16, 0xf6bb4b60) \
+    STEP(H, b, c, d, a, 10, 23, 0xbebfbc70) \
+    STEP(H, a, b, c, d, 13,  4, 0x289b7ec6) \
+    STEP(H, d, a, b, c,  0, 11, 0xeaa127fa) \
+    STEP(H, c, d, a, b,  3, 16, 0xd4ef3085) \
+    STEP(H, b, c, d, a,  6, 23, 0x04881d05) \
+    STEP(H, a, b, c, d,  9,  4, 0xd9d4d039) \
+    STEP(H, d, a, b, c, 12, 11, 0xe6db99e5) \
+    STEP(H, c, d, a, b, 15, 16, 0x1fa27cf8) \
+    STEP(H, b, c, d, a,  2, 23, 0xc4ac5665) \
+    STEP(I, a, b, c, d,  0,  6, 0xf4292244) \
+    STEP(I, d, a, b, c,  7, 10, 0x432aff97) \
+    STEP(I, c, d, a, b, 14, 15, 0xab9423a7) \
+    STEP(I, b, c, d, a,  5, 21, 0xfc93a039) \
+    STEP(I, a, b, c, d, 12,  6, 0x655b59c3) \
+    STEP(I, d, a, b, c,  3, 10, 0x8f0ccc92) \
+    STEP(I, c, d, a, b, 10, 15, 0xffeff47d) \
+    STEP(I, b, c, d, a,  1, 21, 0x85845dd1) \
+    STEP(I, a, b, c, d,  8,  6, 0x6fa87e4f) \
+    STEP(I, d, a, b, c, 15, 10, 0xfe2ce6e0) \
+    STEP(I, c, d, a, b,  6, 15, 0xa3014314) \
+    STEP(I, b, c, d, a, 13, 21, 0x4e0811a1) \
+    STEP(I, a, b, c, d,  4,  6, 0xf7537e82) \
+    STEP(I, d, a, b, c, 11, 10, 0xbd3af235) \
+    STEP(I, c, d, a, b,  2, 15, 0x2ad7d2bb) \
+    STEP(I, b, c, d, a,  9, 21, 0xeb86d391)
+
+const uint32_t INITIAL_STATE[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+
+/**
+ * Portable single lane kernel, works on any endianness.
+ */
+void transformPortable(uint32_t* state, const uint8_t* const* blocks)
+{
+    const uint8_t* block = blocks[0];
+
+    uint32_t X[16];
+    for (int i = 0; i < 16; i++)
+    {
+        X[i] = block[i * 4]
+            | (block[i * 4 + 1] << 8)
+            | (block[i * 4 + 2] << 16)
+            | (static_cast<uint32_t>(block[i * 4 + 3]) << 24);
+    }
+
+    uint32_t a = state[0];
+    uint32_t b = state[1];
+    uint32_t c = state[2];
+    uint32_t d = state[3];
+
+#define F(x, y, z) (((x) & (y)) | (~(x) & (z)))
+#define G(x, y, z) (((x) & (z)) | ((y) & ~(z)))
+#define H(x, y, z) ((x) ^ (y) ^ (z))
+#define I(x, y, z) ((y) ^ ((x) | ~(z)))
+#define STEP(f, a, b, c, d, k, s, t) \
+    a += f(b, c, d) + X[k] + t; \
+    a = b + ((a << s) | (a >> (32 - s)));
+
+    MD5_STEPS(STEP)
+
+#undef STEP
+#undef I
+#undef H
+#undef G
+#undef F
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+}
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+
+// x86 is little endian so message words are loaded as they are
+
+static inline uint32_t load32(const uint8_t* p)
+{
+    uint32_t w;
+    memcpy(&w, p, sizeof(w));
+    return w;
+}
+
+__attribute__((target("sse2")))
+void transformSSE2(uint32_t* state, const uint8_t* const* blocks)
+{
+    __m128i X[16];
+    for (int i = 0; i < 16; i++)
+    {
+        X[i] = _mm_set_epi32(
+            load32(blocks[3] + i * 4), load32(blocks[2] + i * 4),
+            load32(blocks[1] + i * 4), load32(blocks[0] + i * 4));
+    }
+
+    __m128i* s = reinterpret_cast<__m128i*>(state);
+    __m128i a = _mm_loadu_si128(s);
+    __m128i b = _mm_loadu_si128(s + 1);
+    __m128i c = _mm_loadu_si128(s + 2);
+    __m128i d = _mm_loadu_si128(s + 3);
+
+    const __m128i ones = _mm_set1_epi32(-1);
+
+#define F(x, y, z) _mm_or_si128(_mm_and_si128(x, y), _mm_andnot_si128(x, z))
+#define G(x, y, z) _mm_or_si128(_mm_and_si128(x, z), _mm_andnot_si128(z, y))
+#define H(x, y, z) _mm_xor_si128(_mm_xor_si128(x, y), z)
+#define I(x, y, z) _mm_xor_si128(y, _mm_or_si128(x, _mm_xor_si128(z, ones)))
+#define STEP(f, a, b, c, d, k, s, t) \
+    a = _mm_add_epi32(_mm_add_epi32(a, f(b, c, d)), \
+        _mm_add_epi32(X[k], _mm_set1_epi32(static_cast<int>(t)))); \
+    a = _mm_add_epi32(b, _mm_or_si128(_mm_slli_epi32(a, s), _mm_srli_epi32(a, 32 - s)));
+
+    MD5_STEPS(STEP)
+
+#undef STEP
+#undef I
+#undef H
+#undef G
+#undef F
+
+    _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s), a));
+    _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), b));
+    _mm_storeu_si128(s + 2, _mm_add_epi32(_mm_loadu_si128(s + 2), c));
+    _mm_storeu_si128(s + 3, _mm_add_epi32(_mm_loadu_si128(s + 3), d));
+}
+
+__attribute__((target("avx2")))
+void transformAVX2(uint32_t* state, const uint8_t* const* blocks)
+{
+    __m256i X[16];
+    for (int i = 0; i < 16; i++)
+    {
+        X[i] = _mm256_set_epi32(
+            load32(blocks[7] + i * 4), load32(blocks[6] + i * 4),
+            load32(blocks[5] + i * 4), load32(blocks[4] + i * 4),
+            load32(blocks[3] + i * 4), load32(blocks[2] + i * 4),
+            load32(blocks[1] + i * 4), load32(blocks[0] + i * 4));
+    }
+
+    __m256i* s = reinterpret_cast<__m256i*>(state);
+    __m256i a = _mm256_loadu_si256(s);
+    __m256i b = _mm256_loadu_si256(s + 1);
+    __m256i c = _mm256_loadu_si256(s + 2);
+    __m256i d = _mm256_loadu_si256(s + 3);
+
+    const __m256i ones = _mm256_set1_epi32(-1);
+
+#define F(x, y, z) _mm256_or_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z))
+#define G(x, y, z) _mm256_or_si256(_mm256_and_si256(x, z), _mm256_andnot_si256(z, y))
+#define H(x, y, z) _mm256_xor_si256(_mm256_xor_si256(x, y), z)
+#define I(x, y, z) _mm256_xor_si256(y, _mm256_or_si256(x, _mm256_xor_si256(z, ones)))
+#define STEP(f, a, b, c, d, k, s, t) \
+    a = _mm256_add_epi32(_mm256_add_epi32(a, f(b, c, d)), \
+        _mm256_add_epi32(X[k], _mm256_set1_epi32(static_cast<int>(t)))); \
+    a = _mm256_add_epi32(b, _mm256_or_si256(_mm256_slli_epi32(a, s), _mm256_srli_epi32(a, 32 - s)));
+
+    MD5_STEPS(STEP)
+
+#undef STEP
+#undef I
+#undef H
+#undef G
+#undef F
+
+    _mm256_storeu_si256(s, _mm256_add_epi32(_mm256_loadu_si256(s), a));
+    _mm256_storeu_si256(s + 1, _mm256_add_epi32(_mm256_loadu_si256(s + 1), b));
+    _mm256_storeu_si256(s + 2, _mm256_add_epi32(_mm256_loadu_si256(s + 2), c));
+    _mm256_storeu_si256(s + 3, _mm256_add_epi32(_mm256_loadu_si256(s + 3), d));
+}
+#endif
+
+/**
+ * Build the list of the kernels supported by the CPU.
+ */
+std::vector<md5_kernel_t> detectKernels()
+{
+    std::vector<md5_kernel_t> kernels;
+
+#ifdef HAVE_X86_SIMD_DISPATCH
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        const md5_kernel_t avx2 = { "AVX2", 8, transformAVX2 };
+        kernels.push_back(avx2);
+    }
+
+    if (__builtin_cpu_supports("sse2"))
+    {
+        const md5_kernel_t sse2 = { "SSE2", 4, transformSSE2 };
+        kernels.push_back(sse2);
+    }
+#endif
+
+    const md5_kernel_t portable = { "C++", 1, transformPortable };
+    kernels.push_back(portable);
+
+    return kernels;
+}
+
+const std::vector<md5_kernel_t> &kernels()
+{
+    static const std::vector<md5_kernel_t> kernels = detectKernels();
+    return kernels;
+}
+
+/**
+ * A message being hashed in a lane.
+ */
+struct lane_t
+{
+    size_t message;
+
+    /// Next full block of the message
+    const uint8_t* data;
+    size_t fullBlocks;
+
+    /// The padded end of the message
+    uint8_t tail[128];
+    unsigned int tailBlocks;
+    unsigned int tailPos;
+};
+
+static void startLane(lane_t &lane, size_t message, const uint8_t* data, size_t size)
+{
+    lane.message = message;
+    lane.data = data;
+    lane.fullBlocks = size / 64;
+    lane.tailPos = 0;
+
+    const size_t rem = size % 64;
+    lane.tailBlocks = (rem + 9 <= 64) ? 1 : 2;
+
+    const size_t tailSize = lane.tailBlocks * 64;
+    memset(lane.tail, 0, tailSize);
+    memcpy(lane.tail, data + lane.fullBlocks * 64, rem);
+    lane.tail[rem] = 0x80;
+
+    // Message length in bits, little endian
+    const uint64_t bits = static_cast<uint64_t>(size) << 3;
+    for (int i = 0; i < 8; i++)
+    {
+        lane.tail[tailSize - 8 + i] = static_cast<uint8_t>(bits >> (i * 8));
+    }
+}
+
+void digest(size_t count, const uint8_t* const* data, const size_t* sizes,
+            uint8_t (*digests)[DIGEST_SIZE], const md5_kernel_t* kernel)
+{
+    if (kernel == nullptr)
+        kernel = &kernels().front();
+
+    const unsigned int lanes = kernel->lanes;
+
+    // Longest messages first so that the short ones fill the gaps at the end
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+        [sizes](size_t x, size_t y) { return sizes[x] > sizes[y]; });
+
+    lane_t lane[MAX_LANES];
+    bool active[MAX_LANES] = { false };
+    uint32_t state[4 * MAX_LANES];
+    const uint8_t* blocks[MAX_LANES];
+
+    // Idle lanes hash a dummy block
+    const uint8_t idle[64] = { 0 };
+
+    size_t next = 0;
+    unsigned int running = 0;
+
+    for (;;)
+    {
+        // Refill the idle lanes
+        for (unsigned int l = 0; l < lanes && next < count; l++)
+        {
+            if (!active[l])
+            {
+                const size_t m = order[next++];
+                startLane(lane[l], m, data[m], sizes[m]);
+                for (int w = 0; w < 4; w++)
+                    state[w * lanes + l] = INITIAL_STATE[w];
+                active[l] = true;
+                running++;
+            }
+        }
+
+        if (running == 0)
+            break;
+
+        for (unsigned int l = 0; l < lanes; l++)
+        {
+            if (!active[l])
+                blocks[l] = idle;
+            else if (lane[l].fullBlocks != 0)
+                blocks[l] = lane[l].data;
+            else
+                blocks[l] = lane[l].tail + lane[l].tailPos * 64;
+        }
+
+        kernel->transform(state, blocks);
+
+        for (unsigned int l = 0; l < lanes; l++)
+        {
+            if (!active[l])
+                continue;
+
+            lane_t &ln = lane[l];
+            if (ln.fullBlocks != 0)
+            {
+                ln.data += 64;
+                ln.fullBlocks--;
+            }
+            else if (++ln.tailPos == ln.tailBlocks)
+            {
+                // Done, store the digest little endian
+                uint8_t* out = digests[ln.message];
+                for (int w = 0; w < 4; w++)
+                {
+                    const uint32_t v = state[w * lanes + l];
+                    out[w * 4]     = static_cast<uint8_t>(v);
+                    out[w * 4 + 1] = static_cast<uint8_t>(v >> 8);
+                    out[w * 4 + 2] = static_cast<uint8_t>(v >> 16);
+                    out[w * 4 + 3] = static_cast<uint8_t>(v >> 24);
+                }
+                active[l] = false;
+                running--;
+            }
+        }
+    }
+}
+
+}
+
+}
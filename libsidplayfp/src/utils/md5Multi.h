@@ -0,0 +1,86 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef MD5_MULTI_H
+#define MD5_MULTI_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace libsidplayfp
+{
+
+/**
+ * Multi-buffer MD5.
+ *
+ * Hashes several independent messages at once, one per SIMD lane.
+ * Each lane is refilled with the next message as soon as it's done
+ * so messages of different lengths keep all lanes busy.
+ */
+namespace md5Multi
+{
+    enum
+    {
+        DIGEST_SIZE = 16,
+        MAX_LANES = 8
+    };
+
+    /**
+     * Process one 64 byte block for each lane.
+     *
+     * @param state the MD5 state, word major: state[word * lanes + lane]
+     * @param blocks one block pointer per lane
+     */
+    typedef void (*transform_t)(uint32_t* state, const uint8_t* const* blocks);
+
+    /**
+     * A transform implementation.
+     * All the kernels produce the same digests.
+     */
+    typedef struct
+    {
+        const char* name;
+        unsigned int lanes;
+        transform_t transform;
+    } md5_kernel_t;
+
+    /**
+     * Get the kernels usable on the running CPU, fastest first.
+     * The last one is always the portable single lane kernel.
+     */
+    const std::vector<md5_kernel_t> &kernels();
+
+    /**
+     * Calculate the digests of several messages.
+     *
+     * @param count number of messages
+     * @param data the messages
+     * @param sizes the message lengths in bytes
+     * @param digests receives DIGEST_SIZE bytes per message
+     * @param kernel the kernel to use, the fastest if null
+     */
+    void digest(size_t count, const uint8_t* const* data, const size_t* sizes,
+                uint8_t (*digests)[DIGEST_SIZE], const md5_kernel_t* kernel = nullptr);
+}
+
+}
+
+#endif // MD5_MULTI_H
@@ -0,0 +1,168 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "EventScheduler.h"
+
+#include "eventtrace.h"
+
+using namespace libsidplayfp;
+
+/*
+ * Replay a trace recorded with eventtrace through the event scheduler
+ * and measure the time spent in the queue operations.
+ * Built twice, with the linked list and with the heap queue.
+ * Every fired event is checked against the recorded order.
+ *
+ * Usage: eventbench <trace file> [passes]
+ */
+
+#ifdef EVENTSCHEDULER_HEAP
+#  define BACKEND "heap"
+#else
+#  define BACKEND "list"
+#endif
+
+class BenchEvent final : public Event
+{
+private:
+    const unsigned int m_id;
+    unsigned int &m_fired;
+
+private:
+    void event() override { m_fired = m_id; }
+
+public:
+    BenchEvent(unsigned int id, unsigned int &fired) :
+        Event("Bench event"),
+        m_id(id),
+        m_fired(fired) {}
+};
+
+/**
+ * Run the trace once.
+ *
+ * @return the index of the first record that fired the wrong event,
+ *         or the size of the trace
+ */
+size_t replay(EventScheduler &scheduler, std::vector<BenchEvent*> &events,
+                const std::vector<traceRecord_t> &trace, const unsigned int &fired)
+{
+    for (size_t i = 0; i < trace.size(); i++)
+    {
+        const traceRecord_t &record = trace[i];
+        Event &event = *events[record.id];
+
+        switch (record.op)
+        {
+        case TRACE_SCHEDULE_PHI1:
+            scheduler.schedule(event, record.cycles, EVENT_CLOCK_PHI1);
+            break;
+        case TRACE_SCHEDULE_PHI2:
+            scheduler.schedule(event, record.cycles, EVENT_CLOCK_PHI2);
+            break;
+        case TRACE_SCHEDULE:
+            scheduler.schedule(event, record.cycles);
+            break;
+        case TRACE_CANCEL:
+            scheduler.cancel(event);
+            break;
+        case TRACE_CLOCK:
+            scheduler.clock();
+            if (fired != record.id)
+                return i;
+            break;
+        case TRACE_RESET:
+            scheduler.reset();
+            break;
+        }
+    }
+
+    return trace.size();
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <trace file> [passes]" << std::endl;
+        return -1;
+    }
+
+    const unsigned int passes = argc > 2 ? atoi(argv[2]) : 10;
+
+    std::ifstream in(argv[1], std::ios::binary);
+    char magic[sizeof(TRACE_MAGIC) - 1];
+    in.read(magic, sizeof(magic));
+    if (!in.good() || memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0)
+    {
+        std::cerr << "Invalid trace file " << argv[1] << std::endl;
+        return -1;
+    }
+
+    std::vector<traceRecord_t> trace;
+    traceRecord_t record;
+    while (in.read(reinterpret_cast<char*>(&record), sizeof(record)))
+    {
+        trace.push_back(record);
+    }
+
+    unsigned int fired = 0;
+    std::vector<BenchEvent*> events;
+    for (unsigned int id = 0; id < 256; id++)
+    {
+        events.push_back(new BenchEvent(id, fired));
+    }
+
+    EventScheduler scheduler;
+
+    const clock_t start = clock();
+
+    for (unsigned int pass = 0; pass < passes; pass++)
+    {
+        const size_t replayed = replay(scheduler, events, trace, fired);
+        if (replayed != trace.size())
+        {
+            std::cerr << BACKEND << ": event order mismatch at operation " << replayed << std::endl;
+            return -1;
+        }
+        scheduler.reset();
+    }
+
+    const clock_t end = clock();
+
+    const double ms = (end - start) * 1000. / CLOCKS_PER_SEC;
+    const double operations = static_cast<double>(trace.size()) * passes;
+
+    std::cout << BACKEND << ": " << operations << " operations in " << ms << " ms, "
+        << ms * 1e6 / operations << " ns/operation" << std::endl;
+
+    for (std::vector<BenchEvent*>::iterator it = events.begin(); it != events.end(); ++it)
+    {
+        delete *it;
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "sidplayfp/sidplayfp.h"
+#include "sidplayfp/SidTune.h"
+
+#include "EventScheduler.h"
+
+#include "eventtrace.h"
+
+/*
+ * Record the event scheduler activity while playing a tune
+ * so it can be replayed by eventbench.
+ * This program is built with its own copy of the emulation
+ * compiled with EVENTSCHEDULER_TRACE defined.
+ * No SID emulation is attached as it does not schedule events.
+ *
+ * Usage: eventtrace <tune> <song> <seconds> <trace file>
+ */
+
+static std::vector<traceRecord_t> trace;
+static std::map<const libsidplayfp::Event*, unsigned int> eventIds;
+
+namespace libsidplayfp
+{
+
+void eventTrace(event_trace_t op, const Event *event, unsigned int cycles)
+{
+    traceRecord_t record;
+    record.op = op;
+    record.id = 0;
+    record.unused = 0;
+    record.cycles = cycles;
+
+    if (event != nullptr)
+    {
+        std::map<const Event*, unsigned int>::const_iterator it = eventIds.find(event);
+        if (it == eventIds.end())
+        {
+            it = eventIds.insert(std::make_pair(event, eventIds.size())).first;
+        }
+        record.id = it->second;
+    }
+
+    trace.push_back(record);
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 5)
+    {
+        std::cerr << "Usage: " << argv[0] << " <tune> <song> <seconds> <trace file>" << std::endl;
+        return -1;
+    }
+
+    const unsigned int seconds = atoi(argv[3]);
+
+    sidplayfp m_engine;
+
+    std::unique_ptr<SidTune> tune(new SidTune(argv[1]));
+
+    if (!tune->getStatus())
+    {
+        std::cerr << "Error: " << tune->statusString() << std::endl;
+        return -1;
+    }
+
+    tune->selectSong(atoi(argv[2]));
+
+    if (!m_engine.load(tune.get()))
+    {
+        std::cerr << m_engine.error() << std::endl;
+        return -1;
+    }
+
+    while (m_engine.time() < seconds)
+    {
+        m_engine.play(0, 0);
+    }
+
+    if (eventIds.size() > 256)
+    {
+        std::cerr << "Too many events: " << eventIds.size() << std::endl;
+        return -1;
+    }
+
+    std::ofstream out(argv[4], std::ios::binary);
+    out.write(TRACE_MAGIC, strlen(TRACE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&trace.front()), trace.size() * sizeof(traceRecord_t));
+    if (!out.good())
+    {
+        std::cerr << "Error writing " << argv[4] << std::endl;
+        return -1;
+    }
+
+    std::cout << trace.size() << " operations on " << eventIds.size() << " events recorded" << std::endl;
+}
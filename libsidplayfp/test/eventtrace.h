@@ -0,0 +1,43 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+#include <stdint.h>
+
+/**
+ * Event scheduler trace file layout, shared by eventtrace and eventbench.
+ *
+ * The file starts with the 8 byte TRACE_MAGIC string followed
+ * by fixed size records in host byte order.
+ */
+
+#define TRACE_MAGIC "SIDEVTR1"
+
+typedef struct
+{
+    uint8_t op;      ///< libsidplayfp::event_trace_t value
+    uint8_t id;      ///< event number, in order of first appearance
+    uint16_t unused;
+    uint32_t cycles; ///< requested delay for schedule operations
+} traceRecord_t;
+
+#endif // EVENTTRACE_H
@@ -0,0 +1,86 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ * Copyright 2026 agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#include <ctime>
+#include <iostream>
+
+#include "sidplayfp/sidplayfp.h"
+#include "sidplayfp/SidConfig.h"
+#include "sidplayfp/SidTune.h"
+#include "builders/residfp-builder/residfp.h"
+
+/*
+ * Measure the time to the first rendered samples of a tune
+ * with the reSIDfp emulation, which is dominated by the
+ * computation of the filter and resampler tables.
+ * Run once without a cache directory to get the cold start time,
+ * then twice with one: the first run fills the cache, the second
+ * loads the tables from it.
+ *
+ * Usage: startupbench <sid file> [cache dir]
+ */
+
+int main(int argc, const char* argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <sid file> [cache dir]" << std::endl;
+        return -1;
+    }
+
+    const clock_t start = clock();
+
+    if (argc > 2)
+        ReSIDfpBuilder::tableCache(argv[2]);
+
+    ReSIDfpBuilder rs("startupbench");
+    rs.create(1);
+
+    SidTune tune(argv[1]);
+    if (!tune.getStatus())
+    {
+        std::cerr << tune.statusString() << std::endl;
+        return -1;
+    }
+    tune.selectSong(0);
+
+    sidplayfp engine;
+
+    SidConfig cfg;
+    cfg.frequency = 44100;
+    cfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
+    cfg.sidEmulation = &rs;
+
+    if (!engine.config(cfg) || !engine.load(&tune))
+    {
+        std::cerr << engine.error() << std::endl;
+        return -1;
+    }
+
+    short buffer[2048];
+    engine.play(buffer, 2048);
+
+    const clock_t end = clock();
+
+    std::cout << "Time to first samples " << (end - start) * 1000. / CLOCKS_PER_SEC << " ms"
+        << (argc > 2 ? " (with table cache)" : "") << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/SidAnalyzer.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/sidplayfp/SidConfig.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#define HEADERSIZE 124
+
+/// PAL cycles per frame and per second
+#define FRAME_CYCLES 19656.
+#define PAL_CLOCK 985248.
+
+using namespace UnitTest;
+
+uint8_t const headerPSID[HEADERSIZE] = {
+    0x50, 0x53, 0x49, 0x44, // magicID
+    0x00, 0x02,             // version
+    0x00, 0x7C,             // dataOffset
+    0x10, 0x00,             // loadAddress
+    0x10, 0x00,             // initAddress
+    0x10, 0x1B,             // playAddress
+    0x00, 0x01,             // songs
+    0x00, 0x01,             // startSong
+    0x00, 0x00, 0x00, 0x00, // speed
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // name
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // released
+    0x00, 0x00,             // flags
+    0x00,                   // startPage
+    0x00,                   // pageLength
+    0x00,                   // secondSIDAddress
+    0x00,                   // thirdSIDAddress
+};
+
+// init: volume, sawtooth with gate, sustain, frequency, clear the counter.
+// It ends right before the play routine so the RTS reads
+// the first byte of it without running it
+uint8_t const initCode[] = {
+    0xA9, 0x0F, 0x8D, 0x18, 0xD4,
+    0xA9, 0x21, 0x8D, 0x04, 0xD4,
+    0xA9, 0xF0, 0x8D, 0x06, 0xD4,
+    0xA9, 0x10, 0x8D, 0x01, 0xD4,
+    0xA9, 0x00, 0x85, 0xFB, 0x85, 0xFC,
+    0x60
+};
+
+// play: step the frequency through 16 values
+uint8_t const loopCode[] = {
+    0xE6, 0xFB,             // INC $FB
+    0xA5, 0xFB,             // LDA $FB
+    0x29, 0x0F,             // AND #$0F
+    0x85, 0xFB,             // STA $FB
+    0x8D, 0x01, 0xD4,       // STA $D401
+    0x60                    // RTS
+};
+
+// play: count the frames and release the note on the 50th
+uint8_t const silenceCode[] = {
+    0xE6, 0xFB,             // INC $FB
+    0xD0, 0x02,             // BNE +2
+    0xE6, 0xFC,             // INC $FC
+    0xA5, 0xFB,             // LDA $FB
+    0xC9, 0x32,             // CMP #50
+    0xD0, 0x05,             // BNE +5
+    0xA9, 0x20,             // LDA #$20
+    0x8D, 0x04, 0xD4,       // STA $D404
+    0x60                    // RTS
+};
+
+SUITE(Analyzer)
+{
+
+struct TestFixture
+{
+    template<int N>
+    bool analyze(const uint8_t (&playCode)[N])
+    {
+        std::vector<uint8_t> buffer(headerPSID, headerPSID + HEADERSIZE);
+        buffer.insert(buffer.end(), initCode, initCode + sizeof(initCode));
+        buffer.insert(buffer.end(), playCode, playCode + N);
+
+        SidTune tune(&buffer[0], buffer.size());
+        tune.selectSong(0);
+
+        SidConfig cfg;
+        cfg.defaultC64Model = SidConfig::PAL;
+        cfg.forceC64Model = true;
+        cfg.powerOnDelay = 0;
+
+        return analyzer.config(cfg) && analyzer.analyze(&tune, 10, 2);
+    }
+
+    SidAnalyzer analyzer;
+};
+
+TEST_FIXTURE(TestFixture, TestExactLoop)
+{
+    CHECK(analyze(loopCode));
+
+    CHECK_EQUAL(SidAnalyzer::LOOP, analyzer.result());
+    CHECK_CLOSE(16 * FRAME_CYCLES / PAL_CLOCK, analyzer.loopLength(), 0.001);
+    CHECK(analyzer.loopStart() < 0.5);
+    CHECK_EQUAL(1., analyzer.confidence());
+}
+
+TEST_FIXTURE(TestFixture, TestSilence)
+{
+    CHECK(analyze(silenceCode));
+
+    CHECK_EQUAL(SidAnalyzer::SILENCE, analyzer.result());
+    CHECK_CLOSE(50 * FRAME_CYCLES / PAL_CLOCK, analyzer.loopStart(), 0.1);
+    CHECK_EQUAL(0., analyzer.loopLength());
+    CHECK_EQUAL(0.5, analyzer.confidence());
+}
+
+}
@@ -0,0 +1,133 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include <vector>
+
+#include "../src/builders/residfp-builder/residfp/resample/convolve.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+const int MAX_LENGTH = 256;
+
+/**
+ * Deterministic pseudo random generator.
+ */
+class Random
+{
+private:
+    unsigned int state;
+
+public:
+    Random() : state(12345) {}
+
+    int next(int range)
+    {
+        state = state * 1103515245 + 12345;
+        return static_cast<int>((state >> 8) % (2 * range + 1)) - range;
+    }
+};
+
+SUITE(Convolve)
+{
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        samples(MAX_LENGTH + 16),
+        sinc(MAX_LENGTH + 16)
+    {
+        Random random;
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            samples[i] = static_cast<short>(random.next(32767));
+            sinc[i] = static_cast<short>(random.next(256));
+        }
+    }
+
+    std::vector<short> samples;
+    std::vector<short> sinc;
+};
+
+TEST(TestPortableKernelIsLast)
+{
+    const std::vector<convolve_kernel_t> &kernels = convolveKernels();
+
+    CHECK(!kernels.empty());
+    CHECK_EQUAL("C++", kernels.back().name);
+}
+
+TEST_FIXTURE(TestFixture, TestBitExact)
+{
+    const std::vector<convolve_kernel_t> &kernels = convolveKernels();
+    const convolve_t reference = kernels.back().convolve;
+    const convolve_t referenceDotProduct = kernels.back().dotProduct;
+
+    for (size_t k = 0; k < kernels.size(); k++)
+    {
+        // Try all the lengths and misalignments
+        for (int length = 0; length <= MAX_LENGTH; length++)
+        {
+            for (int offset = 0; offset < 8; offset++)
+            {
+                const short* a = &samples[offset];
+                const short* b = &sinc[(offset * 3) & 7];
+
+                CHECK_EQUAL(reference(a, b, length), kernels[k].convolve(a, b, length));
+                CHECK_EQUAL(referenceDotProduct(a, b, length), kernels[k].dotProduct(a, b, length));
+            }
+        }
+    }
+}
+
+TEST(TestRounding)
+{
+    const short a[3] = { 16384, 1, -16384 };
+    const short b[3] = { 1, 16384, 1 };
+
+    const std::vector<convolve_kernel_t> &kernels = convolveKernels();
+
+    for (size_t k = 0; k < kernels.size(); k++)
+    {
+        // 16384 / 32768 rounds up
+        CHECK_EQUAL(1, kernels[k].convolve(a + 1, b + 1, 1));
+        // -16384 / 32768 rounds up to 0
+        CHECK_EQUAL(0, kernels[k].convolve(a + 2, b + 2, 1));
+    }
+}
+
+TEST(TestDotProductUnscaled)
+{
+    const short a[3] = { 16384, 1, -16384 };
+    const short b[3] = { 1, 16384, 1 };
+
+    const std::vector<convolve_kernel_t> &kernels = convolveKernels();
+
+    for (size_t k = 0; k < kernels.size(); k++)
+    {
+        CHECK_EQUAL(16384, kernels[k].dotProduct(a, b, 3));
+    }
+}
+
+}
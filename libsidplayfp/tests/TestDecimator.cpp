@@ -0,0 +1,102 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/builders/residfp-builder/residfp/Decimator.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+SUITE(Decimator)
+{
+
+int decimate(Decimator &decimator, const int input[], int factor)
+{
+    for (int i = 0; i < factor; i++)
+    {
+        decimator.input(input[i]);
+    }
+
+    return decimator.output();
+}
+
+TEST(TestDC)
+{
+    const int input[8] = { 522240, 522240, 522240, 522240, 522240, 522240, 522240, 522240 };
+
+    Decimator decimator;
+    decimator.setShift(3);
+
+    // First output still sees the initial zeros
+    CHECK(decimate(decimator, input, 8) < 522240);
+
+    for (int i = 0; i < 16; i++)
+    {
+        CHECK_EQUAL(522240, decimate(decimator, input, 8));
+    }
+}
+
+TEST(TestNegativeDC)
+{
+    const int input[4] = { -522240, -522240, -522240, -522240 };
+
+    Decimator decimator;
+    decimator.setShift(2);
+
+    decimate(decimator, input, 4);
+
+    // Wrap-around of the integrators doesn't matter
+    for (int i = 0; i < 10000; i++)
+    {
+        CHECK_EQUAL(-522240, decimate(decimator, input, 4));
+    }
+}
+
+TEST(TestRejectReducedRate)
+{
+    // A tone at the reduced rate is cancelled
+    const int input[4] = { 100000, 0, -100000, 0 };
+
+    Decimator decimator;
+    decimator.setShift(2);
+
+    decimate(decimator, input, 4);
+
+    for (int i = 0; i < 16; i++)
+    {
+        CHECK_EQUAL(0, decimate(decimator, input, 4));
+    }
+}
+
+TEST(TestPassThrough)
+{
+    const int input[3] = { 1, -2, 3 };
+
+    Decimator decimator;
+
+    for (int i = 0; i < 3; i++)
+    {
+        CHECK_EQUAL(input[i], decimate(decimator, input + i, 1));
+    }
+}
+
+}
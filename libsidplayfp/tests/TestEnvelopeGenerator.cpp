@@ -21,6 +21,8 @@
 #include "UnitTest++/UnitTest++.h"
 #include "UnitTest++/TestReporter.h"
 
+#include <cstdlib>
+
 #define private public
 #define protected public
 #define class struct
@@ -120,4 +122,65 @@ TEST_FIXTURE(TestFixture, TestFlip00toFF)
     CHECK(!generator.hold_zero);
 }
 
+TEST(TestBatchedClock)
+{
+    // Clocking many cycles at once must give exactly the same
+    // results as clocking each cycle, whatever the ADSR settings.
+
+    reSIDfp::EnvelopeGenerator single;
+    reSIDfp::EnvelopeGenerator batched;
+    single.reset();
+    batched.reset();
+
+    srand(1);
+
+    for (int i=0; i<20000; i++)
+    {
+        switch (rand() % 4)
+        {
+        case 0:
+        {
+            const unsigned char control = rand() & 0xff;
+            single.writeCONTROL_REG(control);
+            batched.writeCONTROL_REG(control);
+            break;
+        }
+        case 1:
+        {
+            const unsigned char attack_decay = rand() & 0xff;
+            single.writeATTACK_DECAY(attack_decay);
+            batched.writeATTACK_DECAY(attack_decay);
+            break;
+        }
+        case 2:
+        {
+            const unsigned char sustain_release = rand() & 0xff;
+            single.writeSUSTAIN_RELEASE(sustain_release);
+            batched.writeSUSTAIN_RELEASE(sustain_release);
+            break;
+        }
+        }
+
+        // Mostly short spans, with some longer than the LFSR period
+        const unsigned int cycles = (rand() % 8 == 0) ? rand() % 100000 : rand() % 64;
+
+        for (unsigned int j=0; j<cycles; j++)
+        {
+            single.clock();
+        }
+        batched.clock(cycles);
+
+        CHECK_EQUAL((int)single.readENV(), (int)batched.readENV());
+        CHECK_EQUAL(single.lfsr, batched.lfsr);
+        CHECK_EQUAL(single.exponential_counter, batched.exponential_counter);
+        CHECK_EQUAL(single.exponential_counter_period, batched.exponential_counter_period);
+        CHECK_EQUAL(single.envelope_pipeline, batched.envelope_pipeline);
+        CHECK_EQUAL(single.hold_zero, batched.hold_zero);
+        CHECK_EQUAL(single.state, batched.state);
+
+        if (single.lfsr != batched.lfsr || single.readENV() != batched.readENV())
+            break;
+    }
+}
+
 }
@@ -0,0 +1,62 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/builders/residfp-builder/residfp/FilterModelConfig.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+SUITE(FilterModelConfig)
+{
+
+TEST(TestDacShared)
+{
+    const unsigned short* dac1 = FilterModelConfig::getInstance()->getDAC(0.5);
+    const unsigned short* dac2 = FilterModelConfig::getInstance()->getDAC(0.5);
+
+    CHECK(dac1 == dac2);
+}
+
+TEST(TestDacQuantized)
+{
+    const unsigned short* dac1 = FilterModelConfig::getInstance()->getDAC(0.25);
+    const unsigned short* dac2 = FilterModelConfig::getInstance()->getDAC(0.25 + 1e-6);
+
+    CHECK(dac1 == dac2);
+}
+
+TEST(TestDacCurve)
+{
+    const unsigned short* dac1 = FilterModelConfig::getInstance()->getDAC(0.);
+    const unsigned short* dac2 = FilterModelConfig::getInstance()->getDAC(1.);
+
+    CHECK(dac1 != dac2);
+
+    // Higher curve position means lower DAC output
+    for (int i = 0; i < (1 << 11); i++)
+    {
+        CHECK(dac1[i] > dac2[i]);
+    }
+}
+
+}
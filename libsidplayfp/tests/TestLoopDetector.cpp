@@ -0,0 +1,153 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/LoopDetector.h"
+
+using namespace UnitTest;
+using namespace libsidplayfp;
+
+SUITE(LoopDetector)
+{
+
+TEST(TestExactLoop)
+{
+    LoopDetector detector(4, 20, 100);
+
+    // 10 frames of intro then a 7 frame loop
+    unsigned int frame = 0;
+    bool done = false;
+    for (; !done && frame < 100; frame++)
+    {
+        const unsigned int pos = frame < 10 ? frame : 10 + (frame - 10) % 7;
+        done = detector.frame(pos, pos, false);
+
+        if (!done && detector.candidate())
+        {
+            CHECK_EQUAL(17u, detector.candidateFrame());
+            if (frame == detector.candidateFrame() + detector.candidateLength())
+                done = detector.confirm(true);
+        }
+    }
+
+    CHECK(done);
+    CHECK_EQUAL(25u, frame);
+    CHECK_EQUAL(LoopDetector::EXACT, detector.result());
+    // The state after frame 10 repeats, the loop starts with the next one
+    CHECK_EQUAL(11u, detector.loopStart());
+    CHECK_EQUAL(7u, detector.loopLength());
+    CHECK_EQUAL(1., detector.confidence());
+}
+
+TEST(TestExactLoopRejected)
+{
+    LoopDetector detector(4, 20, 100);
+
+    // The state hash of frame 3 collides with the one of frame 0
+    for (unsigned int frame = 0; frame < 100; frame++)
+    {
+        const uint_least64_t state = frame == 3 ? 0 : frame;
+        CHECK(!detector.frame(state, frame, false));
+
+        if (detector.candidate() && frame == detector.candidateFrame() + detector.candidateLength())
+            CHECK(!detector.confirm(false));
+    }
+
+    CHECK(!detector.candidate());
+    CHECK_EQUAL(LoopDetector::NONE, detector.result());
+}
+
+TEST(TestAudioLoop)
+{
+    LoopDetector detector(4, 20, 100);
+
+    // The state never repeats, the writes loop after 5 frames every 6 frames
+    unsigned int frame = 0;
+    bool done = false;
+    for (; !done && frame < 100; frame++)
+    {
+        const unsigned int pos = frame < 5 ? frame + 100 : (frame - 5) % 6;
+        done = detector.frame(frame, pos, false);
+    }
+
+    CHECK(done);
+    CHECK_EQUAL(LoopDetector::AUDIO, detector.result());
+    CHECK_EQUAL(5u, detector.loopStart());
+    CHECK_EQUAL(6u, detector.loopLength());
+    CHECK_CLOSE(0.9, detector.confidence(), 0.001);
+}
+
+TEST(TestAudioLoopRejected)
+{
+    LoopDetector detector(4, 20, 100);
+
+    // A short pattern repeats for a while before the real loop
+    for (unsigned int frame = 0; frame < 12; frame++)
+    {
+        CHECK(!detector.frame(frame, frame % 2, false));
+    }
+
+    unsigned int frame = 12;
+    bool done = false;
+    for (; !done && frame < 100; frame++)
+    {
+        done = detector.frame(frame, 10 + (frame - 12) % 8, false);
+    }
+
+    CHECK(done);
+    CHECK_EQUAL(LoopDetector::AUDIO, detector.result());
+    CHECK_EQUAL(12u, detector.loopStart());
+    CHECK_EQUAL(8u, detector.loopLength());
+}
+
+TEST(TestSilence)
+{
+    LoopDetector detector(4, 20, 10);
+
+    unsigned int frame = 0;
+    bool done = false;
+    for (; !done && frame < 100; frame++)
+    {
+        done = detector.frame(frame, frame, frame >= 30 || frame == 20);
+    }
+
+    CHECK(done);
+    CHECK_EQUAL(LoopDetector::SILENCE, detector.result());
+    CHECK_EQUAL(30u, detector.loopStart());
+    CHECK_EQUAL(0u, detector.loopLength());
+    CHECK_EQUAL(0.5, detector.confidence());
+}
+
+TEST(TestNothing)
+{
+    LoopDetector detector(4, 20, 10);
+
+    for (unsigned int frame = 0; frame < 100; frame++)
+    {
+        CHECK(!detector.frame(frame, frame, false));
+    }
+
+    CHECK_EQUAL(LoopDetector::NONE, detector.result());
+    CHECK_EQUAL(0., detector.confidence());
+}
+
+}
@@ -0,0 +1,142 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "../src/utils/md5Multi.h"
+
+using namespace UnitTest;
+using namespace libsidplayfp;
+
+std::string toHex(const uint8_t* digest)
+{
+    const char hex[] = "0123456789abcdef";
+
+    std::string result;
+    for (int i = 0; i < md5Multi::DIGEST_SIZE; i++)
+    {
+        result.push_back(hex[digest[i] >> 4]);
+        result.push_back(hex[digest[i] & 0x0f]);
+    }
+    return result;
+}
+
+SUITE(Md5Multi)
+{
+
+TEST(TestPortableKernelIsLast)
+{
+    const std::vector<md5Multi::md5_kernel_t> &kernels = md5Multi::kernels();
+
+    CHECK(!kernels.empty());
+    CHECK_EQUAL("C++", kernels.back().name);
+    CHECK_EQUAL(1u, kernels.back().lanes);
+}
+
+TEST(TestRfc1321)
+{
+    const char* messages[] =
+    {
+        "",
+        "a",
+        "abc",
+        "message digest",
+        "abcdefghijklmnopqrstuvwxyz",
+        "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+    };
+    const char* expected[] =
+    {
+        "d41d8cd98f00b204e9800998ecf8427e",
+        "0cc175b9c0f1b6a831c399e269772661",
+        "900150983cd24fb0d6963f7d28e17f72",
+        "f96b697d7cb7938d525a2f31aaf161d0",
+        "c3fcd3d76192e4007dfb496cca67e13b",
+        "57edf4a22be3c955ac49da2e2107b67a"
+    };
+    const size_t count = sizeof(messages) / sizeof(messages[0]);
+
+    const uint8_t* data[count];
+    size_t sizes[count];
+    for (size_t i = 0; i < count; i++)
+    {
+        data[i] = reinterpret_cast<const uint8_t*>(messages[i]);
+        sizes[i] = strlen(messages[i]);
+    }
+
+    const std::vector<md5Multi::md5_kernel_t> &kernels = md5Multi::kernels();
+
+    for (size_t k = 0; k < kernels.size(); k++)
+    {
+        uint8_t digests[count][md5Multi::DIGEST_SIZE];
+        md5Multi::digest(count, data, sizes, digests, &kernels[k]);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            CHECK_EQUAL(expected[i], toHex(digests[i]));
+        }
+    }
+}
+
+TEST(TestKernelsAgree)
+{
+    // Lengths around the padding boundaries mixed with longer ones
+    std::vector<size_t> sizes;
+    for (size_t length = 0; length <= 130; length++)
+        sizes.push_back(length);
+    sizes.push_back(1000);
+    sizes.push_back(4096);
+    sizes.push_back(65536 + 300);
+
+    std::vector<std::vector<uint8_t> > messages(sizes.size());
+    std::vector<const uint8_t*> data(sizes.size());
+    unsigned int state = 12345;
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        messages[i].resize(sizes[i] + 1);
+        for (size_t j = 0; j < messages[i].size(); j++)
+        {
+            state = state * 1103515245 + 12345;
+            messages[i][j] = static_cast<uint8_t>(state >> 16);
+        }
+        data[i] = &messages[i][0];
+    }
+
+    const std::vector<md5Multi::md5_kernel_t> &kernels = md5Multi::kernels();
+
+    std::vector<uint8_t> reference(sizes.size() * md5Multi::DIGEST_SIZE);
+    md5Multi::digest(sizes.size(), &data[0], &sizes[0],
+        reinterpret_cast<uint8_t (*)[md5Multi::DIGEST_SIZE]>(&reference[0]), &kernels.back());
+
+    for (size_t k = 0; k < kernels.size(); k++)
+    {
+        std::vector<uint8_t> digests(sizes.size() * md5Multi::DIGEST_SIZE);
+        md5Multi::digest(sizes.size(), &data[0], &sizes[0],
+            reinterpret_cast<uint8_t (*)[md5Multi::DIGEST_SIZE]>(&digests[0]), &kernels[k]);
+
+        CHECK(reference == digests);
+    }
+}
+
+}
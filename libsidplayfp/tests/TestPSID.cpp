@@ -228,6 +228,86 @@ TEST_FIXTURE(TestFixture, TestDefaultStartSong)
     CHECK_EQUAL(1, tune.getInfo()->startSong());
 }
 
+/*
+ * Attached data is referenced, not copied.
+ */
+TEST_FIXTURE(TestFixture, TestAttach)
+{
+    SidTune copied(data, BUFFERSIZE);
+
+    SidTune tune(0);
+    tune.attach(data, BUFFERSIZE);
+    CHECK(tune.getStatus());
+
+    CHECK(tune.c64Data() == data + 126);
+    CHECK_EQUAL(copied.getInfo()->loadAddr(), tune.getInfo()->loadAddr());
+    CHECK_EQUAL(copied.getInfo()->c64dataLen(), tune.getInfo()->c64dataLen());
+    CHECK_EQUAL(copied.createMD5(), tune.createMD5());
+}
+
+/*
+ * Attached data is validated like copied one.
+ */
+TEST_FIXTURE(TestFixture, TestAttachInvalid)
+{
+    data[SPEED_LO_LO] = 0xff;
+
+    SidTune tune(0);
+    tune.attach(data, BUFFERSIZE);
+    CHECK(!tune.getStatus());
+
+    CHECK_EQUAL("SIDTUNE ERROR: File contains invalid data", tune.statusString());
+}
+
+/*
+ * The MD5 calculated from the raw data matches the loaded tune one.
+ */
+TEST_FIXTURE(TestFixture, TestRawMD5)
+{
+    SidTune tune(data, BUFFERSIZE);
+
+    char md5[SidTune::MD5_LENGTH + 1];
+    CHECK(SidTune::createMD5(data, BUFFERSIZE, md5) != nullptr);
+    CHECK_EQUAL(tune.createMD5(), md5);
+}
+
+/*
+ * The bulk MD5 matches the loaded tunes ones and skips invalid data.
+ */
+TEST_FIXTURE(TestFixture, TestRawMD5Bulk)
+{
+    const int COUNT = 6;
+    uint8_t tunes[COUNT][BUFFERSIZE];
+    for (int i = 0; i < COUNT; i++)
+        memcpy(tunes[i], data, BUFFERSIZE);
+
+    tunes[1][FLAGS] = 0x08;         // NTSC
+    tunes[2][FLAGS] = 0x02;         // BASIC
+    tunes[3][SONGS_LO] = 0x40;      // 64 songs
+    tunes[4][SONGS_LO] = 0x00;      // no songs
+    tunes[5][SPEED_LO_LO] = 0xff;   // invalid
+
+    const uint_least8_t* buffers[COUNT];
+    uint_least32_t lengths[COUNT];
+    char md5s[COUNT][SidTune::MD5_LENGTH + 1];
+    char* results[COUNT];
+    for (int i = 0; i < COUNT; i++)
+    {
+        buffers[i] = tunes[i];
+        lengths[i] = BUFFERSIZE;
+        results[i] = md5s[i];
+    }
+
+    CHECK_EQUAL(COUNT - 1, SidTune::createMD5(COUNT, buffers, lengths, results));
+
+    for (int i = 0; i < COUNT - 1; i++)
+    {
+        SidTune tune(tunes[i], BUFFERSIZE);
+        CHECK_EQUAL(tune.createMD5(), md5s[i]);
+    }
+    CHECK_EQUAL("", md5s[COUNT - 1]);
+}
+
 /*
  * If 'startPage' is 0 or 0xFF, 'pageLength' must be set to 0.
  */
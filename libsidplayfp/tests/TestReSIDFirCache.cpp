@@ -0,0 +1,76 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#define private public
+#define protected public
+#define class struct
+
+#include "sid.h"
+
+using namespace UnitTest;
+using namespace reSID;
+
+const double CLOCK_FREQ = 985248.;
+
+SUITE(ReSIDFirCache)
+{
+
+TEST(TestShared)
+{
+    SID sid1;
+    SID sid2;
+
+    CHECK(sid1.set_sampling_parameters(CLOCK_FREQ, SAMPLE_RESAMPLE, 48000.));
+    CHECK(sid2.set_sampling_parameters(CLOCK_FREQ, SAMPLE_RESAMPLE, 48000.));
+
+    CHECK(sid1.fir != 0);
+    CHECK(sid1.fir == sid2.fir);
+    CHECK_EQUAL(1, SID::shared_firs());
+
+    // Other parameters get their own tables
+    CHECK(sid2.set_sampling_parameters(CLOCK_FREQ, SAMPLE_RESAMPLE, 44100.));
+    CHECK(sid1.fir != sid2.fir);
+    CHECK_EQUAL(2, SID::shared_firs());
+}
+
+TEST(TestReleased)
+{
+    {
+        SID sid1;
+        SID sid2;
+
+        CHECK(sid1.set_sampling_parameters(CLOCK_FREQ, SAMPLE_RESAMPLE_FASTMEM, 48000.));
+        CHECK(sid2.set_sampling_parameters(CLOCK_FREQ, SAMPLE_RESAMPLE_FASTMEM, 48000.));
+        CHECK_EQUAL(1, SID::shared_firs());
+
+        // Still used by the second chip
+        CHECK(sid1.set_sampling_parameters(CLOCK_FREQ, SAMPLE_FAST, 48000.));
+        CHECK(sid1.fir == 0);
+        CHECK(sid2.fir != 0);
+        CHECK_EQUAL(1, SID::shared_firs());
+    }
+
+    CHECK_EQUAL(0, SID::shared_firs());
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../src/builders/residfp-builder/residfp/resample/TwoPassSincResampler.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+const int THREADS = 8;
+const int CONFIGS = 6;
+
+const double CLOCK[CONFIGS] = { 985248., 1022730., 985248., 1022730., 985248., 1022730. };
+const double FREQ[CONFIGS] = { 44100., 48000., 32000., 22050., 96000., 44100. };
+
+/**
+ * Feed a deterministic signal to a new resampler
+ * and checksum the produced samples.
+ */
+unsigned int render(int config)
+{
+    const double passband = std::min(20000., 0.9 * FREQ[config] / 2.);
+    std::unique_ptr<TwoPassSincResampler> r(TwoPassSincResampler::create(CLOCK[config], FREQ[config], passband));
+
+    unsigned int hash = 0;
+    unsigned int state = 1;
+
+    for (int i = 0; i < 50000; i++)
+    {
+        state = state * 1664525 + 1013904223;
+
+        if (r->input(static_cast<int>(state >> 17) - 16384))
+        {
+            hash = hash * 31 + static_cast<unsigned short>(r->getOutput());
+        }
+    }
+
+    return hash;
+}
+
+SUITE(SincResampler)
+{
+
+TEST(TestConcurrentCreation)
+{
+    std::atomic<int> ready(0);
+    std::vector<unsigned int> results(THREADS * CONFIGS);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < THREADS; t++)
+    {
+        threads.push_back(std::thread([t, &ready, &results]()
+        {
+            // Start all together to maximize contention on the empty cache
+            ready++;
+            while (ready.load() < THREADS) {}
+
+            for (int i = 0; i < CONFIGS; i++)
+            {
+                // Each thread walks the configurations in a different order
+                const int config = (i + t) % CONFIGS;
+                results[t * CONFIGS + config] = render(config);
+            }
+        }));
+    }
+
+    for (int t = 0; t < THREADS; t++)
+    {
+        threads[t].join();
+    }
+
+    for (int config = 0; config < CONFIGS; config++)
+    {
+        const unsigned int expected = render(config);
+
+        for (int t = 0; t < THREADS; t++)
+        {
+            CHECK_EQUAL(expected, results[t * CONFIGS + config]);
+        }
+    }
+}
+
+TEST(TestSharedTableSameOutput)
+{
+    // A cached table gives the same output every time
+    const unsigned int first = render(0);
+    CHECK_EQUAL(first, render(0));
+}
+
+}
@@ -0,0 +1,294 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include "../src/sidplayfp/sidplayfp.h"
+#include "../src/sidplayfp/SidTune.h"
+#include "../src/sidplayfp/SidConfig.h"
+#include "../src/builders/residfp-builder/residfp.h"
+#include "../src/builders/resid-builder/resid.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#define BUFFERSIZE 147
+
+#define SAMPLES 48000
+
+using namespace UnitTest;
+
+uint8_t const bufferPSID[BUFFERSIZE] = {
+    0x50, 0x53, 0x49, 0x44, // magicID
+    0x00, 0x02,             // version
+    0x00, 0x7C,             // dataOffset
+    0x10, 0x00,             // loadAddress
+    0x10, 0x00,             // initAddress
+    0x10, 0x10,             // playAddress
+    0x00, 0x01,             // songs
+    0x00, 0x01,             // startSong
+    0x00, 0x00, 0x00, 0x00, // speed
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // name
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // author
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // released
+    0x00, 0x00,             // flags
+    0x00,                   // startPage
+    0x00,                   // pageLength
+    0x00,                   // secondSIDAddress
+    0x00,                   // thirdSIDAddress
+    // init: volume, sawtooth with gate, sustain
+    0xA9, 0x0F, 0x8D, 0x18, 0xD4,
+    0xA9, 0x21, 0x8D, 0x04, 0xD4,
+    0xA9, 0xF0, 0x8D, 0x06, 0xD4,
+    0x60,
+    // play: sweep the frequency
+    0xEE, 0x01, 0xD4,
+    0xEE, 0x00, 0xD4,
+    0x60
+};
+
+SUITE(Snapshot)
+{
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        residfp("ReSIDfp"),
+        resid("ReSID"),
+        tune(bufferPSID, BUFFERSIZE),
+        samples(SAMPLES)
+    {
+        tune.selectSong(0);
+    }
+
+    bool setup(sidbuilder &builder)
+    {
+        return setup(engine, builder);
+    }
+
+    bool setup(sidplayfp &player, sidbuilder &builder)
+    {
+        builder.create(1);
+
+        SidConfig cfg;
+        cfg.frequency = 48000;
+        cfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
+        cfg.sidEmulation = &builder;
+        // Start at the same cycle on every load
+        cfg.powerOnDelay = 0;
+
+        return player.config(cfg) && player.load(&tune);
+    }
+
+    bool saveState(std::vector<uint_least8_t> &state)
+    {
+        state.resize(engine.saveState(nullptr, 0));
+        return !state.empty()
+            && engine.saveState(&state[0], state.size()) == state.size();
+    }
+
+    bool restoreState(const std::vector<uint_least8_t> &state)
+    {
+        return engine.restoreState(state.data(), state.size());
+    }
+
+    std::vector<short> &render()
+    {
+        engine.play(&samples[0], SAMPLES);
+        return samples;
+    }
+
+    // The builders must outlive the engine
+    ReSIDfpBuilder residfp;
+    ReSIDBuilder resid;
+    SidTune tune;
+    sidplayfp engine;
+    std::vector<short> samples;
+};
+
+TEST_FIXTURE(TestFixture, TestReSIDfpRoundTrip)
+{
+    CHECK(setup(residfp));
+
+    render();
+
+    std::vector<uint_least8_t> state;
+    CHECK(saveState(state));
+
+    const std::vector<short> expected = render();
+
+    CHECK(restoreState(state));
+    CHECK(expected == render());
+}
+
+TEST_FIXTURE(TestFixture, TestReSIDRoundTrip)
+{
+    CHECK(setup(resid));
+
+    render();
+
+    std::vector<uint_least8_t> state;
+    CHECK(saveState(state));
+
+    const std::vector<short> expected = render();
+
+    CHECK(restoreState(state));
+    CHECK(expected == render());
+}
+
+TEST_FIXTURE(TestFixture, TestSeek)
+{
+    CHECK(setup(residfp));
+
+    CHECK(engine.seek(3000));
+    CHECK_EQUAL(3u, engine.time());
+
+    // Backwards
+    CHECK(engine.seek(1000));
+    CHECK_EQUAL(1u, engine.time());
+
+    // Playback resumes with the chips producing sound
+    const std::vector<short> &out = render();
+    short peak = 0;
+    for (std::vector<short>::const_iterator it = out.begin(); it != out.end(); ++it)
+        peak = std::max<short>(peak, *it);
+    CHECK(peak > 1000);
+}
+
+TEST_FIXTURE(TestFixture, TestSeekMatchesPlayback)
+{
+    // Play the first two seconds with the chips fully clocked.
+    // The resampler output rate is not exactly the nominal one,
+    // so playback is aligned on the seconds rendered
+    std::vector<short> expected(2 * SAMPLES);
+    CHECK(setup(residfp));
+    CHECK_EQUAL(0u, engine.renderSeconds(nullptr, 0, 2));
+    CHECK(engine.renderSeconds(&expected[0], 2 * SAMPLES, 1) >= SAMPLES);
+
+    std::vector<short> out(2 * SAMPLES);
+    CHECK(setup(residfp));
+    CHECK(engine.seek(2000));
+    CHECK(engine.renderSeconds(&out[0], 2 * SAMPLES, 1) >= SAMPLES);
+
+    // The voices are exact, only the filters and the resampler
+    // may differ slightly after the warmup
+    double signal = 0.;
+    double error = 0.;
+    for (unsigned int i = 0; i < SAMPLES; i++)
+    {
+        const double diff = out[i] - expected[i];
+        signal += static_cast<double>(expected[i]) * expected[i];
+        error += diff * diff;
+    }
+    CHECK(signal > 0.);
+    CHECK(error < signal * 1e-4);
+}
+
+TEST_FIXTURE(TestFixture, TestRenderSecondsWithoutBuffer)
+{
+    CHECK(setup(residfp));
+
+    CHECK_EQUAL(0u, engine.renderSeconds(nullptr, 0, 2));
+    CHECK_EQUAL(2u, engine.time());
+}
+
+TEST_FIXTURE(TestFixture, TestChunkedRenderSeconds)
+{
+    // A separate engine, so that both start from the same dithering
+    ReSIDfpBuilder builder("ReSIDfp");
+    sidplayfp single;
+    CHECK(setup(single, builder));
+
+    std::vector<short> expected(4 * SAMPLES);
+    const uint_least32_t expectedSamples = single.renderSeconds(&expected[0], expected.size(), 3);
+
+    CHECK(setup(residfp));
+
+    std::vector<short> out(4 * SAMPLES);
+    uint_least32_t samples = 0;
+    for (int i = 0; i < 3; i++)
+        samples += engine.renderSeconds(&out[samples], out.size() - samples, 1);
+
+    CHECK_EQUAL(3u, single.time());
+    CHECK_EQUAL(3u, engine.time());
+    CHECK_EQUAL(expectedSamples, samples);
+    CHECK(expected == out);
+}
+
+TEST_FIXTURE(TestFixture, TestChunkedRenderCyclesFloat)
+{
+    ReSIDfpBuilder builder("ReSIDfp");
+    sidplayfp single;
+    CHECK(setup(single, builder));
+
+    const uint_least32_t cycles = 2000000;
+
+    std::vector<float> expected(3 * SAMPLES);
+    const uint_least32_t expectedSamples = single.renderCyclesFloat(&expected[0], expected.size(), cycles);
+
+    CHECK(setup(residfp));
+
+    // Odd sized chunks up to the same time
+    std::vector<float> out(3 * SAMPLES);
+    uint_least32_t samples = 0;
+    for (uint_least32_t done = 0; done < cycles; done += 12345)
+    {
+        const uint_least32_t chunk = std::min<uint_least32_t>(12345, cycles - done);
+        samples += engine.renderCyclesFloat(&out[samples], out.size() - samples, chunk);
+    }
+
+    CHECK_EQUAL(expectedSamples, samples);
+    CHECK(expected == out);
+    CHECK(expected[SAMPLES] != 0.f);
+}
+
+TEST_FIXTURE(TestFixture, TestCorruptState)
+{
+    CHECK(setup(residfp));
+
+    render();
+
+    std::vector<uint_least8_t> state;
+    CHECK(saveState(state));
+
+    // Too small a buffer is left untouched
+    std::vector<uint_least8_t> small(state.size() - 1, 0x55);
+    CHECK_EQUAL(state.size(), engine.saveState(&small[0], small.size()));
+    CHECK(small == std::vector<uint_least8_t>(state.size() - 1, 0x55));
+
+    std::vector<uint_least8_t> truncated(state.begin(), state.end() - 1);
+    CHECK(!restoreState(truncated));
+
+    std::vector<uint_least8_t> foreign(state);
+    foreign[0] ^= 0xff;
+    CHECK(!restoreState(foreign));
+
+    CHECK(!engine.restoreState(nullptr, 0));
+
+}
+
+}
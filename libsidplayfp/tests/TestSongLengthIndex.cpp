@@ -0,0 +1,123 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include <cstdio>
+
+#include "../src/utils/SongLengthIndex.h"
+
+using namespace UnitTest;
+using namespace libsidplayfp;
+
+SUITE(SongLengthIndex)
+{
+
+const char* SOURCE_NAME = "./TestSongLengthIndex.txt";
+const char* INDEX_NAME = "./TestSongLengthIndex.idx";
+
+const char* MD5_1 = "0123456789abcdef0123456789abcdef";
+const char* MD5_2 = "fedcba9876543210fedcba9876543210";
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture()
+    {
+        FILE *f = fopen(SOURCE_NAME, "w");
+        fputs("; Songlengths\n"
+              "[Database]\n"
+              "; /MUSICIANS/A/Tune.sid\n"
+              "0123456789ABCDEF0123456789ABCDEF=3:25 0:07.500 12:00(G)\r\n"
+              "fedcba9876543210fedcba9876543210=1:01\n"
+              "fedcba9876543210fedcba9876543210=9:99\n"
+              "00000000000000000000000000000000=garbage\n", f);
+        fclose(f);
+    }
+
+    ~TestFixture()
+    {
+        remove(SOURCE_NAME);
+        remove(INDEX_NAME);
+    }
+};
+
+TEST_FIXTURE(TestFixture, TestLookup)
+{
+    CHECK(SongLengthIndex::build(SOURCE_NAME, INDEX_NAME));
+
+    SongLengthIndex index;
+    CHECK(index.open(INDEX_NAME, SOURCE_NAME));
+
+    CHECK_EQUAL(205, index.length(MD5_1, 1));
+    CHECK_EQUAL(7, index.length(MD5_1, 2));
+    CHECK_EQUAL(720, index.length(MD5_1, 3));
+    CHECK_EQUAL(-1, index.length(MD5_1, 4));
+    CHECK_EQUAL(-1, index.length(MD5_1, 0));
+}
+
+TEST_FIXTURE(TestFixture, TestFirstEntryWins)
+{
+    CHECK(SongLengthIndex::build(SOURCE_NAME, INDEX_NAME));
+
+    SongLengthIndex index;
+    CHECK(index.open(INDEX_NAME, nullptr));
+
+    CHECK_EQUAL(61, index.length(MD5_2, 1));
+}
+
+TEST_FIXTURE(TestFixture, TestMissing)
+{
+    CHECK(SongLengthIndex::build(SOURCE_NAME, INDEX_NAME));
+
+    SongLengthIndex index;
+    CHECK(index.open(INDEX_NAME, nullptr));
+
+    CHECK_EQUAL(-1, index.length("00000000000000000000000000000000", 1));
+    CHECK_EQUAL(-1, index.length("11111111111111111111111111111111", 1));
+    CHECK_EQUAL(-1, index.length("not an md5", 1));
+}
+
+TEST_FIXTURE(TestFixture, TestStale)
+{
+    CHECK(SongLengthIndex::build(SOURCE_NAME, INDEX_NAME));
+
+    FILE *f = fopen(SOURCE_NAME, "a");
+    fputs("11111111111111111111111111111111=0:10\n", f);
+    fclose(f);
+
+    SongLengthIndex index;
+    CHECK(!index.open(INDEX_NAME, SOURCE_NAME));
+    CHECK(index.open(INDEX_NAME, nullptr));
+}
+
+TEST_FIXTURE(TestFixture, TestCorrupt)
+{
+    FILE *f = fopen(INDEX_NAME, "wb");
+    fputs("SIDLENDB but not really", f);
+    fclose(f);
+
+    SongLengthIndex index;
+    CHECK(!index.open(INDEX_NAME, nullptr));
+    CHECK_EQUAL(-1, index.length(MD5_1, 1));
+}
+
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright 2026 agent <agent@local>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../src/utils/STILview/stil.h"
+
+using namespace UnitTest;
+
+SUITE(Stil)
+{
+
+const char* BASE_DIR = "./TestStilHVSC";
+const char* DOCS_DIR = "./TestStilHVSC/DOCUMENTS";
+const char* STIL_NAME = "./TestStilHVSC/DOCUMENTS/STIL.txt";
+const char* BUG_NAME = "./TestStilHVSC/DOCUMENTS/BUGlist.txt";
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture()
+    {
+        mkdir(BASE_DIR, 0777);
+        mkdir(DOCS_DIR, 0777);
+
+        FILE *f = fopen(STIL_NAME, "wb");
+        fputs("#  STIL v3.40\r\n"
+              "\r\n"
+              "### Hubbard_Rob ###\r\n"
+              "/MUSICIANS/H/Hubbard_Rob/\r\n"
+              "COMMENT: The man.\r\n"
+              "\r\n"
+              "/MUSICIANS/H/Hubbard_Rob/Commando.sid\r\n"
+              "  TITLE: Commando\r\n"
+              " ARTIST: Rob Hubbard\r\n"
+              "\r\n"
+              "/MUSICIANS/H/Hubbard_Rob/Delta.sid\r\n"
+              "COMMENT: Three tunes.\r\n"
+              "(#1)\r\n"
+              "  TITLE: Title theme\r\n"
+              "(#2)\r\n"
+              "  TITLE: In game\r\n"
+              "COMMENT: Loops.\r\n", f);
+        fclose(f);
+
+        f = fopen(BUG_NAME, "wb");
+        fputs("/MUSICIANS/H/Hubbard_Rob/Delta.sid\r\n"
+              "BUG: Tempo is wrong.\r\n", f);
+        fclose(f);
+    }
+
+    ~TestFixture()
+    {
+        remove(STIL_NAME);
+        remove(BUG_NAME);
+        rmdir(DOCS_DIR);
+        rmdir(BASE_DIR);
+    }
+};
+
+TEST_FIXTURE(TestFixture, TestEntries)
+{
+    STIL stil;
+    CHECK(stil.setBaseDir(BASE_DIR));
+    CHECK_CLOSE(3.40f, stil.getSTILVersionNo(), 0.001f);
+
+    const char *entry = stil.getEntry("/MUSICIANS/H/Hubbard_Rob/Commando.sid", 1, STIL::title);
+    CHECK(entry != nullptr);
+    if (entry != nullptr)
+        CHECK_EQUAL("  TITLE: Commando\n", entry);
+
+    entry = stil.getEntry("/MUSICIANS/H/Hubbard_Rob/Delta.sid", 2, STIL::comment);
+    CHECK(entry != nullptr);
+    if (entry != nullptr)
+        CHECK_EQUAL("COMMENT: Loops.\n", entry);
+
+    CHECK(stil.getEntry("/MUSICIANS/H/Hubbard_Rob/Delta.sid", 3) == nullptr);
+
+    CHECK(stil.getEntry("/MUSICIANS/H/Hubbard_Rob/Missing.sid") == nullptr);
+    CHECK_EQUAL(STIL::NOT_IN_STIL, stil.getError());
+}
+
+TEST_FIXTURE(TestFixture, TestEntriesIgnoreCase)
+{
+    STIL stil;
+    CHECK(stil.setBaseDir(BASE_DIR));
+
+    const char *entry = stil.getEntry("/musicians/h/hubbard_rob/COMMANDO.SID", 1, STIL::title);
+    CHECK(entry != nullptr);
+    if (entry != nullptr)
+        CHECK_EQUAL("  TITLE: Commando\n", entry);
+}
+
+TEST_FIXTURE(TestFixture, TestGlobalCommentAndBug)
+{
+    STIL stil;
+    CHECK(stil.setBaseDir(BASE_DIR));
+
+    const char *comment = stil.getGlobalComment("/MUSICIANS/H/Hubbard_Rob/Delta.sid");
+    CHECK(comment != nullptr);
+    if (comment != nullptr)
+        CHECK_EQUAL("COMMENT: The man.\n", comment);
+
+    const char *bug = stil.getBug("/MUSICIANS/H/Hubbard_Rob/Delta.sid");
+    CHECK(bug != nullptr);
+    if (bug != nullptr)
+        CHECK_EQUAL("BUG: Tempo is wrong.\n", bug);
+
+    CHECK(stil.getBug("/MUSICIANS/H/Hubbard_Rob/Commando.sid") == nullptr);
+    CHECK_EQUAL(STIL::NOT_IN_BUG, stil.getError());
+}
+
+TEST_FIXTURE(TestFixture, TestConcurrentLookups)
+{
+    STIL stil;
+    CHECK(stil.setBaseDir(BASE_DIR));
+
+    std::vector<int> failures(4, 0);
+    std::vector<std::thread> threads;
+
+    for (unsigned int t = 0; t < failures.size(); t++)
+    {
+        threads.push_back(std::thread([&stil, &failures, t]()
+        {
+            std::string result;
+            for (int i = 0; i < 1000; i++)
+            {
+                if (!stil.getEntry(result, "/MUSICIANS/H/Hubbard_Rob/Delta.sid", 1 + (i + t) % 2, STIL::title))
+                    failures[t]++;
+                else if (result != ((i + t) % 2 ? "  TITLE: In game\n" : "  TITLE: Title theme\n"))
+                    failures[t]++;
+            }
+        }));
+    }
+
+    for (unsigned int t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+        CHECK_EQUAL(0, failures[t]);
+    }
+}
+
+}
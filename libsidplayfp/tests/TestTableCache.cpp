@@ -0,0 +1,131 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include <cstdio>
+
+#include "../src/builders/residfp-builder/residfp/TableCache.h"
+
+using namespace UnitTest;
+using namespace reSIDfp;
+
+SUITE(TableCache)
+{
+
+const char* NAME = "TestTableCache";
+const char* FILE_NAME = "./TestTableCache.tab";
+const uint64_t KEY = 0x123456789abcdefULL;
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture()
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            table1[i] = static_cast<unsigned short>(i * 7);
+        }
+
+        for (int i = 0; i < 3; i++)
+        {
+            table2[i] = static_cast<unsigned short>(i + 1);
+        }
+
+        const TableCache::chunk_t chunk1 = { table1, sizeof(table1) };
+        const TableCache::chunk_t chunk2 = { table2, sizeof(table2) };
+        chunks.push_back(chunk1);
+        chunks.push_back(chunk2);
+
+        TableCache::setDirectory(".");
+        TableCache::save(NAME, KEY, chunks);
+    }
+
+    ~TestFixture()
+    {
+        remove(FILE_NAME);
+        TableCache::setDirectory(nullptr);
+    }
+
+    unsigned short table1[1000];
+    unsigned short table2[3];
+    TableCache::chunks_t chunks;
+};
+
+TEST_FIXTURE(TestFixture, TestRoundTrip)
+{
+    unsigned short loaded1[1000] = { 0 };
+    unsigned short loaded2[3] = { 0 };
+
+    TableCache::chunks_t dest;
+    const TableCache::chunk_t chunk1 = { loaded1, sizeof(loaded1) };
+    const TableCache::chunk_t chunk2 = { loaded2, sizeof(loaded2) };
+    dest.push_back(chunk1);
+    dest.push_back(chunk2);
+
+    CHECK(TableCache::load(NAME, KEY, dest));
+    CHECK_ARRAY_EQUAL(table1, loaded1, 1000);
+    CHECK_ARRAY_EQUAL(table2, loaded2, 3);
+}
+
+TEST_FIXTURE(TestFixture, TestWrongKey)
+{
+    CHECK(!TableCache::load(NAME, KEY + 1, chunks));
+}
+
+TEST_FIXTURE(TestFixture, TestWrongSize)
+{
+    TableCache::chunks_t dest(chunks.begin(), chunks.begin() + 1);
+
+    CHECK(!TableCache::load(NAME, KEY, dest));
+}
+
+TEST_FIXTURE(TestFixture, TestCorrupted)
+{
+    FILE* f = fopen(FILE_NAME, "r+b");
+    fseek(f, 100, SEEK_SET);
+    fputc(0x55, f);
+    fclose(f);
+
+    unsigned short loaded1[1000] = { 0 };
+    unsigned short loaded2[3] = { 0 };
+
+    TableCache::chunks_t dest;
+    const TableCache::chunk_t chunk1 = { loaded1, sizeof(loaded1) };
+    const TableCache::chunk_t chunk2 = { loaded2, sizeof(loaded2) };
+    dest.push_back(chunk1);
+    dest.push_back(chunk2);
+
+    CHECK(!TableCache::load(NAME, KEY, dest));
+
+    // Destination is left untouched
+    CHECK_EQUAL(0, loaded1[0]);
+    CHECK_EQUAL(0, loaded2[0]);
+}
+
+TEST_FIXTURE(TestFixture, TestDisabled)
+{
+    TableCache::setDirectory(nullptr);
+
+    CHECK(!TableCache::load(NAME, KEY, chunks));
+}
+
+}
@@ -0,0 +1,147 @@
+/*
+ * This file is part of libsidplayfp, a SID player engine.
+ *
+ *  Copyright (C) 2026 agent
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include "UnitTest++/UnitTest++.h"
+#include "UnitTest++/TestReporter.h"
+
+#include <cstdlib>
+
+#define private public
+#define protected public
+#define class struct
+
+#include "../src/builders/residfp-builder/residfp/WaveformGenerator.h"
+
+using namespace UnitTest;
+
+SUITE(WaveformGenerator)
+{
+
+struct TestFixture
+{
+    // Test setup
+    TestFixture() :
+        models(8, 4096)
+    {
+        for (unsigned int w = 0; w < 8; w++)
+        {
+            for (unsigned int i = 0; i < 4096; i++)
+            {
+                models[w][i] = static_cast<short>((i * (w + 1)) & 0xfff);
+            }
+        }
+
+        setup(single);
+        setup(batched);
+        setup(ring);
+    }
+
+    void setup(reSIDfp::WaveformGenerator &generator)
+    {
+        generator.setWaveformModels(&models);
+        generator.setChipModel(reSIDfp::MOS6581);
+        generator.reset();
+    }
+
+    matrix_t models;
+    reSIDfp::WaveformGenerator single;
+    reSIDfp::WaveformGenerator batched;
+    reSIDfp::WaveformGenerator ring;
+};
+
+TEST_FIXTURE(TestFixture, TestBatchedClock)
+{
+    srand(1);
+
+    // Only the MSB of the ring modulator is used
+    ring.accumulator = 0x800000;
+
+    for (int i=0; i<2000; i++)
+    {
+        switch (rand() % 4)
+        {
+        case 0:
+        {
+            const unsigned char control = rand() & 0xff;
+            single.writeCONTROL_REG(control);
+            batched.writeCONTROL_REG(control);
+            break;
+        }
+        case 1:
+        {
+            const unsigned char freq_lo = rand() & 0xff;
+            single.writeFREQ_LO(freq_lo);
+            batched.writeFREQ_LO(freq_lo);
+            break;
+        }
+        case 2:
+        {
+            const unsigned char freq_hi = rand() & 0xff;
+            single.writeFREQ_HI(freq_hi);
+            batched.writeFREQ_HI(freq_hi);
+            break;
+        }
+        case 3:
+        {
+            const unsigned char pw_hi = rand() & 0xff;
+            single.writePW_HI(pw_hi);
+            batched.writePW_HI(pw_hi);
+            break;
+        }
+        }
+
+        // Mostly short spans, with some longer than the floating DAC fade time
+        const unsigned int cycles = (rand() % 16 == 0) ? rand() % 2000000 : rand() % 64;
+
+        for (unsigned int j=0; j<cycles; j++)
+        {
+            single.clock();
+            single.output(&ring);
+        }
+
+        // Only the last two cycles compute the output
+        const unsigned int skipped = (cycles > 2 && !batched.readNoiseWriteback()) ? cycles - 2 : 0;
+        if (skipped > 0)
+        {
+            batched.clock(skipped);
+            batched.skipOutput(skipped);
+        }
+        for (unsigned int j=skipped; j<cycles; j++)
+        {
+            batched.clock();
+            batched.output(&ring);
+        }
+
+        CHECK_EQUAL(single.accumulator, batched.accumulator);
+        CHECK_EQUAL(single.msb_rising, batched.msb_rising);
+        CHECK_EQUAL(single.shift_register, batched.shift_register);
+        CHECK_EQUAL(single.shift_pipeline, batched.shift_pipeline);
+        CHECK_EQUAL(single.shift_register_reset, batched.shift_register_reset);
+        CHECK_EQUAL(single.noise_output, batched.noise_output);
+        CHECK_EQUAL(single.pulse_output, batched.pulse_output);
+        CHECK_EQUAL(single.floating_output_ttl, batched.floating_output_ttl);
+        CHECK_EQUAL((int)single.readOSC(), (int)batched.readOSC());
+
+        if (single.accumulator != batched.accumulator || single.shift_register != batched.shift_register)
+            break;
+    }
+}
+
+}
@@ -357,6 +357,11 @@ int ConsolePlayer::args (int argc, const char *argv[])
                     m_outfile = &argv[i][4];
             }
 
+            else if (strncmp (&argv[i][1], "-ring=", 6) == 0)
+            {
+                m_driver.ringLength = (uint_least32_t) atoi(&argv[i][7]);
+            }
+
 #ifdef HAVE_SIDPLAYFP_BUILDERS_RESIDFP_H
             else if (strcmp (&argv[i][1], "-residfp") == 0)
             {
@@ -571,9 +576,12 @@ void ConsolePlayer::displayArgs (const char *arg)
         << "              Use 'f' to force the model" << endl
 
         << " -r[i|r][f]   set resampling method (default: resample interpolate)" << endl
-        << "              Use 'f' to enable fast resampling (only for reSID)" << endl
+        << "              Use 'f' to enable fast resampling" << endl
+
+        << " -w[name]     create wav file (default: <datafile>[n].wav)" << endl
 
-        << " -w[name]     create wav file (default: <datafile>[n].wav)" << endl;
+        << " --ring=<ms>  write to the soundcard from a separate thread through a" << endl
+        << "              ring buffer of the given length (default: 0, disabled)" << endl;
 
 #ifdef HAVE_SIDPLAYFP_BUILDERS_RESIDFP_H
     out << " --residfp    use reSIDfp emulation (default)" << endl;
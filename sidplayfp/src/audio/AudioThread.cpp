@@ -0,0 +1,203 @@
+/*
+ * This file is part of sidplayfp, a console SID player.
+ *
+ * Copyright 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "AudioThread.h"
+
+#include <algorithm>
+#include <chrono>
+
+// How long to wait for room in the ring before
+// giving up on a stalled device, in milliseconds
+const uint_least32_t STALL_TIMEOUT = 1000;
+
+AudioThread::AudioThread(IAudio *device, uint_least32_t length) :
+    m_device(device),
+    m_length(length),
+    m_buffer(nullptr),
+    m_running(false),
+    m_paused(false),
+    m_draining(false),
+    m_primed(false),
+    m_busy(false),
+    m_starved(false),
+    m_failed(false),
+    m_underruns(0),
+    m_overruns(0) {}
+
+AudioThread::~AudioThread()
+{
+    close();
+}
+
+bool AudioThread::open(AudioConfig &cfg)
+{
+    if (!m_device->open(cfg))
+        return false;
+
+    m_settings = cfg;
+
+    // Round the ring up to whole buffers, keeping at least two
+    // so the device can be fed while the next one is rendered
+    const size_t bufSize = cfg.bufSize;
+    const size_t length = static_cast<size_t>(cfg.frequency) * cfg.channels * m_length / 1000;
+    const size_t buffers = std::max<size_t>(2, (length + bufSize - 1) / bufSize);
+    m_ring.resize(buffers * bufSize);
+
+    m_buffer = new short[bufSize];
+
+    m_paused = false;
+    m_draining = false;
+    m_primed = false;
+    m_busy = false;
+    m_starved = false;
+    m_failed = false;
+    m_underruns = 0;
+    m_overruns = 0;
+
+    m_running = true;
+    m_thread = std::thread(&AudioThread::run, this);
+    return true;
+}
+
+void AudioThread::run()
+{
+    const size_t bufSize = m_settings.bufSize;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (m_running)
+    {
+        if (!m_paused)
+        {
+            // Start the output only once the ring is full
+            if (!m_primed && (m_draining || (m_ring.space() < bufSize)))
+                m_primed = true;
+
+            const size_t available = m_ring.available();
+            if (m_primed && ((available >= bufSize) || (m_draining && available)))
+            {
+                m_busy = true;
+                m_starved = false;
+                lock.unlock();
+
+                short *out = m_device->buffer();
+                const size_t count = m_ring.read(out, bufSize);
+                // Pad the tail of the tune with silence
+                std::fill(out + count, out + bufSize, 0);
+
+                lock.lock();
+                m_cond.notify_all();
+                lock.unlock();
+
+                const bool ok = m_device->write();
+
+                lock.lock();
+                m_busy = false;
+                if (!ok)
+                    m_failed = true;
+                m_cond.notify_all();
+                continue;
+            }
+
+            if (m_primed && !m_draining && !m_starved)
+            {
+                m_starved = true;
+                m_underruns++;
+            }
+        }
+
+        m_cond.wait(lock);
+    }
+}
+
+void AudioThread::waitIdle(std::unique_lock<std::mutex> &lock)
+{
+    m_cond.wait(lock, [this] { return !m_busy; });
+}
+
+bool AudioThread::write()
+{
+    const size_t bufSize = m_settings.bufSize;
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_paused = false;
+
+    if (!m_cond.wait_for(lock, std::chrono::milliseconds(STALL_TIMEOUT),
+            [this, bufSize] { return m_ring.space() >= bufSize; }))
+    {   // The device is not taking data, drop the buffer
+        // rather than blocking the player
+        m_overruns++;
+        return !m_failed;
+    }
+
+    lock.unlock();
+    m_ring.write(m_buffer, bufSize);
+    lock.lock();
+
+    m_cond.notify_all();
+    return !m_failed;
+}
+
+void AudioThread::pause()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_paused = true;
+    waitIdle(lock);
+    m_device->pause();
+}
+
+void AudioThread::reset()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    waitIdle(lock);
+    m_ring.clear();
+    m_primed = false;
+    m_starved = false;
+    m_device->reset();
+}
+
+void AudioThread::close()
+{
+    if (!m_thread.joinable())
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+
+        // Play what is left in the ring
+        m_paused = false;
+        m_draining = true;
+        m_cond.notify_all();
+        m_cond.wait_for(lock, std::chrono::milliseconds(m_length + STALL_TIMEOUT),
+            [this] { return !m_busy && !m_ring.available(); });
+
+        m_running = false;
+        m_cond.notify_all();
+    }
+
+    m_thread.join();
+    m_device->close();
+
+    delete[] m_buffer;
+    m_buffer = nullptr;
+}
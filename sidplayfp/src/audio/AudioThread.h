@@ -0,0 +1,110 @@
+/*
+ * This file is part of sidplayfp, a console SID player.
+ *
+ * Copyright 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef AUDIOTHREAD_H
+#define AUDIOTHREAD_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "IAudio.h"
+#include "AudioConfig.h"
+#include "RingBuffer.h"
+
+#include "sidcxx11.h"
+
+/*
+ * Feeds an audio driver from its own thread.
+ *
+ * The rendered buffers are queued in a ring and written to the
+ * device by a separate thread, so a slow render doesn't starve
+ * the device and a blocking device write doesn't stall the
+ * emulation, as long as the ring has data.
+ */
+class AudioThread : public IAudio
+{
+private:
+    std::unique_ptr<IAudio> m_device;
+
+    /// Requested ring length in milliseconds
+    const uint_least32_t m_length;
+
+    AudioConfig m_settings;
+    short *m_buffer;
+    RingBuffer<short> m_ring;
+
+    std::thread m_thread;
+
+    /// Protects the flags below, the ring itself is lock-free
+    std::mutex m_lock;
+    std::condition_variable m_cond;
+
+    bool m_running;
+    bool m_paused;
+    bool m_draining;
+    /// Set once the ring has been filled up before starting the output
+    bool m_primed;
+    /// Set while the output thread is in the device write
+    bool m_busy;
+    /// Set until the output thread gets data after an underrun
+    bool m_starved;
+    bool m_failed;
+
+    std::atomic<unsigned int> m_underruns;
+    std::atomic<unsigned int> m_overruns;
+
+private:
+    void run();
+    void waitIdle(std::unique_lock<std::mutex> &lock);
+
+public:
+    /**
+     * @param device the driver to feed, ownership is taken
+     * @param length the ring length in milliseconds
+     */
+    AudioThread(IAudio *device, uint_least32_t length);
+    ~AudioThread();
+
+    bool open(AudioConfig &cfg) override;
+    void reset() override;
+    bool write() override;
+    void close() override;
+    void pause() override;
+    short *buffer() const override { return m_buffer; }
+    void getConfig(AudioConfig &cfg) const override { cfg = m_settings; }
+    const char *getErrorString() const override { return m_device->getErrorString(); }
+
+    /**
+     * Number of times the device ran out of data.
+     */
+    unsigned int underruns() const { return m_underruns; }
+
+    /**
+     * Number of buffers dropped because the device stalled.
+     */
+    unsigned int overruns() const { return m_overruns; }
+};
+
+#endif // AUDIOTHREAD_H
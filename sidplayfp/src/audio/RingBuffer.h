@@ -0,0 +1,131 @@
+/*
+ * This file is part of sidplayfp, a console SID player.
+ *
+ * Copyright 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cstddef>
+#include <cstring>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+/**
+ * Lock-free ring buffer for a single producer and a single consumer.
+ *
+ * The positions only ever grow, the amount of buffered data
+ * is their difference. Each side publishes its position after
+ * copying the data, so the other side never sees a partial copy.
+ */
+template<typename T>
+class RingBuffer
+{
+private:
+    std::vector<T> m_data;
+
+    /// Total amount of data written, updated by the producer only
+    std::atomic<size_t> m_head;
+
+    /// Total amount of data read, updated by the consumer only
+    std::atomic<size_t> m_tail;
+
+public:
+    RingBuffer() :
+        m_head(0),
+        m_tail(0) {}
+
+    /**
+     * Set the capacity and drop the contents.
+     * Must not be called while the buffer is in use.
+     */
+    void resize(size_t size)
+    {
+        m_data.assign(size, T());
+        clear();
+    }
+
+    /**
+     * Drop the contents.
+     * Must not be called while the buffer is in use.
+     */
+    void clear()
+    {
+        m_head.store(0);
+        m_tail.store(0);
+    }
+
+    size_t capacity() const { return m_data.size(); }
+
+    /**
+     * Get the amount of data ready to be read.
+     */
+    size_t available() const
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the amount of data that can be written.
+     */
+    size_t space() const { return capacity() - available(); }
+
+    /**
+     * Append data, producer side.
+     *
+     * @return the amount of data actually written
+     */
+    size_t write(const T *data, size_t count)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        count = std::min(count, capacity() - (head - tail));
+
+        const size_t pos = head % capacity();
+        const size_t first = std::min(count, capacity() - pos);
+        memcpy(&m_data[pos], data, first * sizeof(T));
+        memcpy(&m_data[0], data + first, (count - first) * sizeof(T));
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Remove data, consumer side.
+     *
+     * @return the amount of data actually read
+     */
+    size_t read(T *data, size_t count)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t head = m_head.load(std::memory_order_acquire);
+        count = std::min(count, head - tail);
+
+        const size_t pos = tail % capacity();
+        const size_t first = std::min(count, capacity() - pos);
+        memcpy(data, &m_data[pos], first * sizeof(T));
+        memcpy(data + first, &m_data[0], (count - first) * sizeof(T));
+
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+};
+
+#endif // RINGBUFFER_H
@@ -21,13 +21,33 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  */
 
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
 #include "WavFile.h"
 
-#include <vector>
-#include <iomanip>
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include <new>
 
+#ifdef HAVE_POSIX_FADVISE
+#  include <fcntl.h>
+#endif
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+// Size of the blocks handed to the I/O thread, in bytes
+const size_t BLOCK_SIZE = 1 << 20;
+
+// Number of blocks, enough to keep rendering while one is written
+const int BLOCKS = 4;
+
+// Largest size that fits the 32 bit RIFF lengths
+const uint_least64_t RIFF_MAX = 0xffffffff;
+
 // Get the lo byte (8 bit) in a dword (32 bit)
 inline uint8_t endian_32lo8 (uint_least32_t dword)
 {
@@ -76,9 +96,40 @@ inline void endian_little32 (uint8_t ptr[4], uint_least32_t dword)
     ptr[3] = endian_16hi8  (word);
 }
 
+// Write a little-endian 64-bit word to eight bytes in memory.
+inline void endian_little64 (uint8_t ptr[8], uint_least64_t qword)
+{
+    endian_little32 (ptr,     (uint_least32_t) qword);
+    endian_little32 (ptr + 4, (uint_least32_t) (qword >> 32));
+}
+
+// Convert samples to float in the [-1, 1) range
+static void convertToFloat (float *out, const short *in, size_t count)
+{
+    const float scale = 1.f / 32768.f;
+
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128 vscale = _mm_set1_ps (scale);
+    for (; i + 8 <= count; i += 8)
+    {
+        const __m128i s = _mm_loadu_si128 ((const __m128i*)(in + i));
+        // Sign extend to 32 bit
+        const __m128i lo = _mm_srai_epi32 (_mm_unpacklo_epi16 (s, s), 16);
+        const __m128i hi = _mm_srai_epi32 (_mm_unpackhi_epi16 (s, s), 16);
+        _mm_storeu_ps (out + i,     _mm_mul_ps (_mm_cvtepi32_ps (lo), vscale));
+        _mm_storeu_ps (out + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (hi), vscale));
+    }
+#endif
+    for (; i < count; i++)
+        out[i] = ((float)in[i]) * scale;
+}
+
 const wavHeader WavFile::defaultWavHdr = {
     // ASCII keywords are hex-ified.
     {0x52,0x49,0x46,0x46}, {0,0,0,0}, {0x57,0x41,0x56,0x45},
+    {0x4a,0x55,0x4e,0x4b}, {28,0,0,0},
+    {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {0,0,0,0},
     {0x66,0x6d,0x74,0x20}, {16,0,0,0},
     {1,0}, {0,0}, {0,0,0,0}, {0,0,0,0}, {0,0}, {0,0},
     {0x64,0x61,0x74,0x61}, {0,0,0,0}
@@ -87,10 +138,13 @@ const wavHeader WavFile::defaultWavHdr = {
 WavFile::WavFile(const std::string &name) :
     AudioBase("WAVFILE"),
     name(name),
+    byteCount(0),
     wavHdr(defaultWavHdr),
     file(nullptr),
-    headerWritten(false),
-    precision(32)
+    precision(32),
+    current(nullptr),
+    ioDone(false),
+    ioFailed(false)
 {}
 
 bool WavFile::open(AudioConfig &cfg)
@@ -108,23 +162,30 @@ bool WavFile::open(AudioConfig &cfg)
     if (name.empty())
         return false;
 
-    if (file && !file->fail())
+    if (file)
         close();
 
     byteCount = 0;
 
     // We need to make a buffer for the user
+    // and the blocks for the I/O thread
     try
     {
         _sampleBuffer = new short[bufSize];
+        blocks.resize(BLOCKS);
+        for (std::vector<block_t>::iterator it = blocks.begin(); it != blocks.end(); ++it)
+            it->data.resize(BLOCK_SIZE / sizeof(float));
     }
     catch (std::bad_alloc const &ba)
     {
+        delete[] _sampleBuffer;
+        _sampleBuffer = nullptr;
         setError("Unable to allocate memory for sample buffers.");
         return false;
     }
 
     // Fill in header with parameters and expected file size.
+    wavHdr = defaultWavHdr;
     endian_little32(wavHdr.length, sizeof(wavHeader)-8);
     endian_little16(wavHdr.channels, channels);
     endian_little16(wavHdr.format, format);
@@ -136,63 +197,170 @@ bool WavFile::open(AudioConfig &cfg)
 
     if (name.compare("-") == 0)
     {
-        file = &std::cout;
+        file = stdout;
     }
     else
     {
-        file = new std::ofstream(name.c_str(), std::ios::out|std::ios::binary|std::ios::trunc);
+        file = fopen(name.c_str(), "wb");
+        if (!file)
+        {
+            delete[] _sampleBuffer;
+            _sampleBuffer = nullptr;
+            setError("Unable to open file.");
+            return false;
+        }
+
+        // Blocks are large enough, skip the stdio buffer
+        setvbuf(file, nullptr, _IONBF, 0);
+#ifdef HAVE_POSIX_FADVISE
+        posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
     }
 
+    spareBlocks.clear();
+    pendingBlocks.clear();
+    for (size_t i = 1; i < blocks.size(); i++)
+        spareBlocks.push_back(&blocks[i]);
+
+    // The header goes first, it is rewritten with
+    // the final lengths when closing
+    current = &blocks[0];
+    memcpy(&current->data[0], &wavHdr, sizeof(wavHeader));
+    current->length = sizeof(wavHeader);
+
+    ioDone = false;
+    ioFailed = false;
+    ioThread = std::thread(&WavFile::ioLoop, this);
+
     _settings = cfg;
     return true;
 }
 
+void WavFile::ioLoop()
+{
+    std::unique_lock<std::mutex> lock(ioLock);
+    for (;;)
+    {
+        ioCond.wait(lock, [this] { return !pendingBlocks.empty() || ioDone; });
+        if (pendingBlocks.empty())
+            break;
+
+        block_t *block = pendingBlocks.front();
+        pendingBlocks.pop_front();
+        lock.unlock();
+
+        if (!ioFailed && (fwrite(&block->data[0], 1, block->length, file) != block->length))
+            ioFailed = true;
+
+        lock.lock();
+        spareBlocks.push_back(block);
+        ioCond.notify_all();
+    }
+}
+
+// Hand the current block to the I/O thread and get an empty one
+void WavFile::queueBlock()
+{
+    std::unique_lock<std::mutex> lock(ioLock);
+    pendingBlocks.push_back(current);
+    ioCond.notify_all();
+
+    ioCond.wait(lock, [this] { return !spareBlocks.empty(); });
+    current = spareBlocks.back();
+    spareBlocks.pop_back();
+    current->length = 0;
+}
+
 bool WavFile::write()
 {
-    if (file && !file->fail())
+    return write(_settings.bufSize);
+}
+
+bool WavFile::write(unsigned long int samples)
+{
+    if (!file)
+        return false;
+
+    /* XXX endianness... */
+    const size_t sampleSize = (precision == 16) ? sizeof(short) : sizeof(float);
+
+    const short *in = _sampleBuffer;
+    unsigned long int left = samples;
+    while (left)
     {
-        unsigned long int bytes = _settings.bufSize;
-        if (!headerWritten)
+        const size_t room = (BLOCK_SIZE - current->length) / sampleSize;
+        if (room == 0)
         {
-            file->write((char*)&wavHdr,sizeof(wavHeader));
-            headerWritten = true;
+            queueBlock();
+            continue;
         }
 
-        /* XXX endianness... */
+        const size_t count = std::min<size_t>(room, left);
+        char *out = reinterpret_cast<char*>(&current->data[0]) + current->length;
         if (precision == 16)
-        {
-            bytes *= 2;
-            file->write((char*)_sampleBuffer, bytes);
-        }
+            memcpy(out, in, count * sizeof(short));
         else
-        {
-            std::vector<float> buffer(_settings.bufSize);
-            bytes *= 4;
-            for (unsigned long i=0;i<_settings.bufSize;i++)
-            {
-                buffer[i] = ((float)_sampleBuffer[i])/32768.f;
-            }
-            file->write((char*)&buffer.front(), bytes);
-        }
-        byteCount += bytes;
+            convertToFloat(reinterpret_cast<float*>(out), in, count);
 
+        current->length += count * sampleSize;
+        in += count;
+        left -= count;
     }
-    return true;
+
+    byteCount += samples * sampleSize;
+    return !ioFailed;
 }
 
 void WavFile::close()
 {
-    if (file && !file->fail())
+    if (!file)
+        return;
+
+    // Flush the last block and wait for the I/O thread
     {
-        endian_little32(wavHdr.length, byteCount+sizeof(wavHeader)-8);
-        endian_little32(wavHdr.dataChunkLen, byteCount);
-        if (file != &std::cout)
+        std::lock_guard<std::mutex> lock(ioLock);
+        if (current->length)
+            pendingBlocks.push_back(current);
+        current = nullptr;
+        ioDone = true;
+        ioCond.notify_all();
+    }
+    ioThread.join();
+
+    if (file != stdout)
+    {
+        const uint_least64_t riffSize = byteCount + sizeof(wavHeader) - 8;
+        if (riffSize > RIFF_MAX)
+        {   // Too large for RIFF, switch to RF64
+            static const char rf64[4] = {0x52,0x46,0x36,0x34};
+            static const char ds64[4] = {0x64,0x73,0x36,0x34};
+            memcpy(wavHdr.mainChunkID, rf64, 4);
+            memcpy(wavHdr.ds64ChunkID, ds64, 4);
+            endian_little32(wavHdr.length, RIFF_MAX);
+            endian_little64(wavHdr.riffSize, riffSize);
+            endian_little64(wavHdr.dataSize, byteCount);
+            endian_little64(wavHdr.sampleCount,
+                byteCount / ((wavHdr.blockAlign[1] << 8) | wavHdr.blockAlign[0]));
+            endian_little32(wavHdr.dataChunkLen, RIFF_MAX);
+        }
+        else
         {
-            file->seekp(0, std::ios::beg);
-            file->write((char*)&wavHdr, sizeof(wavHeader));
-            delete file;
+            endian_little32(wavHdr.length, riffSize);
+            endian_little32(wavHdr.dataChunkLen, byteCount);
         }
-        file = nullptr;
-        delete[] _sampleBuffer;
+
+        if (fseek(file, 0, SEEK_SET) != 0
+            || fwrite(&wavHdr, sizeof(wavHeader), 1, file) != 1)
+            ioFailed = true;
+        if (fclose(file) != 0)
+            ioFailed = true;
     }
+    else
+    {
+        fflush(file);
+    }
+
+    file = nullptr;
+    delete[] _sampleBuffer;
+    _sampleBuffer = nullptr;
 }
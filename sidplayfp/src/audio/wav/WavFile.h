@@ -24,21 +24,37 @@
 #ifndef WAV_FILE_H
 #define WAV_FILE_H
 
-#include <iostream>
+#include <stdint.h>
+#include <cstdio>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "../AudioBase.h"
 
 struct wavHeader                        // little endian format
 {
-    char mainChunkID[4];                // 'RIFF' (ASCII)
+    char mainChunkID[4];                // 'RIFF' or 'RF64' (ASCII)
 
-    unsigned char length[4];            // file length
+    unsigned char length[4];            // file length, all ones for RF64
 
     char chunkID[4];                    // 'WAVE' (ASCII)
+
+    char ds64ChunkID[4];                // 'JUNK', turned into 'ds64' for RF64 (ASCII)
+    unsigned char ds64ChunkLen[4];      // length of ds64 chunk, always 28 bytes
+    unsigned char riffSize[8];          // 64 bit file length
+    unsigned char dataSize[8];          // 64 bit length of data
+    unsigned char sampleCount[8];       // number of sample frames
+    unsigned char tableLength[4];       // always 0
+
     char subChunkID[4];                    // 'fmt ' (ASCII)
     char subChunkLen[4];                // length of subChunk, always 16 bytes
-    unsigned char format[2];            // currently always = 1 = PCM-Code
+    unsigned char format[2];            // 1 = PCM-Code, 3 = IEEE float
 
     unsigned char channels[2];            // 1 = mono, 2 = stereo
     unsigned char sampleFreq[4];        // sample-frequency
@@ -48,27 +64,54 @@ struct wavHeader                        // little endian format
 
     char dataChunkID[4];                // keyword, begin of data chunk; = 'data' (ASCII)
 
-    unsigned char dataChunkLen[4];        // length of data
+    unsigned char dataChunkLen[4];        // length of data, all ones for RF64
 };
 
 /*
  * A basic WAV output file type
  * Initial implementation by Michael Schwendt <mschwendt@yahoo.com>
+ *
+ * The samples are collected in large blocks which are written
+ * to disk by a background thread. Space for an RF64 header is
+ * reserved with a JUNK chunk, so files larger than 4GB can be
+ * turned into RF64 when closing.
  */
 class WavFile: public AudioBase
 {
+private:
+    struct block_t
+    {
+        std::vector<float> data;
+        size_t length;      // used bytes
+    };
+
 private:
     std::string name;
 
-    unsigned long int byteCount;
+    uint_least64_t byteCount;
 
     static const wavHeader defaultWavHdr;
     wavHeader wavHdr;
 
-    std::ostream *file;
-    bool headerWritten;  // whether final header has been written
+    FILE *file;
     int precision;
 
+    // Blocks are recycled between the player and the I/O thread
+    std::vector<block_t> blocks;
+    std::vector<block_t*> spareBlocks;
+    std::deque<block_t*> pendingBlocks;
+    block_t *current;
+
+    std::thread ioThread;
+    std::mutex ioLock;
+    std::condition_variable ioCond;
+    bool ioDone;
+    std::atomic<bool> ioFailed;
+
+private:
+    void ioLoop();
+    void queueBlock();
+
 public:
     WavFile(const std::string &name);
     ~WavFile() { close(); }
@@ -77,22 +120,22 @@ public:
 
     // Only signed 16-bit and 32bit float samples are supported.
     // Endian-ess is adjusted if necessary.
-    //
-    // If number of sample bytes is given, this can speed up the
-    // process of closing a huge file on slow storage media.
-
     bool open(AudioConfig &cfg) override;
 
     // After write call old buffer is invalid and you should
     // use the new buffer provided instead.
     bool write() override;
+
+    // Write only the first samples of the buffer,
+    // for the end of a stream.
+    bool write(unsigned long int samples);
     void close() override;
     void pause() override {}
     void reset() override {}
 
     // Stream state.
-    bool fail() const { return (file->fail() != 0); }
-    bool bad()  const { return (file->bad()  != 0); }
+    bool fail() const { return ioFailed; }
+    bool bad()  const { return ioFailed; }
 };
 
 #endif /* WAV_FILE_H */
@@ -353,7 +353,11 @@ void ConsolePlayer::menu ()
     // Get all the text to the screen so music playback
     // is not disturbed.
     if ( !m_quietLevel )
+    {
         cerr << "00:00";
+        if (m_driver.ring)
+            cerr << " u:0000 o:0000";
+    }
     cerr << flush;
 }
 
@@ -28,6 +28,7 @@
 #include <fstream>
 #include <sstream>
 #include <new>
+#include <algorithm>
 
 using std::cout;
 using std::cerr;
@@ -75,65 +76,6 @@ const char ConsolePlayer::EXSID_ID[] = "exSID";
 #endif
 
 
-uint8_t* loadRom(const SID_STRING &romPath, const int size)
-{
-    SID_IFSTREAM is(romPath.c_str(), std::ios::binary);
-
-    if (is.is_open())
-    {
-        try
-        {
-            uint8_t *buffer = new uint8_t[size];
-
-            is.read((char*)buffer, size);
-            if (!is.fail())
-            {
-                is.close();
-                return buffer;
-            }
-            delete [] buffer;
-        }
-        catch (std::bad_alloc const &ba) {}
-    }
-
-    return nullptr;
-}
-
-
-uint8_t* loadRom(const SID_STRING &romPath, const int size, const TCHAR defaultRom[])
-{
-    // Try to load given rom
-    if (!romPath.empty())
-    {
-        uint8_t* buffer = loadRom(romPath, size);
-        if (buffer)
-            return buffer;
-    }
-
-    // Fallback to default rom path
-    try
-    {
-        SID_STRING dataPath(utils::getDataPath());
-
-        dataPath.append(SEPARATOR).append(TEXT("sidplayfp")).append(SEPARATOR).append(defaultRom);
-
-#if !defined _WIN32 && defined HAVE_UNISTD_H
-        if (::access(dataPath.c_str(), R_OK) != 0)
-        {
-            dataPath = PKGDATADIR;
-            dataPath.append(defaultRom);
-        }
-#endif
-
-        return loadRom(dataPath, size);
-    }
-    catch (utils::error const &e)
-    {
-        return nullptr;
-    }
-}
-
-
 ConsolePlayer::ConsolePlayer (const char * const name) :
     m_name(name),
     m_tune(nullptr),
@@ -146,6 +88,8 @@ ConsolePlayer::ConsolePlayer (const char * const name) :
 {   // Other defaults
     m_filter.enabled = true;
     m_driver.device  = NULL;
+    m_driver.ring    = NULL;
+    m_driver.ringLength = 0;
     m_driver.sid     = EMU_RESIDFP;
     m_timer.start    = 0;
     m_timer.length   = 0; // FOREVER
@@ -212,9 +156,9 @@ ConsolePlayer::ConsolePlayer (const char * const name) :
     createOutput (OUT_NULL, nullptr);
     createSidEmu (EMU_NONE);
 
-    uint8_t *kernalRom = loadRom((m_iniCfg.sidplay2()).kernalRom, 8192, TEXT("kernal"));
-    uint8_t *basicRom = loadRom((m_iniCfg.sidplay2()).basicRom, 8192, TEXT("basic"));
-    uint8_t *chargenRom = loadRom((m_iniCfg.sidplay2()).chargenRom, 4096, TEXT("chargen"));
+    uint8_t *kernalRom = utils::loadRom((m_iniCfg.sidplay2()).kernalRom, 8192, TEXT("kernal"));
+    uint8_t *basicRom = utils::loadRom((m_iniCfg.sidplay2()).basicRom, 8192, TEXT("basic"));
+    uint8_t *chargenRom = utils::loadRom((m_iniCfg.sidplay2()).chargenRom, 4096, TEXT("chargen"));
     m_engine.setRoms(kernalRom, basicRom, chargenRom);
     delete [] kernalRom;
     delete [] basicRom;
@@ -260,6 +204,7 @@ bool ConsolePlayer::createOutput (OUTPUTS driver, const SidTuneInfo *tuneInfo)
         if (m_driver.device != &m_driver.null)
             delete m_driver.device;
         m_driver.device = nullptr;
+        m_driver.ring   = nullptr;
     }
 
     // Create audio driver
@@ -273,9 +218,15 @@ bool ConsolePlayer::createOutput (OUTPUTS driver, const SidTuneInfo *tuneInfo)
         try
         {
             m_driver.device = new audioDrv();
+            if (m_driver.ringLength)
+            {   // Decouple the device writes from the emulation
+                m_driver.ring   = new AudioThread(m_driver.device, m_driver.ringLength);
+                m_driver.device = m_driver.ring;
+            }
         }
         catch (std::bad_alloc const &ba)
         {
+            delete m_driver.device;
             m_driver.device = nullptr;
         }
     break;
@@ -508,11 +459,10 @@ bool ConsolePlayer::open (void)
         return false;
     }
 
-    // Start the player.  Do this by fast
-    // forwarding to the start position
+    // Start the player.  Do this by seeking
+    // to the start position
     m_driver.selected = &m_driver.null;
-    m_speed.current   = m_speed.max;
-    m_engine.fastForward (100 * m_speed.current);
+    m_engine.seek (m_timer.start * 1000);
 
     m_engine.mute(0, 0, vMute[0]);
     m_engine.mute(0, 1, vMute[1]);
@@ -687,9 +637,17 @@ void ConsolePlayer::updateDisplay()
 
     if (!m_quietLevel)
     {
+        if (m_driver.ring)
+            cerr << "\b\b\b\b\b\b\b\b\b\b\b\b\b\b";
         cerr << "\b\b\b\b\b" << std::setw(2) << std::setfill('0')
              << ((seconds / 60) % 100) << ':' << std::setw(2)
-             << std::setfill('0') << (seconds % 60) << std::flush;
+             << std::setfill('0') << (seconds % 60);
+        if (m_driver.ring)
+        {   // Ring buffer underruns and overruns
+            cerr << " u:" << std::setw(4) << std::min(m_driver.ring->underruns(), 9999u)
+                 << " o:" << std::setw(4) << std::min(m_driver.ring->overruns(), 9999u);
+        }
+        cerr << std::flush;
     }
 
     m_timer.current = seconds;
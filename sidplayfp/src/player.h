@@ -36,6 +36,7 @@
 
 #include "audio/IAudio.h"
 #include "audio/AudioConfig.h"
+#include "audio/AudioThread.h"
 #include "audio/null/null.h"
 #include "IniConfig.h"
 
@@ -153,6 +154,8 @@ private:
         AudioConfig    cfg;
         IAudio*        selected; // Selected Output Driver
         IAudio*        device;   // HW/File Driver
+        AudioThread*   ring;     // Threaded output for the HW Driver
+        uint_least32_t ringLength; // Ring buffer length in ms, 0 disables
         Audio_Null     null;     // Used for everything
     } m_driver;
 
@@ -0,0 +1,793 @@
+/*
+ * This file is part of sidplayfp, a console SID player.
+ *
+ * Copyright 2026 agent
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ */
+
+//
+// sidrender - render a whole collection to WAV files using all cores
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+
+#ifdef _WIN32
+#  include <direct.h>
+#endif
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <sidplayfp/sidplayfp.h>
+#include <sidplayfp/SidConfig.h>
+#include <sidplayfp/SidInfo.h>
+#include <sidplayfp/SidTune.h>
+#include <sidplayfp/SidTuneInfo.h>
+#include <sidplayfp/SidDatabase.h>
+
+#ifdef HAVE_SIDPLAYFP_BUILDERS_RESIDFP_H
+#  include <sidplayfp/builders/residfp.h>
+#endif
+
+#ifdef HAVE_SIDPLAYFP_BUILDERS_RESID_H
+#  include <sidplayfp/builders/resid.h>
+#endif
+
+#include "IniConfig.h"
+#include "utils.h"
+#include "audio/AudioConfig.h"
+#include "audio/wav/WavFile.h"
+
+#include "sidcxx11.h"
+
+// Wide-chars are not yet supported here
+#undef SEPARATOR
+#define SEPARATOR "/"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+
+/// Default length for tunes missing from the database
+const uint_least32_t DEFAULT_LENGTH = 3 * 60;
+
+const char *tuneExtensions[] = { ".sid", ".psid", ".prg", ".p00", ".mus", ".str", nullptr };
+
+struct file_t
+{
+    /// Path used to load the tune
+    std::string path;
+
+    /// Output path without extension, relative to the output directory
+    std::string name;
+};
+
+class BatchRenderer
+{
+private:
+    // Settings
+    std::string m_outDir;
+    unsigned int m_threads;
+    uint_least32_t m_defaultLength;
+    bool m_quiet;
+
+    SidConfig m_engCfg;
+    AudioConfig m_audioCfg;
+
+    bool m_useResid;
+    bool m_filter;
+    double m_filterCurve6581;
+    int m_filterCurve8580;
+    double m_bias;
+
+    uint8_t *m_kernal;
+    uint8_t *m_basic;
+    uint8_t *m_chargen;
+
+    /// The database is not thread safe, lookups are serialized
+    SidDatabase m_database;
+    bool m_haveDatabase;
+    std::mutex m_databaseLock;
+
+    std::vector<file_t> m_files;
+
+    /// Next file to render, workers grab files as they become free
+    std::atomic<unsigned int> m_next;
+
+    // Statistics
+    std::mutex m_statsLock;
+    unsigned int m_done;
+    unsigned int m_subtunes;
+    unsigned int m_failed;
+    double m_audioSeconds;
+
+private:
+    static bool isTune(const std::string &name);
+    static bool isDirectory(const std::string &path);
+    static bool makeDirs(const std::string &path);
+    static bool parseTime(const char *str, uint_least32_t &time);
+    static bool isSafeName(const std::string &name);
+
+    void addDirectory(const std::string &path, const std::string &name);
+    bool addPlaylist(const std::string &path);
+
+    sidbuilder *createBuilder(unsigned int sids);
+    uint_least32_t length(SidTune &tune, unsigned int song);
+    bool renderSong(sidplayfp &engine, SidTune &tune, const file_t &file, unsigned int song, double &seconds);
+    void renderFile(const file_t &file);
+    void worker();
+
+    void displayUsage(const char *name) const;
+
+public:
+    BatchRenderer();
+    ~BatchRenderer();
+
+    int args(int argc, const char *argv[]);
+    int run();
+};
+
+BatchRenderer::BatchRenderer() :
+    m_outDir("."),
+    m_threads(std::thread::hardware_concurrency()),
+    m_defaultLength(DEFAULT_LENGTH),
+    m_quiet(false),
+    m_useResid(false),
+    m_filter(true),
+    m_filterCurve6581(0.),
+    m_filterCurve8580(0),
+    m_bias(0.),
+    m_kernal(nullptr),
+    m_basic(nullptr),
+    m_chargen(nullptr),
+    m_haveDatabase(false),
+    m_next(0),
+    m_done(0),
+    m_subtunes(0),
+    m_failed(0),
+    m_audioSeconds(0.)
+{
+    if (m_threads == 0)
+        m_threads = 1;
+
+    IniConfig iniCfg;
+    iniCfg.read();
+
+    m_engCfg.frequency = (iniCfg.audio()).frequency;
+    m_engCfg.playback = SidConfig::MONO;
+    m_engCfg.defaultC64Model = (iniCfg.emulation()).modelDefault;
+    m_engCfg.forceC64Model = (iniCfg.emulation()).modelForced;
+    m_engCfg.defaultSidModel = (iniCfg.emulation()).sidModel;
+    m_engCfg.forceSidModel = (iniCfg.emulation()).forceModel;
+
+    m_audioCfg.frequency = m_engCfg.frequency;
+    m_audioCfg.precision = (iniCfg.audio()).precision;
+
+    m_filter = (iniCfg.emulation()).filter;
+    m_filterCurve6581 = (iniCfg.emulation()).filterCurve6581;
+    m_filterCurve8580 = (iniCfg.emulation()).filterCurve8580;
+    m_bias = (iniCfg.emulation()).bias;
+
+    if ((iniCfg.sidplay2()).recordLength != 0)
+        m_defaultLength = (iniCfg.sidplay2()).recordLength;
+
+    m_kernal = utils::loadRom((iniCfg.sidplay2()).kernalRom, 8192, TEXT("kernal"));
+    m_basic = utils::loadRom((iniCfg.sidplay2()).basicRom, 8192, TEXT("basic"));
+    m_chargen = utils::loadRom((iniCfg.sidplay2()).chargenRom, 4096, TEXT("chargen"));
+
+    // Songlength database from HVSC_BASE or from the configuration
+    const char* hvscBase = getenv("HVSC_BASE");
+    if (hvscBase != nullptr)
+    {
+        std::string database(hvscBase);
+        database.append(SEPARATOR).append("DOCUMENTS").append(SEPARATOR).append("Songlengths.txt");
+        m_haveDatabase = m_database.open(database.c_str());
+    }
+
+#if !defined(WIN32) || !defined(UNICODE)
+    if (!m_haveDatabase && !(iniCfg.sidplay2()).database.empty())
+    {
+        m_haveDatabase = m_database.open((iniCfg.sidplay2()).database.c_str());
+    }
+#endif
+}
+
+BatchRenderer::~BatchRenderer()
+{
+    delete [] m_kernal;
+    delete [] m_basic;
+    delete [] m_chargen;
+}
+
+bool BatchRenderer::isTune(const std::string &name)
+{
+    const size_t dot = name.find_last_of('.');
+    if (dot == std::string::npos)
+        return false;
+
+    std::string ext(name.substr(dot));
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    for (const char **e = tuneExtensions; *e != nullptr; e++)
+    {
+        if (ext.compare(*e) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool BatchRenderer::isDirectory(const std::string &path)
+{
+    struct stat st;
+    return (stat(path.c_str(), &st) == 0) && S_ISDIR(st.st_mode);
+}
+
+bool BatchRenderer::makeDirs(const std::string &path)
+{
+    for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1))
+    {
+        const std::string dir(path.substr(0, pos));
+        if (!isDirectory(dir))
+        {
+#ifdef _WIN32
+            if (_mkdir(dir.c_str()) != 0)
+#else
+            if (mkdir(dir.c_str(), 0777) != 0)
+#endif
+            {
+                // Another worker may have just created it
+                if (!isDirectory(dir))
+                    return false;
+            }
+        }
+
+        if (pos == std::string::npos)
+            return true;
+    }
+}
+
+// Convert time from [mins:]secs format
+bool BatchRenderer::parseTime(const char *str, uint_least32_t &time)
+{
+    if (*str == '\0')
+        return false;
+
+    const char *sep = strchr(str, ':');
+    if (sep == nullptr)
+    {
+        time = atoi(str);
+        return true;
+    }
+
+    const int mins = atoi(str);
+    const int secs = atoi(sep + 1);
+    if (mins < 0 || secs < 0 || secs > 59)
+        return false;
+
+    time = mins * 60 + secs;
+    return true;
+}
+
+// The output name must be relative without parent directory components
+bool BatchRenderer::isSafeName(const std::string &name)
+{
+    // Absolute paths, including a drive prefix
+    if (name.empty() || name[0] == '/' || name[0] == '\\'
+        || (name.size() > 1 && name[1] == ':'))
+        return false;
+
+    for (size_t pos = 0; pos <= name.size(); )
+    {
+        size_t sep = name.find_first_of("/\\", pos);
+        if (sep == std::string::npos)
+            sep = name.size();
+
+        if (name.compare(pos, sep - pos, "..") == 0)
+            return false;
+
+        pos = sep + 1;
+    }
+
+    return true;
+}
+
+void BatchRenderer::addDirectory(const std::string &path, const std::string &name)
+{
+    DIR *dir = opendir(path.c_str());
+    if (dir == nullptr)
+    {
+        cerr << "Cannot open directory " << path << endl;
+        return;
+    }
+
+    std::vector<std::string> entries;
+    while (struct dirent *entry = readdir(dir))
+    {
+        if (entry->d_name[0] != '.')
+            entries.push_back(entry->d_name);
+    }
+    closedir(dir);
+
+    // Sort for a stable order on every file system
+    std::sort(entries.begin(), entries.end());
+
+    for (std::vector<std::string>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+    {
+        const std::string entryPath(path + SEPARATOR + *it);
+        const std::string entryName(name.empty() ? *it : name + SEPARATOR + *it);
+
+        if (isDirectory(entryPath))
+        {
+            addDirectory(entryPath, entryName);
+        }
+        else if (isTune(*it))
+        {
+            file_t file;
+            file.path = entryPath;
+            file.name = entryName.substr(0, entryName.find_last_of('.'));
+            m_files.push_back(file);
+        }
+    }
+}
+
+bool BatchRenderer::addPlaylist(const std::string &path)
+{
+    std::ifstream list(path.c_str());
+    if (!list.is_open())
+    {
+        cerr << "Cannot open playlist " << path << endl;
+        return false;
+    }
+
+    const char* hvscBase = getenv("HVSC_BASE");
+
+    std::string line;
+    while (std::getline(list, line))
+    {
+        // Strip line endings and skip comments
+        const size_t end = line.find_last_not_of("\r\n \t");
+        if (end == std::string::npos || line[0] == '#')
+            continue;
+        line.erase(end + 1);
+
+        file_t file;
+        std::string name(line);
+
+        // HVSC relative paths start with a separator
+        if (line[0] == '/' && hvscBase != nullptr)
+        {
+            file.path.assign(hvscBase).append(line);
+            name.erase(0, 1);
+        }
+        else
+            file.path = line;
+
+        // Keep the output inside the output directory
+        if (!isSafeName(name))
+        {
+            cerr << "Skipping " << line << ", the path must be relative without '..'" << endl;
+            continue;
+        }
+
+        file.name = name.substr(0, name.find_last_of('.'));
+        m_files.push_back(file);
+    }
+
+    return true;
+}
+
+sidbuilder *BatchRenderer::createBuilder(unsigned int sids)
+{
+#ifdef HAVE_SIDPLAYFP_BUILDERS_RESIDFP_H
+    if (!m_useResid)
+    {
+        ReSIDfpBuilder *rs = new ReSIDfpBuilder("ReSIDfp");
+        rs->create(sids);
+
+        if (m_filterCurve6581)
+            rs->filter6581Curve(m_filterCurve6581);
+        if (m_filterCurve8580)
+            rs->filter8580Curve((double)m_filterCurve8580);
+        rs->filter(m_filter);
+        return rs;
+    }
+#endif
+
+#ifdef HAVE_SIDPLAYFP_BUILDERS_RESID_H
+    ReSIDBuilder *rs = new ReSIDBuilder("ReSID");
+    rs->create(sids);
+    rs->bias(m_bias);
+    rs->filter(m_filter);
+    return rs;
+#else
+    return nullptr;
+#endif
+}
+
+uint_least32_t BatchRenderer::length(SidTune &tune, unsigned int song)
+{
+    if (m_haveDatabase)
+    {
+        char md5[SidTune::MD5_LENGTH + 1];
+        tune.createMD5(md5);
+
+        std::lock_guard<std::mutex> lock(m_databaseLock);
+        const int_least32_t length = m_database.length(md5, song);
+        if (length > 0)
+            return length;
+    }
+
+    return m_defaultLength;
+}
+
+bool BatchRenderer::renderSong(sidplayfp &engine, SidTune &tune, const file_t &file, unsigned int song, double &seconds)
+{
+    tune.selectSong(song);
+    if (!engine.load(&tune))
+    {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        cerr << file.path << " [" << song << "]: " << engine.error() << endl;
+        return false;
+    }
+
+    std::string name(m_outDir);
+    name.append(SEPARATOR).append(file.name);
+    if (tune.getInfo()->songs() > 1)
+    {
+        std::ostringstream sstream;
+        sstream << "[" << song << "]";
+        name.append(sstream.str());
+    }
+    name.append(WavFile::extension());
+
+    const size_t sep = name.find_last_of('/');
+    if (sep != std::string::npos && !makeDirs(name.substr(0, sep)))
+    {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        cerr << "Cannot create directory for " << name << endl;
+        return false;
+    }
+
+    AudioConfig audioCfg(m_audioCfg);
+    audioCfg.channels = engine.info().channels();
+
+    WavFile wav(name);
+    if (!wav.open(audioCfg))
+    {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        cerr << name << ": " << wav.getErrorString() << endl;
+        return false;
+    }
+
+    const uint_least32_t songLength = length(tune, song);
+    uint_least64_t samples = static_cast<uint_least64_t>(songLength) * audioCfg.frequency * audioCfg.channels;
+
+    while (samples != 0)
+    {
+        const uint_least32_t count = samples < audioCfg.bufSize ? samples : audioCfg.bufSize;
+        const uint_least32_t ret = engine.play(wav.buffer(), count);
+        if (ret < count)
+        {
+            std::lock_guard<std::mutex> lock(m_statsLock);
+            cerr << file.path << " [" << song << "]: " << engine.error() << endl;
+            return false;
+        }
+
+        if (!wav.write(count))
+        {
+            std::lock_guard<std::mutex> lock(m_statsLock);
+            cerr << name << ": write error" << endl;
+            return false;
+        }
+        samples -= count;
+    }
+
+    wav.close();
+    engine.stop();
+
+    // The last block and the header are written on close
+    if (wav.fail())
+    {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        cerr << name << ": write error" << endl;
+        return false;
+    }
+
+    seconds += songLength;
+    return true;
+}
+
+void BatchRenderer::renderFile(const file_t &file)
+{
+    unsigned int songs = 0;
+    unsigned int failed = 0;
+    double seconds = 0.;
+
+    SidTune tune(file.path.c_str());
+    if (!tune.getStatus())
+    {
+        std::lock_guard<std::mutex> lock(m_statsLock);
+        cerr << file.path << ": " << tune.statusString() << endl;
+        failed++;
+    }
+    else
+    {
+        // A fresh engine for each file so that the output
+        // doesn't depend on which thread renders what
+        sidplayfp engine;
+        engine.setRoms(m_kernal, m_basic, m_chargen);
+
+        sidbuilder *builder = createBuilder(engine.info().maxsids());
+
+        SidConfig cfg(m_engCfg);
+        cfg.sidEmulation = builder;
+        if (builder == nullptr || !builder->getStatus() || !engine.config(cfg))
+        {
+            std::lock_guard<std::mutex> lock(m_statsLock);
+            cerr << "Cannot set up the emulation: "
+                 << (builder != nullptr ? builder->error() : "no emulation available") << endl;
+            failed++;
+        }
+        else
+        {
+            for (unsigned int song = 1; song <= tune.getInfo()->songs(); song++)
+            {
+                if (renderSong(engine, tune, file, song, seconds))
+                    songs++;
+                else
+                    failed++;
+            }
+
+            // Release the chips before deleting the builder
+            cfg.sidEmulation = nullptr;
+            engine.config(cfg);
+        }
+
+        delete builder;
+    }
+
+    std::lock_guard<std::mutex> lock(m_statsLock);
+    m_done++;
+    m_subtunes += songs;
+    m_failed += failed;
+    m_audioSeconds += seconds;
+
+    if (!m_quiet)
+    {
+        cerr << "[" << m_done << "/" << m_files.size() << "] " << file.path
+             << " (" << songs << " subtunes)" << endl;
+    }
+}
+
+void BatchRenderer::worker()
+{
+    for (;;)
+    {
+        const unsigned int i = m_next++;
+        if (i >= m_files.size())
+            return;
+
+        renderFile(m_files[i]);
+    }
+}
+
+void BatchRenderer::displayUsage(const char *name) const
+{
+    cout
+        << "Syntax: " << name << " [options] <directory|playlist|tune>..." << endl
+        << "Render every subtune of a collection to WAV files in parallel." << endl
+        << "Options:" << endl
+        << " --help|-h    display this screen" << endl
+        << " -o<dir>      output directory (default: .)" << endl
+        << " -j<num>      number of threads (default: " << m_threads << ")" << endl
+        << " -t<num>      length of tunes missing from the songlength database" << endl
+        << "              in [mins:]secs format (default: " << m_defaultLength << ")" << endl
+        << " -f<num>      set frequency in Hz (default: " << m_engCfg.frequency << ")" << endl
+        << " -p<16|32>    set bit precision for wav saving (default: " << m_audioCfg.precision << ")" << endl
+        << " -s           stereo output for multi SID tunes" << endl
+        << " -r<i|r>[f]   set resampling method (default: resample interpolate)" << endl
+        << " -nf          no SID filter emulation" << endl
+        << " -q           no progress output" << endl
+#ifdef HAVE_SIDPLAYFP_BUILDERS_RESID_H
+        << " --resid      use reSID emulation" << endl
+#endif
+        << endl
+        << "Playlists list one tune per line, paths starting with '/' are taken" << endl
+        << "as relative to HVSC_BASE, other absolute paths and paths with '..'" << endl
+        << "are skipped. The output mirrors the input tree." << endl;
+}
+
+int BatchRenderer::args(int argc, const char *argv[])
+{
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        bool err = false;
+
+        if (arg[0] != '-' || arg[1] == '\0')
+        {
+            inputs.push_back(arg);
+            continue;
+        }
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
+        {
+            displayUsage(argv[0]);
+            return 1;
+        }
+        else if (arg[1] == 'o' && arg[2] != '\0')
+        {
+            m_outDir = &arg[2];
+        }
+        else if (arg[1] == 'j')
+        {
+            const int threads = atoi(&arg[2]);
+            if (threads > 0)
+                m_threads = threads;
+            else
+                err = true;
+        }
+        else if (arg[1] == 't')
+        {
+            if (!parseTime(&arg[2], m_defaultLength) || m_defaultLength == 0)
+                err = true;
+        }
+        else if (arg[1] == 'f')
+        {
+            m_engCfg.frequency = atoi(&arg[2]);
+            m_audioCfg.frequency = m_engCfg.frequency;
+        }
+        else if (arg[1] == 'p')
+        {
+            m_audioCfg.precision = atoi(&arg[2]);
+            if (m_audioCfg.precision != 16 && m_audioCfg.precision != 32)
+                err = true;
+        }
+        else if (strcmp(arg, "-s") == 0)
+        {
+            m_engCfg.playback = SidConfig::STEREO;
+        }
+        else if (arg[1] == 'r')
+        {
+            if (arg[2] == 'i')
+                m_engCfg.samplingMethod = SidConfig::INTERPOLATE;
+            else if (arg[2] == 'r')
+                m_engCfg.samplingMethod = SidConfig::RESAMPLE_INTERPOLATE;
+            else
+                err = true;
+            m_engCfg.fastSampling = arg[3] == 'f';
+        }
+        else if (strcmp(arg, "-nf") == 0)
+        {
+            m_filter = false;
+        }
+        else if (strcmp(arg, "-q") == 0)
+        {
+            m_quiet = true;
+        }
+#ifdef HAVE_SIDPLAYFP_BUILDERS_RESID_H
+        else if (strcmp(arg, "--resid") == 0)
+        {
+            m_useResid = true;
+        }
+#endif
+        else
+        {
+            err = true;
+        }
+
+        if (err)
+        {
+            cerr << argv[0] << ": invalid option " << arg << endl;
+            return -1;
+        }
+    }
+
+    if (inputs.empty())
+    {
+        displayUsage(argv[0]);
+        return -1;
+    }
+
+    for (std::vector<std::string>::const_iterator it = inputs.begin(); it != inputs.end(); ++it)
+    {
+        if (isDirectory(*it))
+        {
+            addDirectory(*it, "");
+        }
+        else if (isTune(*it))
+        {
+            const size_t sep = it->find_last_of('/');
+            const std::string name(sep == std::string::npos ? *it : it->substr(sep + 1));
+
+            file_t file;
+            file.path = *it;
+            file.name = name.substr(0, name.find_last_of('.'));
+            m_files.push_back(file);
+        }
+        else if (!addPlaylist(*it))
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int BatchRenderer::run()
+{
+    if (m_files.empty())
+    {
+        cerr << "No tunes found" << endl;
+        return EXIT_FAILURE;
+    }
+
+    if (m_threads > m_files.size())
+        m_threads = m_files.size();
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < m_threads; i++)
+    {
+        threads.push_back(std::thread(&BatchRenderer::worker, this));
+    }
+    worker();
+    std::for_each(threads.begin(), threads.end(), std::mem_fn(&std::thread::join));
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    cout << std::fixed << std::setprecision(2)
+         << "Rendered " << m_subtunes << " subtunes from " << m_files.size() << " files";
+    if (m_failed != 0)
+        cout << " (" << m_failed << " failed)";
+    cout << " in " << elapsed << " s using " << m_threads << " threads" << endl
+         << (m_subtunes / elapsed) << " tunes/s, "
+         << (m_audioSeconds / elapsed) << "x realtime" << endl;
+
+    return m_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int main(int argc, const char *argv[])
+{
+    BatchRenderer renderer;
+
+    const int ret = renderer.args(argc, argv);
+    if (ret != 0)
+        return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+
+    return renderer.run();
+}
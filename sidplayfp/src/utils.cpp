@@ -21,6 +21,18 @@
 #include "utils.h"
 
 #include <cstdlib>
+#include <fstream>
+#include <new>
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifdef HAVE_UNISTD_H
+#  include <unistd.h>
+#endif
+
+#include "sidcxx11.h"
 
 #ifdef _WIN32
 #  include <windows.h>
@@ -82,3 +94,61 @@ SID_STRING utils::getDataPath() { return getPath("XDG_DATA_HOME", "/.local/share
 SID_STRING utils::getConfigPath() { return getPath("XDG_CONFIG_HOME", "/.config"); }
 
 #endif
+
+static uint8_t* loadRom(const SID_STRING &romPath, const int size)
+{
+    SID_IFSTREAM is(romPath.c_str(), std::ios::binary);
+
+    if (is.is_open())
+    {
+        try
+        {
+            uint8_t *buffer = new uint8_t[size];
+
+            is.read((char*)buffer, size);
+            if (!is.fail())
+            {
+                is.close();
+                return buffer;
+            }
+            delete [] buffer;
+        }
+        catch (std::bad_alloc const &ba) {}
+    }
+
+    return nullptr;
+}
+
+
+uint8_t* utils::loadRom(const SID_STRING &romPath, const int size, const TCHAR defaultRom[])
+{
+    // Try to load given rom
+    if (!romPath.empty())
+    {
+        uint8_t* buffer = ::loadRom(romPath, size);
+        if (buffer)
+            return buffer;
+    }
+
+    // Fallback to default rom path
+    try
+    {
+        SID_STRING dataPath(utils::getDataPath());
+
+        dataPath.append(SEPARATOR).append(TEXT("sidplayfp")).append(SEPARATOR).append(defaultRom);
+
+#if !defined _WIN32 && defined HAVE_UNISTD_H
+        if (::access(dataPath.c_str(), R_OK) != 0)
+        {
+            dataPath = PKGDATADIR;
+            dataPath.append(defaultRom);
+        }
+#endif
+
+        return ::loadRom(dataPath, size);
+    }
+    catch (error const &e)
+    {
+        return nullptr;
+    }
+}
@@ -21,6 +21,8 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdint.h>
+
 #include <string>
 
 #include "ini/types.h"
@@ -41,6 +43,16 @@ public:
     static SID_STRING getDataPath();
     
     static SID_STRING getConfigPath();
+
+    /**
+     * Load a ROM image from the given path or from the data directory.
+     *
+     * @param romPath the path to the image, may be empty
+     * @param size the size of the image
+     * @param defaultRom the file name in the data directory
+     * @return a buffer to be deleted by the caller, nullptr on failure
+     */
+    static uint8_t* loadRom(const SID_STRING &romPath, const int size, const TCHAR defaultRom[]);
 };
 
 #endif